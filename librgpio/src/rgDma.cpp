@@ -0,0 +1,567 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO DMA Controller channel class.  Dma
+//
+// See:  BCM2835 ARM Peripherals (2012)
+//	p.38-62  ch4 - DMA Controller
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgDma.h"
+
+uint32_t	rgDma::AllocMask = 0;		// static class data
+
+/*
+* Constructor.
+* Require address map initialization.
+*    rgAddrMap	amx;		// address map object
+*    amx.open_dev_mem();	// select and open device file
+* call:
+*    rgDma	dx  ( &amx, N );	// constructor with address map
+*    &amx  = pointer to address map object with open device file
+*    N     = channel number {0..14}  for BCM2837 RPi3 and earlier
+*                           {0..10}  for BCM2711 RPi4, DMA4 not modeled
+*    Channels 7 and up are Lite:  TXFR_LEN is 16 bits (65535 bytes max),
+*    no 2D stride mode.  See is_lite(), rgDma_Chain::config_Lite().
+*/
+rgDma::rgDma(
+    rgAddrMap		*xx,
+    uint32_t		chan
+)
+{
+    if ( !(rgRpiRev::Global.SocEnum.find() <= rgRpiRev::soc_BCM2711) ) {
+	throw std::domain_error
+	    ( "rgDma:  require RPi4 (soc_BCM2711) or earlier" );
+    }
+
+    if ( chan > max_chan() ) {
+	std::ostringstream      css;
+	css << "rgDma:  constructor requires channel {0.." << max_chan()
+	    << "}:  " << chan;
+	throw std::range_error ( css.str() );
+    }
+
+    FeatureAddr = FeatureBase + (chan * 0x100);	// BCM doc address
+
+    ChanNum     = chan;
+    GpioBase    = xx->get_mem_addr( FeatureAddr );
+
+    CntlStat.init_addr( GpioBase + CntlStat_offset );
+      CbAddr.init_addr( GpioBase +   CbAddr_offset );
+      TxInfo.init_addr( GpioBase +   TxInfo_offset );
+     SrcAddr.init_addr( GpioBase +  SrcAddr_offset );
+    DestAddr.init_addr( GpioBase + DestAddr_offset );
+       TxLen.init_addr( GpioBase +    TxLen_offset );
+      Stride.init_addr( GpioBase +   Stride_offset );
+      NextCb.init_addr( GpioBase +   NextCb_offset );
+       Debug.init_addr( GpioBase +    Debug_offset );
+}
+
+
+/*
+* Maximum channel number on this platform.
+*    RPi4 channels 11..14 are DMA4 engines with a different register layout.
+*    Channel 15 is at a separate address, not modeled.
+*/
+uint32_t
+rgDma::max_chan()
+{
+    return  ( rgRpiRev::find_SocEnum() == rgRpiRev::soc_BCM2711 ) ? 10 : 14;
+}
+
+
+//--------------------------------------------------------------------------
+// Channel allocation
+//--------------------------------------------------------------------------
+// Only coordinates users within this process.  The usable mask comes from
+// the platform, e.g. the kernel device tree property
+//     /proc/device-tree/soc/dma@7e007000/brcm,dma-channel-mask
+
+/*
+* Allocate the lowest free channel.
+* call:
+*    rgDma::alloc_channel( usable_mask )
+*    usable_mask = bit mask of channels the platform leaves free
+* return:
+*    ()  = channel number
+* exceptions:
+*    range_error if no channel is free
+*/
+uint32_t
+rgDma::alloc_channel(
+    uint32_t		usable_mask
+)
+{
+    uint32_t		valid = (1 << (max_chan() + 1)) - 1;
+    uint32_t		avail = usable_mask & valid & ~AllocMask;
+
+    if ( avail == 0 ) {
+	std::ostringstream      css;
+	css << "rgDma::alloc_channel():  no free channel in mask:  0x"
+	    <<hex <<setfill('0') <<setw(8) << usable_mask;
+	throw std::range_error ( css.str() );
+    }
+
+    uint32_t		chan = 0;
+    while ( ! (avail & (1 << chan)) ) {
+	chan++;
+    }
+
+    AllocMask |= (1 << chan);
+    return  chan;
+}
+
+
+/*
+* Free an allocated channel.
+* exceptions:
+*    range_error if channel is not allocated
+*/
+void
+rgDma::free_channel(
+    uint32_t		chan
+)
+{
+    if ( (chan > 31) || !(AllocMask & (1 << chan)) ) {
+	std::ostringstream      css;
+	css << "rgDma::free_channel():  channel not allocated:  " << chan;
+	throw std::range_error ( css.str() );
+    }
+
+    AllocMask &= ~(1 << chan);
+}
+
+
+//--------------------------------------------------------------------------
+// Direct control
+//--------------------------------------------------------------------------
+
+/*
+* Start the channel on a Control Block chain.
+*    Configuration fields of the CntlStat object (DisDebug_1, WaitWrites_1,
+*    PanicPrio_4, Priority_4) are written with Active_1=1.  End_1 and Int_1
+*    are written 1 to clear stale status.
+* call:
+*    self.start( cb_bus )
+*    cb_bus = bus address of first Control Block, 32-byte aligned
+* exceptions:
+*    range_error if not aligned
+*/
+void
+rgDma::start(
+    uint32_t		cb_bus
+)
+{
+    if ( cb_bus & 0x1f ) {
+	std::ostringstream      css;
+	css << "rgDma::start():  require 32-byte aligned cb_bus:  0x"
+	    <<hex <<setfill('0') <<setw(8) << cb_bus;
+	throw std::range_error ( css.str() );
+    }
+
+    CbAddr.write( cb_bus );
+    CntlStat.write( (CntlStat.get() & 0x30ff0000) | 0x7 );	// End,Int,Active
+}
+
+
+/*
+* Poll for completion.
+*    One CntlStat read into the object, so the caller can then check
+*    CntlStat.get_Error_1() and others without another read.
+* return:
+*    ()  = true when not active (done, or never started)
+*/
+bool
+rgDma::poll_done()
+{
+    CntlStat.grab();
+    return  ! CntlStat.get_Active_1();
+}
+
+
+/*
+* Clear End_1 and Int_1 status (write 1 to clear).
+*    Only when the channel is not active, since Active_1=0 is also written.
+*/
+void
+rgDma::clear_end()
+{
+    CntlStat.write( 0x00000006 );
+}
+
+
+/*
+* Reset the channel, abandoning any transfer.
+*/
+void
+rgDma::reset()
+{
+    CntlStat.write( 0x80000000 );
+}
+
+
+//--------------------------------------------------------------------------
+// Object state operations
+//--------------------------------------------------------------------------
+
+/*
+* Initialize all object registers to the power-on reset state.
+*    Hardware registers are unchanged.
+*/
+void
+rgDma::init_put_reset()
+{
+    CntlStat.put( 0x00000000 );
+      CbAddr.put( 0x00000000 );
+      TxInfo.put( 0x00000000 );
+     SrcAddr.put( 0x00000000 );
+    DestAddr.put( 0x00000000 );
+       TxLen.put( 0x00000000 );
+      Stride.put( 0x00000000 );
+      NextCb.put( 0x00000000 );
+       Debug.put( 0x00000000 );
+}
+
+
+/*
+* Read hardware registers into the object.
+*/
+void
+rgDma::grab_regs()
+{
+    CntlStat.grab();
+      CbAddr.grab();
+      TxInfo.grab();
+     SrcAddr.grab();
+    DestAddr.grab();
+       TxLen.grab();
+      Stride.grab();
+      NextCb.grab();
+       Debug.grab();
+}
+
+
+//--------------------------------------------------------------------------
+// Debug
+//--------------------------------------------------------------------------
+
+/*
+* Show debug output.
+* call:
+*    self.show_debug( cout )
+*/
+void
+rgDma::show_debug( std::ostream& sout )
+{
+    sout.fill('0');
+    sout <<hex
+	 << "Dma.CntlStat= 0x"  <<setw(8) << CntlStat.get() <<endl
+	 << "Dma.CbAddr=   0x"  <<setw(8) <<   CbAddr.get() <<endl
+	 << "Dma.TxInfo=   0x"  <<setw(8) <<   TxInfo.get() <<endl
+	 << "Dma.SrcAddr=  0x"  <<setw(8) <<  SrcAddr.get() <<endl
+	 << "Dma.DestAddr= 0x"  <<setw(8) << DestAddr.get() <<endl
+	 << "Dma.TxLen=    0x"  <<setw(8) <<    TxLen.get() <<endl
+	 << "Dma.Stride=   0x"  <<setw(8) <<   Stride.get() <<endl
+	 << "Dma.NextCb=   0x"  <<setw(8) <<   NextCb.get() <<endl
+	 << "Dma.Debug=    0x"  <<setw(8) <<    Debug.get() <<endl;
+    sout <<dec;
+    sout.fill(' ');
+}
+
+
+//--------------------------------------------------------------------------
+// rgDma_Chain - Control Block chain
+//--------------------------------------------------------------------------
+// Control Block layout, 8 words, 32-byte aligned:
+//     [0] TI  [1] SOURCE_AD  [2] DEST_AD  [3] TXFR_LEN  [4] STRIDE
+//     [5] NEXTCONBK  [6] reserved  [7] reserved
+
+/*
+* Constructor.
+*    The chain starts empty.
+* call:
+*    rgDma_Chain	cx  ( virt, bus, nbyte );
+*    virt  = virtual address of Control Block memory
+*    bus   = bus address of the same memory, 32-byte aligned
+*    nbyte = memory size in bytes
+* exceptions:
+*    range_error if not aligned, or smaller than one Control Block
+*/
+rgDma_Chain::rgDma_Chain(
+    volatile uint32_t	*virt,
+    uint32_t		bus,
+    uint32_t		nbyte
+)
+{
+    if ( bus & 0x1f ) {
+	std::ostringstream      css;
+	css << "rgDma_Chain:  require 32-byte aligned bus address:  0x"
+	    <<hex <<setfill('0') <<setw(8) << bus;
+	throw std::range_error ( css.str() );
+    }
+
+    MaxCb  = nbyte / (CbSize_w * 4);
+
+    if ( MaxCb == 0 ) {
+	std::ostringstream      css;
+	css << "rgDma_Chain:  memory smaller than one Control Block:  "
+	    << nbyte;
+	throw std::range_error ( css.str() );
+    }
+
+    CbVirt = virt;
+    CbBus  = bus;
+    NumCb  = 0;
+    Lite   = 0;
+}
+
+
+/*
+* Check Control Block index is in use.
+*/
+void
+rgDma_Chain::check_index(
+    const char		*fn,
+    uint32_t		ii
+)
+{
+    if ( ii >= NumCb ) {
+	std::ostringstream      css;
+	css << "rgDma_Chain::" << fn << "():  index exceeds NumCb:  " << ii;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Bus address of a Control Block, as seen by the DMA engine.
+*/
+uint32_t
+rgDma_Chain::cb_bus(
+    uint32_t		ii
+)
+{
+    check_index( "cb_bus", ii );
+    return  CbBus + (ii * CbSize_w * 4);
+}
+
+
+/*
+* Virtual address of a Control Block.
+*/
+volatile uint32_t*
+rgDma_Chain::cb_addr(
+    uint32_t		ii
+)
+{
+    check_index( "cb_addr", ii );
+    return  CbVirt + (ii * CbSize_w);
+}
+
+
+/*
+* Append a Control Block, linked from the previous one.
+*    The new block ends the chain (NEXTCONBK=0).
+* call:
+*    self.add_cb( ti, src_bus, dest_bus, len )
+*    self.add_cb( ti, src_bus, dest_bus, len, stride )
+*    ti       = Transfer Information word, see rgDma_TxInfo
+*    src_bus  = source bus address
+*    dest_bus = destination bus address
+*    len      = transfer length, bytes
+*    stride   = 2D mode stride, full channel only
+*    With config_Lite(1), len is limited to MaxLiteLen and 2D mode (TdMode_1
+*    or non-zero stride) is rejected.
+* return:
+*    ()  = index of the new Control Block
+* exceptions:
+*    range_error if full, len out of range, or 2D mode on Lite
+*/
+uint32_t
+rgDma_Chain::add_cb(
+    uint32_t		ti,
+    uint32_t		src_bus,
+    uint32_t		dest_bus,
+    uint32_t		len,
+    uint32_t		stride
+)
+{
+    if ( NumCb >= MaxCb ) {
+	std::ostringstream      css;
+	css << "rgDma_Chain::add_cb():  exceeds MaxCb:  " << MaxCb;
+	throw std::range_error ( css.str() );
+    }
+
+    uint32_t		maxlen = ( Lite ) ? MaxLiteLen : MaxLen;
+
+    if ( (len == 0) || (len > maxlen) ) {
+	std::ostringstream      css;
+	css << "rgDma_Chain::add_cb():  require len {1..0x" <<hex << maxlen
+	    << "}:  0x" << len;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( Lite && ( (ti & 0x2) || (stride != 0) ) ) {	// TdMode_1
+	throw std::range_error
+	    ( "rgDma_Chain::add_cb():  Lite channel has no 2D mode" );
+    }
+
+    volatile uint32_t	*cb = CbVirt + (NumCb * CbSize_w);
+
+    cb[0] = ti;
+    cb[1] = src_bus;
+    cb[2] = dest_bus;
+    cb[3] = len;
+    cb[4] = stride;
+    cb[5] = 0;
+    cb[6] = 0;
+    cb[7] = 0;
+
+    if ( NumCb > 0 ) {		// link previous block
+	CbVirt[ ((NumCb - 1) * CbSize_w) + 5 ] = CbBus + (NumCb * CbSize_w * 4);
+    }
+
+    return  NumCb++;
+}
+
+
+/*
+* Link the last Control Block back to the first, for continuous streaming.
+* exceptions:
+*    range_error if chain is empty
+*/
+void
+rgDma_Chain::close_loop()
+{
+    if ( NumCb == 0 ) {
+	throw std::range_error ( "rgDma_Chain::close_loop():  empty chain" );
+    }
+
+    CbVirt[ ((NumCb - 1) * CbSize_w) + 5 ] = CbBus;
+}
+
+
+//--------------------------------------
+// Streaming helpers
+//--------------------------------------
+
+/*
+* Transfer Information for memory to peripheral Fifo, paced by DREQ.
+* call:
+*    rgDma_Chain::ti_mem2per( permap )
+*    permap = DREQ peripheral number {0..31}
+*/
+uint32_t
+rgDma_Chain::ti_mem2per(
+    uint32_t		permap
+)
+{
+    rgDma_TxInfo	tx;
+
+    tx.put_NoWideBurst_1( 1 );
+    tx.put_PerMap_5(      permap );
+    tx.put_SrcInc_1(      1 );
+    tx.put_DestDreq_1(    1 );
+    tx.put_WaitResp_1(    1 );
+
+    return  tx.get();
+}
+
+
+/*
+* Transfer Information for peripheral Fifo to memory, paced by DREQ.
+*/
+uint32_t
+rgDma_Chain::ti_per2mem(
+    uint32_t		permap
+)
+{
+    rgDma_TxInfo	tx;
+
+    tx.put_NoWideBurst_1( 1 );
+    tx.put_PerMap_5(      permap );
+    tx.put_SrcDreq_1(     1 );
+    tx.put_DestInc_1(     1 );
+    tx.put_WaitResp_1(    1 );
+
+    return  tx.get();
+}
+
+
+/*
+* Append memory to SPI0 Fifo transfer (unit 0).
+*    SPI0 needs DmaEnable_1=1, and the first word in memory is the
+*    rgSpi0::dma_header() word.
+*/
+uint32_t
+rgDma_Chain::add_spi0_tx(
+    uint32_t		src_bus,
+    uint32_t		len
+)
+{
+    return  add_cb( ti_mem2per( PerMap_Spi0Tx ), src_bus, Spi0Fifo_bus, len );
+}
+
+
+/*
+* Append SPI0 Fifo to memory transfer (unit 0).
+*/
+uint32_t
+rgDma_Chain::add_spi0_rx(
+    uint32_t		dest_bus,
+    uint32_t		len
+)
+{
+    return  add_cb( ti_per2mem( PerMap_Spi0Rx ), Spi0Fifo_bus, dest_bus, len );
+}
+
+
+/*
+* Append memory to PWM Fifo transfer.
+*    PWM needs DmaConf.DmaEnable_1=1 and channels using the Fifo.
+*/
+uint32_t
+rgDma_Chain::add_pwm_tx(
+    uint32_t		src_bus,
+    uint32_t		len
+)
+{
+    return  add_cb( ti_mem2per( PerMap_Pwm ), src_bus, PwmFifo_bus, len );
+}
+
+
+/*
+* Append memory to PCM Tx Fifo transfer.
+*/
+uint32_t
+rgDma_Chain::add_pcm_tx(
+    uint32_t		src_bus,
+    uint32_t		len
+)
+{
+    return  add_cb( ti_mem2per( PerMap_PcmTx ), src_bus, PcmFifo_bus, len );
+}
+
+
+/*
+* Append PCM Rx Fifo to memory transfer.
+*/
+uint32_t
+rgDma_Chain::add_pcm_rx(
+    uint32_t		dest_bus,
+    uint32_t		len
+)
+{
+    return  add_cb( ti_per2mem( PerMap_PcmRx ), PcmFifo_bus, dest_bus, len );
+}
+
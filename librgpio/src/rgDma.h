@@ -0,0 +1,277 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgDma_P
+#define rgDma_P
+
+#include "rgRegister.h"
+
+//--------------------------------------------------------------------------
+// rGPIO DMA Controller channel class.  Dma
+//--------------------------------------------------------------------------
+
+class rgDma_CntlStat : public rgRegister {
+  public:
+
+    inline
+    uint32_t	get_Reset_1()             { return  get_field( 31, 0x1    ); }
+    void	put_Reset_1(         uint32_t v ) { put_field( 31, 0x1, v ); }
+
+    uint32_t	get_Abort_1()             { return  get_field( 30, 0x1    ); }
+    void	put_Abort_1(         uint32_t v ) { put_field( 30, 0x1, v ); }
+
+    uint32_t	get_DisDebug_1()          { return  get_field( 29, 0x1    ); }
+    void	put_DisDebug_1(      uint32_t v ) { put_field( 29, 0x1, v ); }
+
+    uint32_t	get_WaitWrites_1()        { return  get_field( 28, 0x1    ); }
+    void	put_WaitWrites_1(    uint32_t v ) { put_field( 28, 0x1, v ); }
+
+    uint32_t	get_PanicPrio_4()         { return  get_field( 20, 0xf    ); }
+    void	put_PanicPrio_4(     uint32_t v ) { put_field( 20, 0xf, v ); }
+
+    uint32_t	get_Priority_4()          { return  get_field( 16, 0xf    ); }
+    void	put_Priority_4(      uint32_t v ) { put_field( 16, 0xf, v ); }
+
+    uint32_t	get_Error_1()             { return  get_field(  8, 0x1    ); }
+    void	put_Error_1(         uint32_t v ) { put_field(  8, 0x1, v ); }
+
+    uint32_t	get_WaitingWrites_1()     { return  get_field(  6, 0x1    ); }
+    void	put_WaitingWrites_1( uint32_t v ) { put_field(  6, 0x1, v ); }
+
+    uint32_t	get_DreqStops_1()         { return  get_field(  5, 0x1    ); }
+    void	put_DreqStops_1(     uint32_t v ) { put_field(  5, 0x1, v ); }
+
+    uint32_t	get_Paused_1()            { return  get_field(  4, 0x1    ); }
+    void	put_Paused_1(        uint32_t v ) { put_field(  4, 0x1, v ); }
+
+    uint32_t	get_Dreq_1()              { return  get_field(  3, 0x1    ); }
+    void	put_Dreq_1(          uint32_t v ) { put_field(  3, 0x1, v ); }
+
+    uint32_t	get_Int_1()               { return  get_field(  2, 0x1    ); }
+    void	put_Int_1(           uint32_t v ) { put_field(  2, 0x1, v ); }
+
+    uint32_t	get_End_1()               { return  get_field(  1, 0x1    ); }
+    void	put_End_1(           uint32_t v ) { put_field(  1, 0x1, v ); }
+
+    uint32_t	get_Active_1()            { return  get_field(  0, 0x1    ); }
+    void	put_Active_1(        uint32_t v ) { put_field(  0, 0x1, v ); }
+};
+
+class rgDma_TxInfo : public rgRegister {
+  public:
+
+    inline
+    uint32_t	get_NoWideBurst_1()       { return  get_field( 26, 0x1    ); }
+    void	put_NoWideBurst_1(   uint32_t v ) { put_field( 26, 0x1, v ); }
+
+    uint32_t	get_Waits_5()             { return  get_field( 21, 0x1f   ); }
+    void	put_Waits_5(         uint32_t v ) { put_field( 21, 0x1f, v); }
+
+    uint32_t	get_PerMap_5()            { return  get_field( 16, 0x1f   ); }
+    void	put_PerMap_5(        uint32_t v ) { put_field( 16, 0x1f, v); }
+
+    uint32_t	get_BurstLen_4()          { return  get_field( 12, 0xf    ); }
+    void	put_BurstLen_4(      uint32_t v ) { put_field( 12, 0xf, v ); }
+
+    uint32_t	get_SrcIgnore_1()         { return  get_field( 11, 0x1    ); }
+    void	put_SrcIgnore_1(     uint32_t v ) { put_field( 11, 0x1, v ); }
+
+    uint32_t	get_SrcDreq_1()           { return  get_field( 10, 0x1    ); }
+    void	put_SrcDreq_1(       uint32_t v ) { put_field( 10, 0x1, v ); }
+
+    uint32_t	get_SrcWidth_1()          { return  get_field(  9, 0x1    ); }
+    void	put_SrcWidth_1(      uint32_t v ) { put_field(  9, 0x1, v ); }
+
+    uint32_t	get_SrcInc_1()            { return  get_field(  8, 0x1    ); }
+    void	put_SrcInc_1(        uint32_t v ) { put_field(  8, 0x1, v ); }
+
+    uint32_t	get_DestIgnore_1()        { return  get_field(  7, 0x1    ); }
+    void	put_DestIgnore_1(    uint32_t v ) { put_field(  7, 0x1, v ); }
+
+    uint32_t	get_DestDreq_1()          { return  get_field(  6, 0x1    ); }
+    void	put_DestDreq_1(      uint32_t v ) { put_field(  6, 0x1, v ); }
+
+    uint32_t	get_DestWidth_1()         { return  get_field(  5, 0x1    ); }
+    void	put_DestWidth_1(     uint32_t v ) { put_field(  5, 0x1, v ); }
+
+    uint32_t	get_DestInc_1()           { return  get_field(  4, 0x1    ); }
+    void	put_DestInc_1(       uint32_t v ) { put_field(  4, 0x1, v ); }
+
+    uint32_t	get_WaitResp_1()          { return  get_field(  3, 0x1    ); }
+    void	put_WaitResp_1(      uint32_t v ) { put_field(  3, 0x1, v ); }
+
+    uint32_t	get_TdMode_1()            { return  get_field(  1, 0x1    ); }
+    void	put_TdMode_1(        uint32_t v ) { put_field(  1, 0x1, v ); }
+
+    uint32_t	get_IntEnable_1()         { return  get_field(  0, 0x1    ); }
+    void	put_IntEnable_1(     uint32_t v ) { put_field(  0, 0x1, v ); }
+};
+
+class rgDma_CbAddr   : public rgRegister {
+};
+
+class rgDma_SrcAddr  : public rgRegister {
+};
+
+class rgDma_DestAddr : public rgRegister {
+};
+
+class rgDma_TxLen    : public rgRegister {
+};
+
+class rgDma_Stride   : public rgRegister {
+};
+
+class rgDma_NextCb   : public rgRegister {
+};
+
+class rgDma_Debug    : public rgRegister {
+};
+
+
+//--------------------------------------------------------------------------
+// DMA channel
+//--------------------------------------------------------------------------
+
+class rgDma {
+  private:
+    volatile uint32_t	*GpioBase;	// IO base address
+    uint32_t		ChanNum;	// DMA channel number {0..14}
+    uint32_t		FeatureAddr;	// BCM doc address, in constructor
+
+    static uint32_t	AllocMask;	// channels allocated in this process
+
+  public:
+				// Register data
+    rgDma_CntlStat	CntlStat;	// CS         Control and Status
+    rgDma_CbAddr	CbAddr;		// CONBLK_AD  Control Block Address
+    rgDma_TxInfo	TxInfo;		// TI         Transfer Information (RO)
+    rgDma_SrcAddr	SrcAddr;	// SOURCE_AD  Source Address     (RO)
+    rgDma_DestAddr	DestAddr;	// DEST_AD    Destination Address (RO)
+    rgDma_TxLen		TxLen;		// TXFR_LEN   Transfer Length    (RO)
+    rgDma_Stride	Stride;		// STRIDE     2D Stride          (RO)
+    rgDma_NextCb	NextCb;		// NEXTCONBK  Next Control Block (RO)
+    rgDma_Debug		Debug;		// DEBUG      Debug
+
+  private:
+    static const uint32_t	FeatureBase  = 0x7e007000;  // BCM doc value
+
+					// Register word offset in Page
+    static const uint32_t	CntlStat_offset  = 0x00 /4;
+    static const uint32_t	CbAddr_offset    = 0x04 /4;
+    static const uint32_t	TxInfo_offset    = 0x08 /4;
+    static const uint32_t	SrcAddr_offset   = 0x0c /4;
+    static const uint32_t	DestAddr_offset  = 0x10 /4;
+    static const uint32_t	TxLen_offset     = 0x14 /4;
+    static const uint32_t	Stride_offset    = 0x18 /4;
+    static const uint32_t	NextCb_offset    = 0x1c /4;
+    static const uint32_t	Debug_offset     = 0x20 /4;
+
+  public:
+    rgDma(			// constructor
+	rgAddrMap	*xx,
+	uint32_t	chan
+    );
+
+    inline volatile uint32_t*	get_base_addr()  { return  GpioBase; }
+    uint32_t			get_chan_num()   { return  ChanNum; }
+    bool			is_lite()        { return  ChanNum >= 7; }
+
+    static uint32_t	max_chan();
+
+		// Channel allocation, within this process
+    static uint32_t	alloc_channel( uint32_t  usable_mask );
+    static void		free_channel(  uint32_t  chan );
+    static uint32_t	get_AllocMask()   { return  AllocMask; }
+
+		// Direct control:
+    void		start( uint32_t  cb_bus );
+    bool		poll_done();
+    void		clear_end();
+    void		reset();
+
+		// Object state operations
+    void		init_put_reset();
+
+    void		grab_regs();
+
+		// Test/Debug accessors
+
+    void		show_debug( std::ostream&  sout );
+
+    inline uint32_t	get_bcm_address() { return FeatureAddr; }
+};
+
+
+//--------------------------------------------------------------------------
+// DMA Control Block chain, in memory visible to the DMA engine
+//--------------------------------------------------------------------------
+// Memory must be uncached with a known bus address, e.g. from the
+// VideoCore mailbox allocator (not part of this library).
+
+class rgDma_Chain {
+  public:
+    static const uint32_t	CbSize_w  = 8;		// words per Control Block
+    static const uint32_t	MaxLen    = 0x3fffffff;	// TXFR_LEN, full channel
+    static const uint32_t	MaxLiteLen = 0xffff;	// TXFR_LEN, Lite channel
+
+					// Peripheral bus addresses
+    static const uint32_t	Spi0Fifo_bus = 0x7e204004;
+    static const uint32_t	PcmFifo_bus  = 0x7e203004;
+    static const uint32_t	PwmFifo_bus  = 0x7e20c018;
+
+					// DREQ peripheral map, PerMap_5
+    static const uint32_t	PerMap_PcmTx  = 2;
+    static const uint32_t	PerMap_PcmRx  = 3;
+    static const uint32_t	PerMap_Pwm    = 5;
+    static const uint32_t	PerMap_Spi0Tx = 6;
+    static const uint32_t	PerMap_Spi0Rx = 7;
+
+  private:
+    volatile uint32_t	*CbVirt;	// Control Block memory, virtual
+    uint32_t		CbBus;		// Control Block memory, bus address
+    uint32_t		MaxCb;		// capacity in Control Blocks
+    uint32_t		NumCb;		// number used
+    bool		Lite;		// for a Lite channel, rgDma::is_lite()
+
+  public:
+    rgDma_Chain(		// constructor
+	volatile uint32_t	*virt,
+	uint32_t		bus,
+	uint32_t		nbyte
+    );
+
+    uint32_t		add_cb(
+			    uint32_t	ti,
+			    uint32_t	src_bus,
+			    uint32_t	dest_bus,
+			    uint32_t	len,
+			    uint32_t	stride = 0
+			);
+    void		close_loop();
+    void		clear()           { NumCb = 0; }
+
+    inline void		config_Lite( bool v )  { Lite = v; }
+    inline bool		config_Lite()          { return  Lite; }
+
+    inline uint32_t	get_NumCb()       { return  NumCb; }
+    inline uint32_t	get_MaxCb()       { return  MaxCb; }
+
+    uint32_t		cb_bus(  uint32_t  ii );
+    volatile uint32_t*	cb_addr( uint32_t  ii );
+
+		// Streaming helpers, memory <-> peripheral Fifo
+    uint32_t		add_spi0_tx( uint32_t  src_bus,   uint32_t  len );
+    uint32_t		add_spi0_rx( uint32_t  dest_bus,  uint32_t  len );
+    uint32_t		add_pwm_tx(  uint32_t  src_bus,   uint32_t  len );
+    uint32_t		add_pcm_tx(  uint32_t  src_bus,   uint32_t  len );
+    uint32_t		add_pcm_rx(  uint32_t  dest_bus,  uint32_t  len );
+
+    static uint32_t	ti_mem2per( uint32_t  permap );
+    static uint32_t	ti_per2mem( uint32_t  permap );
+
+  private:
+    void		check_index( const char* fn,  uint32_t ii );
+};
+
+#endif
+
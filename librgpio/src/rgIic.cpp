@@ -80,6 +80,15 @@ rgIic::rgIic(
     ClkDiv.init_addr( GpioBase + ClkDiv_offset );
      Delay.init_addr( GpioBase +  Delay_offset );
     ClkStr.init_addr( GpioBase + ClkStr_offset );
+
+    XferCnt     = 0;
+    PollCnt     = 0;
+    XferErr     = 0;
+    PollLimit   = 1000000;
+    XStall      = 0;
+    XState      = xs_Idle;
+    XLen        = 0;
+    XCnt        = 0;
 }
 
 
@@ -153,6 +162,824 @@ rgIic::push_regs()
 }
 
 
+//--------------------------------------------------------------------------
+// Transaction engine
+//--------------------------------------------------------------------------
+// Polled master transactions:  write, read, and write then repeated-Start
+// read.  Each polling pass reads Stat once, and decodes errors and Fifo
+// state from that one value.
+// R/C flags are cleared by writing back the Stat value read, which clears
+// exactly the flags that were seen set.
+// A transaction with no progress (no bytes moved, no state change) for
+// PollLimit Stat reads is abandoned as abort_xfer(), and XferErr is
+// ErrPollLimit, so a wedged bus cannot hang the blocking calls.
+// Transfers longer than MaxPacket are chained as separate transactions
+// (Stop, then Start).
+
+					// Cntl bits
+static const uint32_t	Iic_Enable      = 1 << 15;	// I2CEN
+static const uint32_t	Iic_Start       = 1 <<  7;	// ST
+static const uint32_t	Iic_ClearFifo   = 1 <<  4;	// CLEAR
+static const uint32_t	Iic_Read        = 1 <<  0;	// READ
+
+					// Stat bits
+static const uint32_t	Iic_ClkTimeout  = 1 <<  9;	// CLKT (R/C)
+static const uint32_t	Iic_AckErr      = 1 <<  8;	// ERR  (R/C)
+static const uint32_t	Iic_RxFull      = 1 <<  7;	// RXF
+static const uint32_t	Iic_TxEmpty     = 1 <<  6;	// TXE
+static const uint32_t	Iic_RxHasData   = 1 <<  5;	// RXD
+static const uint32_t	Iic_TxHasSpace  = 1 <<  4;	// TXD
+static const uint32_t	Iic_TransDone   = 1 <<  1;	// DONE (R/C)
+static const uint32_t	Iic_TransActive = 1 <<  0;	// TA
+
+static const uint32_t	Iic_Errors      = Iic_ClkTimeout | Iic_AckErr;
+
+
+/*
+* Write bytes to a slave.
+*    n=0 sends only the address byte, e.g. to probe for a device.
+* call:
+*    self.write( addr, buf, n )
+*    addr = slave address {0..0x7f}
+*    buf  = Tx data
+*    n    = number of bytes
+* return:
+*    ()  = 0 on success, else Stat error bits (AckErr_1, ClkTimeout_1),
+*	   or ErrPollLimit if abandoned with no progress
+*    get_XferCnt() = bytes placed in the Fifo
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*/
+uint32_t
+rgIic::write(
+    uint32_t		addr,
+    const uint8_t	*buf,
+    uint32_t		n
+)
+{
+    TxOne.iov_base = (void*) buf;
+    TxOne.iov_len  = n;
+    XTx.init( &TxOne, 1 );
+
+    return  write_all( "write", addr, n );
+}
+
+
+/*
+* Read bytes from a slave.
+* call:
+*    self.read( addr, buf, n )
+*    addr = slave address {0..0x7f}
+*    buf  = Rx data buffer
+*    n    = number of bytes {1..}
+* return:
+*    ()  = 0 on success, else Stat error bits (AckErr_1, ClkTimeout_1),
+*	   or ErrPollLimit if abandoned with no progress
+*    get_XferCnt() = bytes received
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  n is zero (can hang the bus, see rgIic(7))
+*/
+uint32_t
+rgIic::read(
+    uint32_t		addr,
+    uint8_t		*buf,
+    uint32_t		n
+)
+{
+    RxOne.iov_base = buf;
+    RxOne.iov_len  = n;
+    XRx.init( &RxOne, 1 );
+
+    return  read_all( "read", addr, n );
+}
+
+
+/*
+* Write then read with a repeated Start, e.g. a device register read.
+*    The whole write is placed in the Fifo, the write transaction started,
+*    and as soon as TransActive_1=1 the read is queued (DataLen_16, Cntl).
+*    The master then sends a repeated Start instead of Stop.
+*    If the write has already finished (TransDone_1=1), the read follows
+*    after a Stop instead.
+* call:
+*    self.write_read( addr, wbuf, nw, rbuf, nr )
+*    addr = slave address {0..0x7f}
+*    wbuf = Tx data,  nw bytes {1..16}
+*    rbuf = Rx buffer,  nr bytes {1..0xffff}
+* return:
+*    ()  = 0 on success, else Stat error bits (AckErr_1, ClkTimeout_1),
+*	   or ErrPollLimit if abandoned with no progress
+*    get_XferCnt() = bytes received
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  nw not in {1..16}, nr not in {1..0xffff}
+*/
+uint32_t
+rgIic::write_read(
+    uint32_t		addr,
+    const uint8_t	*wbuf,
+    uint32_t		nw,
+    uint8_t		*rbuf,
+    uint32_t		nr
+)
+{
+    check_write_read( "write_read", addr, nw, nr );
+
+    TxOne.iov_base = (void*) wbuf;
+    TxOne.iov_len  = nw;
+    RxOne.iov_base = rbuf;
+    RxOne.iov_len  = nr;
+    XTx.init( &TxOne, 1 );
+    XRx.init( &RxOne, 1 );
+
+    begin_write_read( addr, nw, nr );
+
+    while ( ! service_xfer() ) {
+    }
+
+    return  XferErr;
+}
+
+
+/*
+* Start a write_read() transaction without waiting for it.
+*    The write is placed in the Fifo and started.  Call service_xfer() to
+*    queue the read and drain the Fifo.  Rx buffer must remain valid until
+*    service_xfer() returns true.
+*    Lets one polling loop interleave transactions on several IIC units.
+* call:
+*    self.start_write_read( addr, wbuf, nw, rbuf, nr )
+*    Arguments are as for write_read().
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  nw not in {1..16}, nr not in {1..0xffff}
+*/
+void
+rgIic::start_write_read(
+    uint32_t		addr,
+    const uint8_t	*wbuf,
+    uint32_t		nw,
+    uint8_t		*rbuf,
+    uint32_t		nr
+)
+{
+    check_write_read( "start_write_read", addr, nw, nr );
+
+    TxOne.iov_base = (void*) wbuf;
+    TxOne.iov_len  = nw;
+    RxOne.iov_base = rbuf;
+    RxOne.iov_len  = nr;
+    XTx.init( &TxOne, 1 );
+    XRx.init( &RxOne, 1 );
+
+    begin_write_read( addr, nw, nr );
+}
+
+
+//--------------------------------------------------------------------------
+// Scatter/gather transactions
+//--------------------------------------------------------------------------
+// Segment lists are POSIX struct iovec, as writev(2), e.g. a register
+// address, payload and CRC in separate buffers.  The Fifo loops walk the
+// segments directly (rgIoVec), with no copy into one buffer.
+// Length is the total of the list;  a NULL iov_base sends 0x00 bytes,
+// or discards Rx bytes.
+
+/*
+* Write bytes from a segment list to a slave.
+*    As write(), total length 0 sends only the address byte.
+* call:
+*    self.writev( addr, vec, num )
+*    addr = slave address {0..0x7f}
+*    vec  = Tx segment list
+*    num  = number of segments
+* return:
+*    ()  = 0 on success, else Stat error bits (AckErr_1, ClkTimeout_1),
+*	   or ErrPollLimit if abandoned with no progress
+*    get_XferCnt() = bytes placed in the Fifo
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*/
+uint32_t
+rgIic::writev(
+    uint32_t		addr,
+    const struct iovec	*vec,
+    uint32_t		num
+)
+{
+    XTx.init( vec, num );
+
+    return  write_all( "writev", addr, rgIoVec::total( vec, num ) );
+}
+
+
+/*
+* Read bytes from a slave into a segment list.
+* call:
+*    self.readv( addr, vec, num )
+*    addr = slave address {0..0x7f}
+*    vec  = Rx segment list, total length {1..}
+*    num  = number of segments
+* return:
+*    ()  = 0 on success, else Stat error bits (AckErr_1, ClkTimeout_1),
+*	   or ErrPollLimit if abandoned with no progress
+*    get_XferCnt() = bytes received
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  total length is zero
+*/
+uint32_t
+rgIic::readv(
+    uint32_t		addr,
+    const struct iovec	*vec,
+    uint32_t		num
+)
+{
+    XRx.init( vec, num );
+
+    return  read_all( "readv", addr, rgIoVec::total( vec, num ) );
+}
+
+
+/*
+* Write then read with a repeated Start, segment lists.
+*    As write_read(), with the totals of each list as nw and nr.
+* call:
+*    self.write_readv( addr, wvec, nwv, rvec, nrv )
+*    addr = slave address {0..0x7f}
+*    wvec = Tx segment list,  nwv segments,  total {1..16}
+*    rvec = Rx segment list,  nrv segments,  total {1..0xffff}
+* return:
+*    ()  = 0 on success, else Stat error bits (AckErr_1, ClkTimeout_1),
+*	   or ErrPollLimit if abandoned with no progress
+*    get_XferCnt() = bytes received
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  nw not in {1..16}, nr not in {1..0xffff}
+*/
+uint32_t
+rgIic::write_readv(
+    uint32_t		addr,
+    const struct iovec	*wvec,
+    uint32_t		nwv,
+    const struct iovec	*rvec,
+    uint32_t		nrv
+)
+{
+    size_t		nw = rgIoVec::total( wvec, nwv );
+    size_t		nr = rgIoVec::total( rvec, nrv );
+
+    check_write_read( "write_readv", addr, nw, nr );
+
+    XTx.init( wvec, nwv );
+    XRx.init( rvec, nrv );
+
+    begin_write_read( addr, nw, nr );
+
+    while ( ! service_xfer() ) {
+    }
+
+    return  XferErr;
+}
+
+
+/*
+* Start a write_readv() transaction without waiting for it.
+*    As start_write_read().  Rx segment list and buffers must remain valid
+*    until service_xfer() returns true.
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  nw not in {1..16}, nr not in {1..0xffff}
+*/
+void
+rgIic::start_write_readv(
+    uint32_t		addr,
+    const struct iovec	*wvec,
+    uint32_t		nwv,
+    const struct iovec	*rvec,
+    uint32_t		nrv
+)
+{
+    size_t		nw = rgIoVec::total( wvec, nwv );
+    size_t		nr = rgIoVec::total( rvec, nrv );
+
+    check_write_read( "start_write_readv", addr, nw, nr );
+
+    XTx.init( wvec, nwv );
+    XRx.init( rvec, nrv );
+
+    begin_write_read( addr, nw, nr );
+}
+
+
+//--------------------------------------------------------------------------
+// Split transactions
+//--------------------------------------------------------------------------
+
+
+/*
+* Start a short write without waiting for it.
+*    All bytes are placed in the Fifo, so service_xfer() only waits for
+*    TransDone_1 or an error.  n=0 sends only the address byte, the
+*    quickest probe for a device.
+* call:
+*    self.start_write( addr, buf, n )
+*    addr = slave address {0..0x7f}
+*    buf  = Tx data
+*    n    = number of bytes {0..16}
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  n exceeds 16
+*/
+void
+rgIic::start_write(
+    uint32_t		addr,
+    const uint8_t	*buf,
+    uint32_t		n
+)
+{
+    check_addr( "start_write", addr );
+
+    if ( n > FifoDepth ) {
+	std::ostringstream	css;
+	css << "rgIic::start_write():  n requires {0..16}:  " << n;
+	throw std::range_error ( css.str() );
+    }
+
+    XferCnt = 0;
+    PollCnt = 0;
+    XferErr = 0;
+
+    begin_packet( addr, n );
+
+    for ( uint32_t ii = 0;  ii < n;  ii++ ) {
+	Fifo.write( buf[ii] );
+    }
+
+    Cntl.write( Iic_Enable | Iic_Start );
+
+    XLen   = n;
+    XCnt   = n;
+    XStall = 0;
+    XState = xs_Writing;
+}
+
+
+/*
+* Start a read without waiting for it.
+*    Rx buffer must remain valid until service_xfer() returns true.
+* call:
+*    self.start_read( addr, buf, n )
+*    addr = slave address {0..0x7f}
+*    buf  = Rx data buffer
+*    n    = number of bytes {1..0xffff}
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  n not in {1..0xffff}
+*/
+void
+rgIic::start_read(
+    uint32_t		addr,
+    uint8_t		*buf,
+    uint32_t		n
+)
+{
+    check_addr( "start_read", addr );
+
+    if ( (n == 0) || (n > MaxPacket) ) {
+	std::ostringstream	css;
+	css << "rgIic::start_read():  n requires {1..65535}:  " << n;
+	throw std::range_error ( css.str() );
+    }
+
+    XferCnt = 0;
+    PollCnt = 0;
+    XferErr = 0;
+
+    RxOne.iov_base = buf;
+    RxOne.iov_len  = n;
+    XRx.init( &RxOne, 1 );
+
+    begin_packet( addr, n );
+    Cntl.write( Iic_Enable | Iic_Start | Iic_Read );
+
+    XLen   = n;
+    XCnt   = 0;
+    XStall = 0;
+    XState = xs_Reading;
+}
+
+
+/*
+* Abandon a started transaction.
+*    Clears the Fifo and R/C flags, e.g. after a caller poll limit.
+*    The master still finishes the byte in progress and sends Stop on its
+*    own (or ClkTimeout_1).
+*/
+void
+rgIic::abort_xfer()
+{
+    if ( XState != xs_Idle ) {
+	end_error( Stat.read() );
+	XState = xs_Idle;
+    }
+}
+
+
+/*
+* Service a started transaction, one Stat read per call.
+*    start_write():  wait for TransDone_1.
+*    start_read():  drain the Fifo as in read().
+*    start_write_read():  queue the repeated-Start read as soon as
+*    TransActive_1=1, then drain the Fifo.
+* call:
+*    self.service_xfer()
+* return:
+*    ()  = true when finished (or nothing started), false if still busy
+*    get_XferErr() = 0 on success, else Stat error bits, or ErrPollLimit
+*		     if abandoned after PollLimit Stat reads with no progress
+*    get_XferCnt() = bytes moved
+*/
+bool
+rgIic::service_xfer()
+{
+    if ( XState == xs_Idle ) {
+	return  true;
+    }
+
+    uint32_t		st = Stat.read();		// one status read
+    PollCnt++;
+
+    if ( st & Iic_Errors ) {
+	XferCnt += XCnt;
+	XferErr  = end_error( st );
+	XState   = xs_Idle;
+	return  true;
+    }
+
+    if ( XState == xs_Writing ) {
+	if ( st & Iic_TransDone ) {
+	    Stat.write( st );			// clear TransDone_1
+	    XferCnt += XCnt;
+	    XState   = xs_Idle;
+	    return  true;
+	}
+	return  stall_xfer();
+    }
+
+    if ( XState == xs_WaitActive ) {
+	if ( st & (Iic_TransActive | Iic_TransDone) ) {
+	    if ( st & Iic_TransDone ) {
+		Stat.write( st );	// DataLen_16 is ignored until cleared
+	    }
+
+	    DatLen.write( XLen );
+	    Cntl.write( Iic_Enable | Iic_Start | Iic_Read );
+	    XState = xs_Reading;
+	    XStall = 0;
+	    return  false;
+	}
+	return  stall_xfer();
+    }
+
+    uint32_t		nn = ( st & (Iic_TransDone | Iic_RxFull) ) ? FifoDepth :
+			     ( st & Iic_RxHasData )              ? 1 : 0;
+
+    bool		moved = nn && (XCnt < XLen);
+
+    while ( nn-- && (XCnt < XLen) ) {
+	XRx.put( Fifo.read() );
+	XCnt++;
+    }
+
+    if ( (st & Iic_TransDone) && (XCnt >= XLen) ) {
+	Stat.write( st );			// clear TransDone_1
+	XferCnt += XCnt;
+	XferErr  = 0;
+	XState   = xs_Idle;
+	return  true;
+    }
+
+    if ( moved ) {
+	XStall = 0;
+	return  false;
+    }
+
+    return  stall_xfer();
+}
+
+
+/*
+* Count a service pass with no progress, abandon at PollLimit.
+* return:
+*    ()  = true if abandoned (XferErr = ErrPollLimit), false to keep polling
+*/
+bool
+rgIic::stall_xfer()
+{
+    if ( (PollLimit == 0) || (++XStall < PollLimit) ) {
+	return  false;
+    }
+
+    XferCnt += XCnt;
+    abort_xfer();
+    XferErr  = ErrPollLimit;
+    return  true;
+}
+
+
+/*
+* Check write_read() arguments.
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  nw not in {1..16}, nr not in {1..0xffff}
+*/
+void
+rgIic::check_write_read(
+    const char		*fn,
+    uint32_t		addr,
+    size_t		nw,
+    size_t		nr
+)
+{
+    check_addr( fn, addr );
+
+    if ( (nw == 0) || (nw > FifoDepth) ) {
+	std::ostringstream	css;
+	css << "rgIic::" << fn << "():  nw requires {1..16}:  " << nw;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( (nr == 0) || (nr > MaxPacket) ) {
+	std::ostringstream	css;
+	css << "rgIic::" << fn << "():  nr requires {1..65535}:  " << nr;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Start the write of a write_read(), leaving the read to service_xfer().
+*    Tx and Rx cursors already set.
+*/
+void
+rgIic::begin_write_read(
+    uint32_t		addr,
+    uint32_t		nw,
+    uint32_t		nr
+)
+{
+    XferCnt = 0;
+    PollCnt = 0;
+    XferErr = 0;
+
+    begin_packet( addr, nw );
+
+    for ( uint32_t ii = 0;  ii < nw;  ii++ ) {
+	Fifo.write( XTx.get( 0 ) );
+    }
+
+    Cntl.write( Iic_Enable | Iic_Start );
+
+    XLen   = nr;
+    XCnt   = 0;
+    XStall = 0;
+    XState = xs_WaitActive;
+}
+
+
+/*
+* Check slave address.
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*/
+void
+rgIic::check_addr(
+    const char		*fn,
+    uint32_t		addr
+)
+{
+    if ( addr > 0x7f ) {
+	std::ostringstream	css;
+	css << "rgIic::" << fn << "():  addr exceeds 0x7f:  0x" << hex << addr;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Set up one packet:  clear R/C flags and the Fifo, set address and length.
+*    Transfer is not started.
+*/
+void
+rgIic::begin_packet(
+    uint32_t		addr,
+    uint32_t		len
+)
+{
+    uint32_t		st = Stat.read();
+
+    if ( st & (Iic_Errors | Iic_TransDone) ) {
+	Stat.write( st );		// clear flags seen
+    }
+
+    Cntl.write( Iic_Enable | Iic_ClearFifo );
+    Addr.write( addr );
+    DatLen.write( len );
+}
+
+
+/*
+* Write one packet, keeping the Fifo topped up.
+*    Prefill up to FifoDepth bytes before Start, then each pass:
+*    TxEmpty_1=1 write up to FifoDepth bytes, else TxHasSpace_1=1 write one.
+*    Abandoned after PollLimit passes with no bytes written.
+* return:
+*    ()  = 0 on success, else Stat error bits, or ErrPollLimit
+*/
+uint32_t
+rgIic::write_packet(
+    uint32_t		addr,
+    uint32_t		len
+)
+{
+    uint32_t		cnt   = 0;
+    uint32_t		stall = 0;
+
+    begin_packet( addr, len );
+
+    while ( (cnt < len) && (cnt < FifoDepth) ) {
+	Fifo.write( XTx.get( 0 ) );
+	cnt++;
+    }
+
+    Cntl.write( Iic_Enable | Iic_Start );
+
+    while ( 1 ) {
+	uint32_t	st = Stat.read();		// one status read
+	PollCnt++;
+
+	if ( st & Iic_Errors ) {
+	    XferCnt += cnt;
+	    XferErr  = end_error( st );
+	    return  XferErr;
+	}
+
+	if ( cnt < len ) {
+	    uint32_t	room = ( st & Iic_TxEmpty )    ? FifoDepth :
+			       ( st & Iic_TxHasSpace ) ? 1 : 0;
+
+	    if ( room ) {
+		stall = 0;
+	    }
+
+	    while ( room-- && (cnt < len) ) {
+		Fifo.write( XTx.get( 0 ) );
+		cnt++;
+	    }
+	}
+	else if ( st & Iic_TransDone ) {
+	    Stat.write( st );			// clear TransDone_1
+	    break;
+	}
+
+	if ( PollLimit && (++stall >= PollLimit) ) {
+	    XferCnt += cnt;
+	    end_error( Stat.read() );		// as abort_xfer()
+	    XferErr  = ErrPollLimit;
+	    return  XferErr;
+	}
+    }
+
+    XferCnt += cnt;
+    return  0;
+}
+
+
+/*
+* Write n bytes from the Tx cursor, chained in MaxPacket packets.
+* return:
+*    ()  = 0 on success, else Stat error bits
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*/
+uint32_t
+rgIic::write_all(
+    const char		*fn,
+    uint32_t		addr,
+    size_t		n
+)
+{
+    check_addr( fn, addr );
+
+    XferCnt = 0;
+    PollCnt = 0;
+    XferErr = 0;
+
+    do {
+	uint32_t	len = ( n > MaxPacket ) ? MaxPacket : n;
+	uint32_t	err = write_packet( addr, len );
+
+	if ( err ) {
+	    return  err;
+	}
+
+	n -= len;
+    } while ( n );
+
+    return  0;
+}
+
+
+/*
+* Read n bytes into the Rx cursor, chained in MaxPacket packets.
+* return:
+*    ()  = 0 on success, else Stat error bits
+* exceptions:
+*    range_error  addr exceeds 0x7f
+*    range_error  n is zero (can hang the bus, see rgIic(7))
+*/
+uint32_t
+rgIic::read_all(
+    const char		*fn,
+    uint32_t		addr,
+    size_t		n
+)
+{
+    check_addr( fn, addr );
+
+    if ( n == 0 ) {
+	std::ostringstream	css;
+	css << "rgIic::" << fn << "():  require n > 0";
+	throw std::range_error ( css.str() );
+    }
+
+    XferCnt = 0;
+    PollCnt = 0;
+    XferErr = 0;
+
+    while ( n ) {
+	uint32_t	len = ( n > MaxPacket ) ? MaxPacket : n;
+
+	begin_packet( addr, len );
+	Cntl.write( Iic_Enable | Iic_Start | Iic_Read );
+
+	uint32_t	err = read_packet( len );
+	if ( err ) {
+	    return  err;
+	}
+
+	n -= len;
+    }
+
+    return  0;
+}
+
+
+/*
+* Read one started packet, draining the Fifo.
+*    Each pass:  TransDone_1=1 read all remaining (at most FifoDepth),
+*    else RxFull_1=1 read FifoDepth bytes, else RxHasData_1=1 read one.
+* return:
+*    ()  = 0 on success, else Stat error bits
+*/
+uint32_t
+rgIic::read_packet(
+    uint32_t		len
+)
+{
+    XLen   = len;
+    XCnt   = 0;
+    XStall = 0;
+    XState = xs_Reading;
+
+    while ( ! service_xfer() ) {
+    }
+
+    return  XferErr;
+}
+
+
+/*
+* End a transaction on error.
+*    Clear the R/C flags seen and the Fifo.  The master has already sent
+*    Stop (AckErr_1) or given up (ClkTimeout_1).
+* return:
+*    ()  = error bits of st
+*/
+uint32_t
+rgIic::end_error(
+    uint32_t		st
+)
+{
+    Stat.write( st );
+    Cntl.write( Iic_Enable | Iic_ClearFifo );
+
+    return  ( st & Iic_Errors );
+}
+
+
 //--------------------------------------------------------------------------
 // Debug
 //--------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #define rgIic_P
 
 #include "rgRegister.h"
+#include "rgIoVec.h"
 
 //--------------------------------------------------------------------------
 // rGPIO IIC (I2C) Master class.
@@ -115,6 +116,28 @@ class rgIic {
     uint32_t		IicNum;		// IIC unit number {0,1,2}
     uint32_t		FeatureAddr;	// BCM doc value, in constructor
 
+				// Transaction engine state
+    uint32_t		XferCnt;	// bytes moved, last transaction
+    uint32_t		PollCnt;	// Stat reads, last transaction
+    uint32_t		XferErr;	// Stat error bits, last transaction
+    uint32_t		PollLimit;	// Stat reads with no progress, 0= none
+    uint32_t		XStall;		// Stat reads since progress
+
+    enum XState_enum {			// service_xfer() state
+	xs_Idle = 0,
+	xs_Writing,			// whole write in Fifo
+	xs_WaitActive,			// write started, read not queued
+	xs_Reading			// draining Rx Fifo
+    };
+
+    XState_enum		XState;
+    rgIoVec		XTx;		// Tx data cursor
+    rgIoVec		XRx;		// Rx data cursor
+    struct iovec	TxOne;		// Tx segment of pointer calls
+    struct iovec	RxOne;		// Rx segment of pointer calls
+    uint32_t		XLen;		// Rx length
+    uint32_t		XCnt;		// Rx bytes so far
+
   public:
 				// Registers
     rgIic_Cntl		Cntl;		// C     Control
@@ -138,6 +161,13 @@ class rgIic {
     static const uint32_t	ClkStr_offset    = 0x1c /4;
     //##!  maybe put in constructor instead
 
+  public:
+    static const uint32_t	FifoDepth        = 16;		// bytes
+    static const uint32_t	MaxPacket        = 0xffff;	// DataLen_16
+
+				// XferErr bit, not in Stat
+    static const uint32_t	ErrPollLimit     = 1u << 31;	// abandoned
+
   public:
     rgIic(			// constructor
 	rgAddrMap	*xx,
@@ -148,6 +178,126 @@ class rgIic {
     volatile uint32_t*	get_base_addr()  { return  GpioBase; }
     uint32_t		get_iic_num()    { return  IicNum; }
 
+		// Transaction engine
+    uint32_t		write(
+			    uint32_t		addr,
+			    const uint8_t	*buf,
+			    uint32_t		n
+			);
+
+    uint32_t		read(
+			    uint32_t		addr,
+			    uint8_t		*buf,
+			    uint32_t		n
+			);
+
+    uint32_t		write_read(
+			    uint32_t		addr,
+			    const uint8_t	*wbuf,
+			    uint32_t		nw,
+			    uint8_t		*rbuf,
+			    uint32_t		nr
+			);
+
+    void		start_write_read(
+			    uint32_t		addr,
+			    const uint8_t	*wbuf,
+			    uint32_t		nw,
+			    uint8_t		*rbuf,
+			    uint32_t		nr
+			);
+
+		// Scatter/gather, segment lists as writev(2)
+    uint32_t		writev(
+			    uint32_t		addr,
+			    const struct iovec	*vec,
+			    uint32_t		num
+			);
+
+    uint32_t		readv(
+			    uint32_t		addr,
+			    const struct iovec	*vec,
+			    uint32_t		num
+			);
+
+    uint32_t		write_readv(
+			    uint32_t		addr,
+			    const struct iovec	*wvec,
+			    uint32_t		nwv,
+			    const struct iovec	*rvec,
+			    uint32_t		nrv
+			);
+
+    void		start_write_readv(
+			    uint32_t		addr,
+			    const struct iovec	*wvec,
+			    uint32_t		nwv,
+			    const struct iovec	*rvec,
+			    uint32_t		nrv
+			);
+
+    void		start_write(
+			    uint32_t		addr,
+			    const uint8_t	*buf,
+			    uint32_t		n
+			);
+
+    void		start_read(
+			    uint32_t		addr,
+			    uint8_t		*buf,
+			    uint32_t		n
+			);
+
+    bool		service_xfer();
+    void		abort_xfer();
+
+    inline bool		is_busy()        { return  XState != xs_Idle; }
+    inline uint32_t	get_XferCnt()    { return  XferCnt; }
+    inline uint32_t	get_PollCnt()    { return  PollCnt; }
+    inline uint32_t	get_XferErr()    { return  XferErr; }
+
+    inline void		config_PollLimit( uint32_t  v )  { PollLimit = v; }
+    inline uint32_t	config_PollLimit()               { return  PollLimit; }
+
+  private:
+    void		begin_packet(
+			    uint32_t		addr,
+			    uint32_t		len
+			);
+    uint32_t		write_all(
+			    const char		*fn,
+			    uint32_t		addr,
+			    size_t		n
+			);
+    uint32_t		read_all(
+			    const char		*fn,
+			    uint32_t		addr,
+			    size_t		n
+			);
+    uint32_t		write_packet(
+			    uint32_t		addr,
+			    uint32_t		len
+			);
+    uint32_t		read_packet(
+			    uint32_t		len
+			);
+    void		begin_write_read(
+			    uint32_t		addr,
+			    uint32_t		nw,
+			    uint32_t		nr
+			);
+    void		check_write_read(
+			    const char		*fn,
+			    uint32_t		addr,
+			    size_t		nw,
+			    size_t		nr
+			);
+    uint32_t		end_error( uint32_t  st );
+    bool		stall_xfer();
+    void		check_addr( const char  *fn,  uint32_t  addr );
+
+  public:
+
 		// Object state operations
     void		init_put_reset();
 
@@ -0,0 +1,329 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgIicScan - I2C bus scan on several rgIic units, one thread
+//
+// See:  doc/iic_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+
+#include "rgIicScan.h"
+
+/*
+* Constructor.
+*    No units.  Auto mode, range 0x08..0x77 (as i2cdetect).
+* call:
+*    rgIicScan		scn;
+*/
+rgIicScan::rgIicScan()
+{
+    Mode      = sm_Auto;
+    First     = 0x08;
+    Last      = 0x77;
+    PollLimit = 1000000;
+
+    clear();
+}
+
+
+//--------------------------------------------------------------------------
+// Setup
+//--------------------------------------------------------------------------
+
+/*
+* Add a unit to scan.
+* call:
+*    self.add_unit( &icx )
+*    icx = IIC unit object
+* return:
+*    ()  = index of this unit, for results
+* exceptions:
+*    range_error if full, or unit already added
+*/
+uint32_t
+rgIicScan::add_unit(
+    rgIic		*icx
+)
+{
+    if ( NumUnit >= MaxUnit ) {
+	std::ostringstream	css;
+	css << "rgIicScan::add_unit():  exceeds MaxUnit:  " << MaxUnit;
+	throw std::range_error ( css.str() );
+    }
+
+    for ( uint32_t ii=0;  ii < NumUnit;  ii++ )
+    {
+	if ( UnitV[ii].Iic->get_iic_num() == icx->get_iic_num() ) {
+	    std::ostringstream	css;
+	    css << "rgIicScan::add_unit():  duplicate iic unit:  "
+		<< icx->get_iic_num();
+	    throw std::range_error ( css.str() );
+	}
+    }
+
+    Unit&	ux = UnitV[NumUnit];
+
+    ux.Iic      = icx;
+    ux.Cur      = -1;
+    ux.Next     = 0;
+    ux.Polls    = 0;
+    ux.FoundCnt = 0;
+    ux.RxByte   = 0;
+
+    for ( uint32_t aa=0;  aa < 128;  aa++ ) {
+	ux.Res[aa] = sr_None;
+    }
+
+    return  NumUnit++;
+}
+
+
+/*
+* Remove all units.
+*/
+void
+rgIicScan::clear()
+{
+    NumUnit = 0;
+    PollCnt = 0;
+}
+
+
+/*
+* Configure address range.
+*    Addresses 0x00..0x07 and 0x78..0x7f are reserved by the I2C spec
+*    (general call, CBUS, 10-bit address, etc.), and not in the default.
+* call:
+*    self.config_Range( first, last )
+* exceptions:
+*    range_error  unless first <= last <= 0x7f
+*/
+void
+rgIicScan::config_Range(
+    uint32_t		first,
+    uint32_t		last
+)
+{
+    if ( (first > last) || (last > 0x7f) ) {
+	std::ostringstream	css;
+	css << "rgIicScan::config_Range():  require first <= last <= 0x7f:  0x"
+	    << hex << first << " 0x" << last;
+	throw std::range_error ( css.str() );
+    }
+
+    First = first;
+    Last  = last;
+}
+
+
+//--------------------------------------------------------------------------
+// Scan
+//--------------------------------------------------------------------------
+
+					// Stat bits, as get_XferErr()
+static const uint32_t	Iic_ClkTimeout  = 1 <<  9;	// CLKT
+
+/*
+* Scan all units.
+*    Each pass services the probe in flight on each unit (one Stat read),
+*    records its result, and starts the next address on that unit.
+*    A probe not done after PollLimit passes is abandoned.
+* call:
+*    self.run()
+* return:
+*    ()  = number of devices found on all units
+*/
+uint32_t
+rgIicScan::run()
+{
+    uint32_t		found = 0;
+
+    PollCnt = 0;
+
+    for ( uint32_t uu=0;  uu < NumUnit;  uu++ )
+    {
+	Unit&	ux = UnitV[uu];
+
+	ux.Cur      = -1;
+	ux.Next     = First;
+	ux.FoundCnt = 0;
+
+	for ( uint32_t aa=0;  aa < 128;  aa++ ) {
+	    ux.Res[aa] = sr_None;
+	}
+    }
+
+    while ( 1 ) {
+	uint32_t	busy = 0;
+
+	for ( uint32_t uu=0;  uu < NumUnit;  uu++ )
+	{
+	    Unit&	ux = UnitV[uu];
+
+	    if ( ux.Cur >= 0 ) {
+		Res_enum	rr = sr_None;
+
+		PollCnt++;
+		ux.Polls++;
+
+		if ( ux.Iic->service_xfer() ) {
+		    uint32_t	err = ux.Iic->get_XferErr();
+
+		    rr = ( err == 0 )                    ? sr_Found :
+			 ( err & rgIic::ErrPollLimit )  ? sr_PollLimit :
+			 ( err & Iic_ClkTimeout )        ? sr_ClkTimeout :
+							   sr_Absent;
+		}
+		else if ( PollLimit && (ux.Polls >= PollLimit) ) {
+		    ux.Iic->abort_xfer();
+		    rr = sr_PollLimit;
+		}
+
+		if ( rr != sr_None ) {
+		    ux.Res[ux.Cur] = rr;
+		    if ( rr == sr_Found ) {
+			ux.FoundCnt++;
+			found++;
+		    }
+		    ux.Cur = -1;
+		}
+	    }
+
+	    if ( (ux.Cur < 0) && (ux.Next <= Last) ) {
+		start_probe( ux );
+	    }
+
+	    if ( ux.Cur >= 0 ) {
+		busy++;
+	    }
+	}
+
+	if ( busy == 0 ) {
+	    break;
+	}
+    }
+
+    return  found;
+}
+
+
+/*
+* Start probe of the next address on one unit.
+*    Auto mode reads where a write could change device state, as i2cdetect:
+*    0x30-0x37 (often write-protect on EEPROMs), 0x50-0x5f (EEPROMs).
+*/
+void
+rgIicScan::start_probe(
+    Unit&		ux
+)
+{
+    uint32_t		aa = ux.Next++;
+
+    bool		rd = ( Mode == sm_Read ) ||
+			     ( (Mode == sm_Auto) &&
+			       ( ((aa >= 0x30) && (aa <= 0x37)) ||
+				 ((aa >= 0x50) && (aa <= 0x5f)) ) );
+
+    if ( rd ) {
+	ux.Iic->start_read( aa, &ux.RxByte, 1 );
+    }
+    else {
+	ux.Iic->start_write( aa, NULL, 0 );
+    }
+
+    ux.Cur   = aa;
+    ux.Polls = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Results
+//--------------------------------------------------------------------------
+
+/*
+* Check index is in use.
+* exceptions:
+*    range_error if not
+*/
+void
+rgIicScan::check_index(
+    const char		*fn,
+    uint32_t		ii
+)
+{
+    if ( ii >= NumUnit ) {
+	std::ostringstream	css;
+	css << "rgIicScan::" << fn << "():  index exceeds NumUnit:  " << ii;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Get result of one address.
+* call:
+*    self.get_result( ii, addr )
+*    ii   = index returned by add_unit()
+*    addr = slave address {0..0x7f}
+* exceptions:
+*    range_error if index not in use, or addr exceeds 0x7f
+*/
+rgIicScan::Res_enum
+rgIicScan::get_result(
+    uint32_t		ii,
+    uint32_t		addr
+)
+{
+    check_index( "get_result", ii );
+
+    if ( addr > 0x7f ) {
+	std::ostringstream	css;
+	css << "rgIicScan::get_result():  addr exceeds 0x7f:  0x"
+	    << hex << addr;
+	throw std::range_error ( css.str() );
+    }
+
+    return  (Res_enum) UnitV[ii].Res[addr];
+}
+
+
+/*
+* Test if a device acknowledged an address.
+* exceptions:
+*    range_error if index not in use, or addr exceeds 0x7f
+*/
+bool
+rgIicScan::is_found(
+    uint32_t		ii,
+    uint32_t		addr
+)
+{
+    return  ( get_result( ii, addr ) == sr_Found );
+}
+
+
+/*
+* Get number of devices found on one unit, last run().
+* exceptions:
+*    range_error if index not in use
+*/
+uint32_t
+rgIicScan::get_FoundCnt(
+    uint32_t		ii
+)
+{
+    check_index( "get_FoundCnt", ii );
+    return  UnitV[ii].FoundCnt;
+}
+
@@ -0,0 +1,93 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgIicScan_P
+#define rgIicScan_P
+
+#include "rgIic.h"
+
+//--------------------------------------------------------------------------
+// rgIicScan - I2C bus scan on several rgIic units, one thread
+//--------------------------------------------------------------------------
+// Probe each slave address in a range with a zero-length write (Quick) or
+// a one byte read, on all units at the same time.  One polling loop keeps
+// one probe in flight per unit with rgIic::service_xfer(), so a missing
+// device (AckErr_1 on the address byte) costs only the address byte time.
+//
+// e.g.
+//    rgIicScan		scn;
+//    scn.add_unit( &iic0 );
+//    scn.add_unit( &iic1 );
+//    scn.run();
+//    if ( scn.is_found( 1, 0x68 ) ) { ... }
+
+class rgIicScan {
+  public:
+    static const uint32_t	MaxUnit = 8;	// IIC units {0..7}
+
+    enum Mode_enum {		// probe transaction
+	sm_Quick = 0,		// zero-length write, address only
+	sm_Read,		// one byte read
+	sm_Auto			// Read for 0x30-0x37, 0x50-0x5f, else Quick
+    };
+
+    enum Res_enum {		// result of one address
+	sr_None = 0,		// not probed
+	sr_Absent,		// AckErr_1, no device
+	sr_Found,		// acknowledged
+	sr_ClkTimeout,		// ClkTimeout_1, slave held SCL low
+	sr_PollLimit		// no completion, abandoned
+    };
+
+  private:
+    struct Unit {
+	rgIic		*Iic;		// unit object
+	int32_t		Cur;		// address in flight, -1= idle
+	uint32_t	Next;		// next address to probe
+	uint32_t	Polls;		// service passes of probe in flight
+	uint32_t	FoundCnt;	// devices found
+	uint8_t		RxByte;		// read probe data, discarded
+	uint8_t		Res[128];	// Res_enum by address
+    };
+
+    Unit		UnitV[MaxUnit];
+    uint32_t		NumUnit;	// number of UnitV[] in use
+
+    Mode_enum		Mode;		// probe transaction
+    uint32_t		First;		// first address
+    uint32_t		Last;		// last address
+    uint32_t		PollLimit;	// service passes per probe, 0= none
+
+    uint64_t		PollCnt;	// Stat reads, last run()
+
+  public:
+    rgIicScan();			// constructor
+
+    uint32_t		add_unit( rgIic  *icx );
+    void		clear();
+
+    inline void		config_Mode( Mode_enum  v )  { Mode = v; }
+    inline Mode_enum	config_Mode()                { return  Mode; }
+
+    void		config_Range( uint32_t  first,  uint32_t  last );
+    inline uint32_t	config_First()      { return  First; }
+    inline uint32_t	config_Last()       { return  Last; }
+
+    inline void		config_PollLimit( uint32_t  v )  { PollLimit = v; }
+    inline uint32_t	config_PollLimit()               { return  PollLimit; }
+
+    uint32_t		run();
+
+		// Results, index in order of add_unit()
+    inline uint32_t	get_NumUnit()   { return  NumUnit; }
+    inline uint64_t	get_PollCnt()   { return  PollCnt; }
+    Res_enum		get_result(   uint32_t  ii,  uint32_t  addr );
+    bool		is_found(     uint32_t  ii,  uint32_t  addr );
+    uint32_t		get_FoundCnt( uint32_t  ii );
+
+  private:
+    void		start_probe( Unit&  ux );
+    void		check_index( const char* fn,  uint32_t  ii );
+};
+
+#endif
+
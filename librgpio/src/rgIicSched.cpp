@@ -0,0 +1,420 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgIicSched - Periodic I2C register polling over several rgIic units
+//
+// See:  doc/iic_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+#include "rgSysTimer.h"
+
+#include "rgIicSched.h"
+
+/*
+* Constructor.
+*    No jobs.
+* call:
+*    rgIicSched		sch  ( &stx );
+*    &stx  = System Timer object, for timestamps and periods
+*/
+rgIicSched::rgIicSched(
+    rgSysTimer		*stx
+)
+{
+    Tmr = stx;
+    StopReq.store( 0 );
+    clear();
+}
+
+
+//--------------------------------------------------------------------------
+// Setup
+//--------------------------------------------------------------------------
+
+/*
+* Add a periodic register read job.
+*    Each rgIic object is one unit;  jobs on the same unit run in turn.
+*    Not concurrent with run().
+* call:
+*    self.add_job( &icx, addr, reg, len, period_us )
+*    icx       = IIC unit object
+*    addr      = slave address {0..0x7f}
+*    reg       = register address byte {0..0xff}, written before the read
+*    len       = bytes to read {1..16}
+*    period_us = poll period in microseconds, 0= as often as possible
+* return:
+*    ()  = index of this job, for get_result()
+* exceptions:
+*    range_error if full, or argument out of range
+*/
+uint32_t
+rgIicSched::add_job(
+    rgIic		*icx,
+    uint32_t		addr,
+    uint32_t		reg,
+    uint32_t		len,
+    uint32_t		period_us
+)
+{
+    if ( NumJob >= MaxJob ) {
+	std::ostringstream	css;
+	css << "rgIicSched::add_job():  exceeds MaxJob:  " << MaxJob;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( addr > 0x7f ) {
+	std::ostringstream	css;
+	css << "rgIicSched::add_job():  addr exceeds 0x7f:  0x" << hex << addr;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( reg > 0xff ) {
+	std::ostringstream	css;
+	css << "rgIicSched::add_job():  reg exceeds 0xff:  0x" << hex << reg;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( (len == 0) || (len > MaxLen) ) {
+	std::ostringstream	css;
+	css << "rgIicSched::add_job():  len requires {1..16}:  " << len;
+	throw std::range_error ( css.str() );
+    }
+
+    uint32_t		uu;
+    for ( uu=0;  uu < NumUnit;  uu++ )
+    {
+	if ( UnitV[uu].Iic->get_iic_num() == icx->get_iic_num() ) {
+	    break;
+	}
+    }
+
+    if ( uu == NumUnit ) {		// new unit
+	if ( NumUnit >= MaxUnit ) {
+	    std::ostringstream	css;
+	    css << "rgIicSched::add_job():  exceeds MaxUnit:  " << MaxUnit;
+	    throw std::range_error ( css.str() );
+	}
+
+	UnitV[uu].Iic = icx;
+	UnitV[uu].Cur = -1;
+	NumUnit++;
+    }
+
+    Job&	jj = JobV[NumJob];
+
+    jj.Unit     = uu;
+    jj.Addr     = addr;
+    jj.Reg      = reg;
+    jj.Len      = len;
+    jj.PeriodUs = period_us;
+    jj.Due      = 0;
+    jj.Seq      = 0;
+    jj.LateCnt  = 0;
+
+    for ( uint32_t kk=0;  kk < 2;  kk++ )
+    {
+	Buf&	bb = jj.BufV[kk];
+
+	bb.Res.Time = 0;
+	bb.Res.Seq  = 0;
+	bb.Res.Err  = 0;
+	bb.Res.Len  = 0;
+	for ( uint32_t ii=0;  ii < MaxLen;  ii++ ) {
+	    bb.Res.Data[ii] = 0;
+	}
+	bb.Ver.store( 0 );
+    }
+    jj.Pub.store( 0 );
+
+    return  NumJob++;
+}
+
+
+/*
+* Remove all jobs and units, zero statistics.
+*    Not concurrent with run().
+*/
+void
+rgIicSched::clear()
+{
+    NumJob  = 0;
+    NumUnit = 0;
+    PassCnt = 0;
+    XferCnt = 0;
+    ErrCnt  = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Polling loop
+//--------------------------------------------------------------------------
+
+/*
+* One service pass at time now.
+*    Service the transaction in flight on each unit (one Stat read each),
+*    publishing results that completed.  Then start the most overdue job
+*    on each idle unit.
+* call:
+*    self.service_all( now )
+*    now = System Timer time in microseconds
+* return:
+*    ()  = number of units with a transaction in flight
+*/
+uint32_t
+rgIicSched::service_all(
+    uint64_t		now
+)
+{
+    return  service_pass( now, 1 );
+}
+
+
+/*
+* Run the polling loop.
+*    Each pass reads the System Timer low word once and extends it to
+*    64 bits for due times and result timestamps.
+*    Stops after duration_us, or at stop(), then completes the
+*    transactions in flight.  A unit that stops making progress ends its
+*    transaction at the rgIic PollLimit (Err = rgIic::ErrPollLimit), so
+*    this does not wait forever.
+* call:
+*    self.run( duration_us )
+*    duration_us = run time in microseconds, 0= until stop()
+* return:
+*    ()  = number of transactions completed
+*/
+uint64_t
+rgIicSched::run(
+    uint64_t		duration_us
+)
+{
+    uint64_t		x0  = XferCnt;
+
+    uint64_t		t64  = Tmr->TimeDw.grab64();
+    uint64_t		hi   = t64 & 0xffffffff00000000ull;
+    uint32_t		last = t64;
+    uint64_t		t_end = t64 + duration_us;
+
+    while ( 1 ) {
+	uint32_t	w0 = Tmr->TimeW0.read();
+	if ( w0 < last ) {
+	    hi += 0x100000000ull;		// low word wrapped
+	}
+	last = w0;
+
+	uint64_t	now  = hi | w0;
+	bool		more = ( ! StopReq.load( std::memory_order_relaxed ) )
+			       && ( (duration_us == 0) || (now < t_end) );
+
+	if ( (service_pass( now, more ) == 0) && ! more ) {
+	    break;
+	}
+    }
+
+    StopReq.store( 0 );
+
+    return  XferCnt - x0;
+}
+
+
+/*
+* Service pass, optionally without starting new jobs.
+*    Due time advances by one period per start.  If a whole period was
+*    missed, the job is counted late and rescheduled from now, rather
+*    than started back-to-back to catch up.
+*/
+uint32_t
+rgIicSched::service_pass(
+    uint64_t		now,
+    bool		start
+)
+{
+    int32_t		best[MaxUnit];
+    uint32_t		busy = 0;
+
+    PassCnt++;
+
+    for ( uint32_t uu=0;  uu < NumUnit;  uu++ )
+    {
+	Unit&	ux = UnitV[uu];
+
+	if ( (ux.Cur >= 0) && ux.Iic->service_xfer() ) {
+	    publish( JobV[ux.Cur], ux, now );
+	    ux.Cur = -1;
+	}
+	best[uu] = -1;
+    }
+
+    if ( start ) {
+	for ( uint32_t ii=0;  ii < NumJob;  ii++ )
+	{
+	    Job&	jj = JobV[ii];
+	    uint32_t	uu = jj.Unit;
+
+	    if ( (UnitV[uu].Cur < 0) && (jj.Due <= now) &&
+		 ( (best[uu] < 0) || (jj.Due < JobV[best[uu]].Due) )
+	    ) {
+		best[uu] = ii;
+	    }
+	}
+    }
+
+    for ( uint32_t uu=0;  uu < NumUnit;  uu++ )
+    {
+	Unit&	ux = UnitV[uu];
+
+	if ( best[uu] >= 0 ) {
+	    Job&	jj = JobV[best[uu]];
+
+	    ux.Iic->start_write_read( jj.Addr, &jj.Reg, 1, ux.Rx, jj.Len );
+	    ux.Cur = best[uu];
+
+	    if ( (jj.Due == 0) || (jj.Due + jj.PeriodUs <= now) ) {
+		if ( jj.Due && jj.PeriodUs ) {
+		    jj.LateCnt++;
+		}
+		jj.Due = now + jj.PeriodUs;
+	    }
+	    else {
+		jj.Due += jj.PeriodUs;
+	    }
+	}
+
+	if ( ux.Cur >= 0 ) {
+	    busy++;
+	}
+    }
+
+    return  busy;
+}
+
+
+/*
+* Publish a completed transaction to the older buffer of the job.
+*    Ver is odd while the buffer is written, then Pub is switched to it.
+*/
+void
+rgIicSched::publish(
+    Job&		jj,
+    Unit&		ux,
+    uint64_t		now
+)
+{
+    uint32_t		kk = jj.Pub.load( std::memory_order_relaxed ) ^ 1;
+    Buf&		bb = jj.BufV[kk];
+    uint32_t		vv = bb.Ver.load( std::memory_order_relaxed );
+    uint32_t		err = ux.Iic->get_XferErr();
+
+    XferCnt++;
+    if ( err ) {
+	ErrCnt++;
+    }
+    jj.Seq++;
+
+    bb.Ver.store( vv + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    bb.Res.Time = now;
+    bb.Res.Seq  = jj.Seq;
+    bb.Res.Err  = err;
+    bb.Res.Len  = jj.Len;
+    for ( uint32_t ii=0;  ii < jj.Len;  ii++ ) {
+	bb.Res.Data[ii] = ux.Rx[ii];
+    }
+
+    bb.Ver.store( vv + 2, std::memory_order_release );
+    jj.Pub.store( kk, std::memory_order_release );
+}
+
+
+//--------------------------------------------------------------------------
+// Results and statistics
+//--------------------------------------------------------------------------
+
+/*
+* Check index is in use.
+* exceptions:
+*    range_error if not
+*/
+void
+rgIicSched::check_index(
+    const char		*fn,
+    uint32_t		ii
+)
+{
+    if ( ii >= NumJob ) {
+	std::ostringstream	css;
+	css << "rgIicSched::" << fn << "():  index exceeds NumJob:  " << ii;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Get newest result of one job, without blocking the polling loop.
+*    Copies the published buffer, and retries only if it was rewritten
+*    during the copy (two newer results completed meanwhile).
+* call:
+*    self.get_result( ii, rr )
+*    ii  = index returned by add_job()
+*    rr  = result copy
+* return:
+*    ()  = true if there is a result (rr.Seq > 0)
+* exceptions:
+*    range_error if index not in use
+*/
+bool
+rgIicSched::get_result(
+    uint32_t		ii,
+    rgIicSched_Result&	rr
+)
+{
+    check_index( "get_result", ii );
+
+    Job&		jj = JobV[ii];
+
+    while ( 1 ) {
+	Buf&		bb = jj.BufV[ jj.Pub.load( std::memory_order_acquire ) ];
+	uint32_t	v1 = bb.Ver.load( std::memory_order_acquire );
+
+	if ( v1 & 1 ) {
+	    continue;			// being written
+	}
+
+	rr = bb.Res;
+
+	std::atomic_thread_fence( std::memory_order_acquire );
+	if ( bb.Ver.load( std::memory_order_relaxed ) == v1 ) {
+	    break;
+	}
+    }
+
+    return  ( rr.Seq != 0 );
+}
+
+
+/*
+* Get late count of one job, starts that missed a whole period.
+* exceptions:
+*    range_error if index not in use
+*/
+uint32_t
+rgIicSched::get_LateCnt(
+    uint32_t		ii
+)
+{
+    check_index( "get_LateCnt", ii );
+    return  JobV[ii].LateCnt;
+}
+
@@ -0,0 +1,124 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgIicSched_P
+#define rgIicSched_P
+
+#include <atomic>
+
+#include "rgIic.h"
+#include "rgSysTimer.h"
+
+//--------------------------------------------------------------------------
+// rgIicSched - Periodic I2C register polling over several rgIic units
+//--------------------------------------------------------------------------
+// Each job is a periodic register read (write one register byte, repeated
+// Start, read Len bytes) on one rgIic unit.  One polling loop runs a
+// transaction on every unit at the same time, servicing each with
+// rgIic::service_xfer() and starting the most overdue job as soon as a
+// unit is idle.
+// Results go to a preallocated table with two buffers per job.  The loop
+// writes the older buffer and then publishes it, so a reader (any thread)
+// never blocks the loop;  a reader retries only if the loop overwrote the
+// buffer during its copy.
+//
+// e.g.
+//    rgIicSched	sch   ( &stx );
+//    sch.add_job( &iic0, 0x68, 0x3b, 6, 1000 );	// accel, 1 ms
+//    sch.add_job( &iic1, 0x48, 0x00, 2, 5000 );	// temp,  5 ms
+//    sch.run( 0 );				// until stop()
+//
+//    rgIicSched_Result	rr;
+//    if ( sch.get_result( 0, rr ) ) { ... }		// other thread
+
+struct rgIicSched_Result {
+    uint64_t		Time;		// System Timer at completion, us
+    uint32_t		Seq;		// completions of this job, 0= none
+    uint32_t		Err;		// Stat error bits, 0= success
+    uint32_t		Len;		// bytes in Data[]
+    uint8_t		Data[16];	// register value
+};
+
+
+class rgIicSched {
+  public:
+    static const uint32_t	MaxJob  = 32;
+    static const uint32_t	MaxUnit = 8;	// IIC units {0..7}
+    static const uint32_t	MaxLen  = 16;	// bytes per read
+
+  private:
+    struct Buf {			// one published result
+	rgIicSched_Result	Res;
+	std::atomic<uint32_t>	Ver;	// odd while being written
+    };
+
+    struct Job {
+	uint32_t		Unit;		// index in UnitV[]
+	uint32_t		Addr;		// slave address
+	uint8_t			Reg;		// register address
+	uint32_t		Len;		// bytes to read
+	uint32_t		PeriodUs;	// poll period, 0= every pass
+	uint64_t		Due;		// next start time, 0= now
+	uint32_t		Seq;		// completions
+	uint32_t		LateCnt;	// whole periods missed
+
+	Buf			BufV[2];	// double buffer
+	std::atomic<uint32_t>	Pub;		// index of newest BufV[]
+    };
+
+    struct Unit {
+	rgIic		*Iic;		// unit object
+	int32_t		Cur;		// job in flight, -1= idle
+	uint8_t		Rx[MaxLen];	// Rx buffer of job in flight
+    };
+
+    rgSysTimer		*Tmr;		// timestamp source
+
+    Job			JobV[MaxJob];
+    uint32_t		NumJob;		// number of JobV[] in use
+
+    Unit		UnitV[MaxUnit];
+    uint32_t		NumUnit;	// number of UnitV[] in use
+
+    std::atomic<bool>	StopReq;	// set by stop()
+
+    uint64_t		PassCnt;	// service passes
+    uint64_t		XferCnt;	// transactions completed
+    uint64_t		ErrCnt;		// transactions with Err
+
+  public:
+    rgIicSched(			// constructor
+	rgSysTimer	*stx
+    );
+
+    uint32_t		add_job(
+			    rgIic		*icx,
+			    uint32_t		addr,
+			    uint32_t		reg,
+			    uint32_t		len,
+			    uint32_t		period_us
+			);
+    void		clear();
+
+    uint32_t		service_all( uint64_t  now );
+    uint64_t		run( uint64_t  duration_us );
+    inline void		stop()    { StopReq.store( 1 ); }
+
+		// Reader side, any thread
+    bool		get_result( uint32_t  ii,  rgIicSched_Result&  rr );
+
+		// Statistics, index in order of add_job()
+    inline uint32_t	get_NumJob()     { return  NumJob; }
+    inline uint32_t	get_NumUnit()    { return  NumUnit; }
+    inline uint64_t	get_PassCnt()    { return  PassCnt; }
+    inline uint64_t	get_XferCnt()    { return  XferCnt; }
+    inline uint64_t	get_ErrCnt()     { return  ErrCnt; }
+    uint32_t		get_LateCnt( uint32_t  ii );
+
+  private:
+    uint32_t		service_pass( uint64_t  now,  bool  start );
+    void		publish( Job&  jj,  Unit&  uu,  uint64_t  now );
+    void		check_index( const char* fn,  uint32_t  ii );
+};
+
+#endif
+
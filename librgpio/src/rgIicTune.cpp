@@ -0,0 +1,376 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgIicTune - Per-device I2C clock tuning for rgIic
+//
+// See:  doc/iic_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+
+#include "rgIicTune.h"
+
+/*
+* Constructor.
+* call:
+*    rgIicTune		tn  ( &icx );
+*    &icx  = IIC unit object
+*/
+rgIicTune::rgIicTune(
+    rgIic		*icx
+)
+{
+    Iic       = icx;
+
+    DivStart  = 0;
+    DivMin    = 64;
+    StepPct   = 10;
+    MarginPct = 25;
+    Trials    = 4;
+
+    StepCnt   = 0;
+    FastDiv   = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Configuration
+//--------------------------------------------------------------------------
+
+/*
+* Configure starting divider, must be known good for the device.
+* call:
+*    self.config_DivStart( v )
+*    v  = ClkDiv_16 value {2..0xfffe}, 0= use current register value
+* exceptions:
+*    range_error  v not in range
+*/
+void
+rgIicTune::config_DivStart(
+    uint32_t		v
+)
+{
+    if ( (v == 1) || (v > 0xfffe) ) {
+	std::ostringstream	css;
+	css << "rgIicTune::config_DivStart():  requires {0, 2..0xfffe}:  0x"
+	    << hex << v;
+	throw std::range_error ( css.str() );
+    }
+
+    DivStart = v;
+}
+
+
+/*
+* Configure smallest divider tried (fastest clock).
+* call:
+*    self.config_DivMin( v )
+*    v  = ClkDiv_16 value {2..0xfffe}
+* exceptions:
+*    range_error  v not in range
+*/
+void
+rgIicTune::config_DivMin(
+    uint32_t		v
+)
+{
+    if ( (v < 2) || (v > 0xfffe) ) {
+	std::ostringstream	css;
+	css << "rgIicTune::config_DivMin():  requires {2..0xfffe}:  0x"
+	    << hex << v;
+	throw std::range_error ( css.str() );
+    }
+
+    DivMin = v;
+}
+
+
+/*
+* Configure divider decrease per step, in percent.
+* exceptions:
+*    range_error  v not in {1..50}
+*/
+void
+rgIicTune::config_StepPct(
+    uint32_t		v
+)
+{
+    if ( (v < 1) || (v > 50) ) {
+	std::ostringstream	css;
+	css << "rgIicTune::config_StepPct():  requires {1..50}:  " << v;
+	throw std::range_error ( css.str() );
+    }
+
+    StepPct = v;
+}
+
+
+/*
+* Configure divider back off from the fastest good step, in percent.
+* exceptions:
+*    range_error  v exceeds 100
+*/
+void
+rgIicTune::config_MarginPct(
+    uint32_t		v
+)
+{
+    if ( v > 100 ) {
+	std::ostringstream	css;
+	css << "rgIicTune::config_MarginPct():  requires {0..100}:  " << v;
+	throw std::range_error ( css.str() );
+    }
+
+    MarginPct = v;
+}
+
+
+/*
+* Configure reads per step.
+* exceptions:
+*    range_error  v is zero
+*/
+void
+rgIicTune::config_Trials(
+    uint32_t		v
+)
+{
+    if ( v == 0 ) {
+	throw std::range_error ( "rgIicTune::config_Trials():  require > 0" );
+    }
+
+    Trials = v;
+}
+
+
+//--------------------------------------------------------------------------
+// Tuning
+//--------------------------------------------------------------------------
+
+/*
+* Tune the clock for one device.
+*    Starting at DivStart, each step sets the timing registers for the
+*    divider and does Trials register reads.  The divider decreases by
+*    StepPct (at least 2) until a step fails or DivMin passes.  The
+*    fastest good divider is increased by MarginPct, rounded up to even,
+*    and not above DivStart.
+*    Hardware timing registers are restored on return.
+* call:
+*    self.tune( addr, reg, expect, len, pp )
+*    addr   = slave address {0..0x7f}
+*    reg    = register address byte {0..0xff}
+*    expect = known register value, len bytes {1..16}
+*    pp     = output profile, unchanged on error
+* return:
+*    ()  = 0 on success, else error of the first step (at DivStart):
+*          Stat error bits (AckErr_1, ClkTimeout_1), or DataMismatch
+*    get_StepCnt() = steps tried
+*    get_FastDiv() = fastest good divider, 0= none
+* exceptions:
+*    range_error  addr, reg, or len out of range
+*    range_error  DivStart below DivMin
+*/
+uint32_t
+rgIicTune::tune(
+    uint32_t		addr,
+    uint32_t		reg,
+    const uint8_t	*expect,
+    uint32_t		len,
+    rgIicTune_Profile&	pp
+)
+{
+    if ( addr > 0x7f ) {
+	std::ostringstream	css;
+	css << "rgIicTune::tune():  addr exceeds 0x7f:  0x" << hex << addr;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( reg > 0xff ) {
+	std::ostringstream	css;
+	css << "rgIicTune::tune():  reg exceeds 0xff:  0x" << hex << reg;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( (len == 0) || (len > rgIic::FifoDepth) ) {
+	std::ostringstream	css;
+	css << "rgIicTune::tune():  len requires {1..16}:  " << len;
+	throw std::range_error ( css.str() );
+    }
+
+    rgIicTune_Profile	save;
+
+    grab_profile( save );
+
+    uint32_t		div0 = DivStart;
+    if ( div0 == 0 ) {
+	div0 = ( save.ClkDiv ) ? save.ClkDiv : 0x8000;	// 0= 32768
+    }
+
+    if ( div0 < DivMin ) {
+	std::ostringstream	css;
+	css << "rgIicTune::tune():  DivStart below DivMin:  0x"
+	    << hex << div0;
+	throw std::range_error ( css.str() );
+    }
+
+    uint32_t		div  = div0;
+    uint32_t		err  = 0;
+    rgIicTune_Profile	tp;
+
+    StepCnt = 0;
+    FastDiv = 0;
+
+    while ( 1 ) {
+	calc_profile( div, div0, save.TimeOut, tp );
+	apply_profile( tp );
+
+	err = trial( addr, reg, expect, len );
+	StepCnt++;
+
+	if ( err ) {
+	    break;
+	}
+
+	FastDiv = div;
+
+	if ( div <= DivMin ) {
+	    break;
+	}
+
+	uint32_t	next = (div * (100 - StepPct) / 100) & ~0x1;
+	if ( next > div - 2 ) {
+	    next = div - 2;
+	}
+	if ( next < DivMin ) {
+	    next = DivMin;
+	}
+	div = next;
+    }
+
+    apply_profile( save );
+
+    if ( FastDiv == 0 ) {
+	return  err;
+    }
+
+    div = (FastDiv * (100 + MarginPct) + 99) / 100;
+    div = (div + 1) & ~0x1;
+    if ( div > div0 ) {
+	div = div0;
+    }
+
+    calc_profile( div, div0, save.TimeOut, pp );
+
+    return  0;
+}
+
+
+/*
+* Do Trials register reads and compare.
+* return:
+*    ()  = 0 if all passed, else Stat error bits or DataMismatch
+*/
+uint32_t
+rgIicTune::trial(
+    uint32_t		addr,
+    uint8_t		reg,
+    const uint8_t	*expect,
+    uint32_t		len
+)
+{
+    uint8_t		rbuf[rgIic::FifoDepth];
+
+    for ( uint32_t tt=0;  tt < Trials;  tt++ )
+    {
+	uint32_t	err = Iic->write_read( addr, &reg, 1, rbuf, len );
+	if ( err ) {
+	    return  err;
+	}
+
+	for ( uint32_t ii=0;  ii < len;  ii++ ) {
+	    if ( rbuf[ii] != expect[ii] ) {
+		return  DataMismatch;
+	    }
+	}
+    }
+
+    return  0;
+}
+
+
+//--------------------------------------------------------------------------
+// Profile
+//--------------------------------------------------------------------------
+
+/*
+* Compute profile for a divider.
+*    Clock stretch TimeOut_16 is in SCL cycles, so it is scaled to keep the
+*    same time as tout_ref at div_ref, limited to 0xffff.
+* call:
+*    self.calc_profile( div, div_ref, tout_ref, pp )
+*    div      = ClkDiv_16 value {2..0x8000}
+*    div_ref  = reference divider
+*    tout_ref = TimeOut_16 at div_ref
+*    pp       = output profile
+*/
+void
+rgIicTune::calc_profile(
+    uint32_t		div,
+    uint32_t		div_ref,
+    uint32_t		tout_ref,
+    rgIicTune_Profile&	pp
+)
+{
+    uint64_t		tout = (uint64_t)tout_ref * div_ref / div;
+
+    pp.ClkDiv   = div;
+    pp.Fall2Out = ( div >= 32 ) ? div / 16 : 1;
+    pp.Rise2In  = ( div >= 8 )  ? div / 4  : 1;
+    pp.TimeOut  = ( tout > 0xffff ) ? 0xffff : tout;
+}
+
+
+/*
+* Write profile to the hardware timing registers.
+*    Three register writes, e.g. before each device on a shared bus.
+*/
+void
+rgIicTune::apply_profile(
+    const rgIicTune_Profile&	pp
+)
+{
+    Iic->ClkDiv.write( pp.ClkDiv & 0xffff );
+    Iic->Delay.write( ((pp.Fall2Out & 0xffff) << 16) |
+		       (pp.Rise2In  & 0xffff) );
+    Iic->ClkStr.write( pp.TimeOut & 0xffff );
+}
+
+
+/*
+* Read profile from the hardware timing registers.
+*/
+void
+rgIicTune::grab_profile(
+    rgIicTune_Profile&	pp
+)
+{
+    Iic->ClkDiv.grab();
+    Iic->Delay.grab();
+    Iic->ClkStr.grab();
+
+    pp.ClkDiv   = Iic->ClkDiv.get_ClkDiv_16();
+    pp.Fall2Out = Iic->Delay.get_Fall2Out_16();
+    pp.Rise2In  = Iic->Delay.get_Rise2In_16();
+    pp.TimeOut  = Iic->ClkStr.get_TimeOut_16();
+}
+
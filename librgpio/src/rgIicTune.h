@@ -0,0 +1,104 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgIicTune_P
+#define rgIicTune_P
+
+#include "rgIic.h"
+
+//--------------------------------------------------------------------------
+// rgIicTune - Per-device I2C clock tuning for rgIic
+//--------------------------------------------------------------------------
+// Find the fastest reliable clock for one slave device by reading a known
+// register with write_read() at a decreasing clock divider, starting from
+// a known good one.  A step fails on AckErr_1, ClkTimeout_1, or a data
+// mismatch.  The fastest divider that passed is backed off by a margin and
+// returned as a profile of the timing registers, to be applied before
+// talking to that device on a shared bus.
+//
+//    ClkDiv_16     tuned divider (even)
+//    Fall2Out_16   max( ClkDiv_16 / 16, 1 )	as Linux i2c-bcm2835
+//    Rise2In_16    max( ClkDiv_16 / 4,  1 )
+//    TimeOut_16    scaled to the same time as at DivStart
+//
+// e.g.
+//    rgIicTune		tn  ( &iic );
+//    rgIicTune_Profile	pp;
+//    uint8_t		who = 0x68;
+//    if ( tn.tune( 0x68, 0x75, &who, 1, pp ) == 0 ) {	// WHO_AM_I
+//	tn.apply_profile( pp );
+//    }
+
+struct rgIicTune_Profile {
+    uint32_t		ClkDiv;		// ClkDiv_16
+    uint32_t		Fall2Out;	// Delay.Fall2Out_16
+    uint32_t		Rise2In;	// Delay.Rise2In_16
+    uint32_t		TimeOut;	// ClkStr.TimeOut_16
+};
+
+
+class rgIicTune {
+  private:
+    rgIic		*Iic;		// IIC unit
+
+    uint32_t		DivStart;	// known good divider, 0= current
+    uint32_t		DivMin;		// smallest divider tried
+    uint32_t		StepPct;	// divider decrease per step
+    uint32_t		MarginPct;	// divider increase on result
+    uint32_t		Trials;		// reads per step, all must pass
+
+    uint32_t		StepCnt;	// steps tried, last tune()
+    uint32_t		FastDiv;	// smallest good divider, last tune()
+
+  public:
+    static const uint32_t	DataMismatch = 0x80000000;	// tune() error
+
+  public:
+    rgIicTune( rgIic  *icx );		// constructor
+
+    void		config_DivStart( uint32_t  v );
+    inline uint32_t	config_DivStart()    { return  DivStart; }
+
+    void		config_DivMin( uint32_t  v );
+    inline uint32_t	config_DivMin()      { return  DivMin; }
+
+    void		config_StepPct( uint32_t  v );
+    inline uint32_t	config_StepPct()     { return  StepPct; }
+
+    void		config_MarginPct( uint32_t  v );
+    inline uint32_t	config_MarginPct()   { return  MarginPct; }
+
+    void		config_Trials( uint32_t  v );
+    inline uint32_t	config_Trials()      { return  Trials; }
+
+    uint32_t		tune(
+			    uint32_t		addr,
+			    uint32_t		reg,
+			    const uint8_t	*expect,
+			    uint32_t		len,
+			    rgIicTune_Profile&	pp
+			);
+
+    void		calc_profile(
+			    uint32_t		div,
+			    uint32_t		div_ref,
+			    uint32_t		tout_ref,
+			    rgIicTune_Profile&	pp
+			);
+
+    void		apply_profile( const rgIicTune_Profile&  pp );
+    void		grab_profile( rgIicTune_Profile&  pp );
+
+    inline uint32_t	get_StepCnt()   { return  StepCnt; }
+    inline uint32_t	get_FastDiv()   { return  FastDiv; }
+
+  private:
+    uint32_t		trial(
+			    uint32_t		addr,
+			    uint8_t		reg,
+			    const uint8_t	*expect,
+			    uint32_t		len
+			);
+};
+
+#endif
+
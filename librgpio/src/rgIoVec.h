@@ -0,0 +1,91 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgIoVec_P
+#define rgIoVec_P
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/uio.h>	// struct iovec
+
+//--------------------------------------------------------------------------
+// rgIoVec - Byte cursor over a scatter/gather list of segments
+//--------------------------------------------------------------------------
+// Lets a Fifo loop take Tx bytes from (or put Rx bytes into) several
+// buffers, e.g. header, payload and CRC, without copying them into one.
+// Segments are POSIX struct iovec, as for writev(2).
+//    iov_base = NULL:  Tx bytes are the fill byte, Rx bytes are discarded.
+//    iov_len  = 0:  skipped.
+// Past the end of the list, get() returns the fill byte and put() discards.
+// The list and buffers must remain valid while the cursor is in use.
+//
+// e.g.
+//    struct iovec	txv[3] = { {hdr, 2}, {data, n}, {crc, 2} };
+//    rgIoVec		cur;
+//    cur.init( txv, 3 );
+//    while ( ... ) { Fifo.write( cur.get( 0 ) ); }
+
+class rgIoVec {
+  private:
+    const struct iovec	*Seg;		// next segment
+    const struct iovec	*End;		// past last segment
+    uint8_t		*Ptr;		// next byte, NULL= fill/discard
+    size_t		Left;		// bytes left in current segment
+
+  public:
+    rgIoVec()  { init( NULL, 0 ); }
+
+		// Start at first byte of list, vec=NULL with num=0 is empty
+    inline void		init( const struct iovec  *vec,  uint32_t  num )
+    {
+	Seg  = vec;
+	End  = vec + num;
+	Ptr  = NULL;
+	Left = 0;
+	next_seg();
+    }
+
+		// Next Tx byte, fill for a NULL segment or past the end
+    inline uint8_t	get( uint8_t  fill )
+    {
+	uint8_t		vv = ( Ptr ) ? *Ptr++ : fill;
+	if ( --Left == 0 ) { next_seg(); }
+	return  vv;
+    }
+
+		// Next Rx byte, discarded for a NULL segment or past the end
+    inline void		put( uint8_t  vv )
+    {
+	if ( Ptr ) { *Ptr++ = vv; }
+	if ( --Left == 0 ) { next_seg(); }
+    }
+
+		// Total bytes in a segment list
+    static size_t	total( const struct iovec  *vec,  uint32_t  num )
+    {
+	size_t		nn = 0;
+	for ( uint32_t ii=0;  ii < num;  ii++ ) {
+	    nn += vec[ii].iov_len;
+	}
+	return  nn;
+    }
+
+  private:
+    inline void		next_seg()
+    {
+	while ( Seg < End ) {
+	    const struct iovec	*ss = Seg++;
+
+	    if ( ss->iov_len ) {
+		Ptr  = (uint8_t*) ss->iov_base;
+		Left = ss->iov_len;
+		return;
+	    }
+	}
+
+	Ptr  = NULL;			// past the end
+	Left = ~(size_t)0;
+    }
+};
+
+#endif
+
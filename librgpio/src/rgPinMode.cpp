@@ -0,0 +1,225 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgPinMode - Pin mode backends, selected once by SocEnum
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgFselPin.h"
+#include "rgsIoCon.h"
+#include "rgsRio.h"
+
+#include "rgPinMode.h"
+
+
+//--------------------------------------------------------------------------
+// rgPinMode_Bcm - RPi4 and earlier
+//--------------------------------------------------------------------------
+// Bulk path:  one read-modify-write per Fsel register (10 pins each).
+
+/*
+* Constructor.
+* call:
+*    rgPinMode_Bcm	px  ( &amx );
+* exceptions:
+*    domain_error from rgFselPin if not RPi4 or earlier
+*/
+rgPinMode_Bcm::rgPinMode_Bcm(
+    rgAddrMap		*xx
+)
+    : Fsel( xx )
+{
+}
+
+
+/*
+* Set pins to input mode.
+* call:
+*    mode_input( mask )
+*    mask = bit mask of Gpio[27:0]
+*/
+void
+rgPinMode_Bcm::mode_input( uint32_t mask )
+{
+    Fsel.modify_Fsel_w0( mask & PinMask, rgFselPin::f_In );
+}
+
+
+/*
+* Set pins to output mode.
+*    Output level is whatever the Set/Clr registers last left.
+*/
+void
+rgPinMode_Bcm::mode_output( uint32_t mask )
+{
+    Fsel.modify_Fsel_w0( mask & PinMask, rgFselPin::f_Out );
+}
+
+
+/*
+* Set pins to an alternate function.
+* call:
+*    mode_alt( mask, alt )
+*    mask = bit mask of Gpio[27:0]
+*    alt  = alternate function number {0..5}
+* exceptions:
+*    range_error if alt > MaxAlt
+*/
+void
+rgPinMode_Bcm::mode_alt(
+    uint32_t		mask,
+    uint32_t		alt
+)
+{
+    static const rgFselPin::rgFsel_enum		altmode[] = {
+	rgFselPin::f_Alt0,
+	rgFselPin::f_Alt1,
+	rgFselPin::f_Alt2,
+	rgFselPin::f_Alt3,
+	rgFselPin::f_Alt4,
+	rgFselPin::f_Alt5
+    };
+
+    if ( alt > MaxAlt ) {
+	std::ostringstream      css;
+	css << "rgPinMode_Bcm::mode_alt():  require alt {0..5}:  " << alt;
+	throw std::range_error ( css.str() );
+    }
+
+    Fsel.modify_Fsel_w0( mask & PinMask, altmode[alt] );
+}
+
+
+/*
+* Read pins in output mode.
+* return:
+*    () = bit mask of Gpio[27:0] in output mode
+*/
+uint32_t
+rgPinMode_Bcm::read_output()
+{
+    return  Fsel.read_Fsel_w0( rgFselPin::f_Out ) & PinMask;
+}
+
+
+//--------------------------------------------------------------------------
+// rgPinMode_Rp1 - RPi5
+//--------------------------------------------------------------------------
+// Input/output mode is FuncSel_5 = SYS_RIO, with direction in RioOutEn.
+// FuncSel:  one read_cntl() (shadow copy in shadow mode) and one full
+// write_cntl() per pin, so FuncSel goes directly from old to new value.
+// Separate set and clr writes would pass through the OR (or AND) of the
+// two, briefly selecting an unrelated function, e.g. 3 -> 7 -> 5.
+// RioOutEn:  one atomic write.
+// Pads (rgsIoPads) are not touched, their reset state enables the input
+// and output buffers.
+
+/*
+* Constructor.
+* call:
+*    rgPinMode_Rp1	px  ( &amx );
+* exceptions:
+*    domain_error from rgsIoCon if not RPi5
+*/
+rgPinMode_Rp1::rgPinMode_Rp1(
+    rgAddrMap		*xx
+)
+    : IoCon( xx ),
+      Rio(   xx )
+{
+}
+
+
+/*
+* Modify FuncSel_5 of pins in mask, one Cntl write per pin.
+*    Other Cntl fields are kept from read_cntl().
+*/
+void
+rgPinMode_Rp1::modify_funcsel(
+    uint32_t		mask,
+    uint32_t		func
+)
+{
+    mask &= PinMask;
+
+    for ( int ii=0;  mask;  ii++, mask >>= 1 )
+    {
+	if ( mask & 0x1 ) {
+	    IoCon.write_cntl( ii, (IoCon.read_cntl( ii ) & ~0x1f) | func );
+	}
+    }
+}
+
+
+/*
+* Set pins to input mode.
+*    Disable RIO output before switching function.
+* call:
+*    mode_input( mask )
+*    mask = bit mask of Gpio[27:0]
+*/
+void
+rgPinMode_Rp1::mode_input( uint32_t mask )
+{
+    Rio.RioOutEn.write_clr( mask & PinMask );
+    modify_funcsel( mask, FuncRio );
+}
+
+
+/*
+* Set pins to output mode.
+*    Output level is whatever RioOut last left.
+*/
+void
+rgPinMode_Rp1::mode_output( uint32_t mask )
+{
+    modify_funcsel( mask, FuncRio );
+    Rio.RioOutEn.write_set( mask & PinMask );
+}
+
+
+/*
+* Set pins to an alternate function.
+* call:
+*    mode_alt( mask, alt )
+*    mask = bit mask of Gpio[27:0]
+*    alt  = alternate function number {0..8}
+* exceptions:
+*    range_error if alt > MaxAlt
+*/
+void
+rgPinMode_Rp1::mode_alt(
+    uint32_t		mask,
+    uint32_t		alt
+)
+{
+    if ( alt > MaxAlt ) {
+	std::ostringstream      css;
+	css << "rgPinMode_Rp1::mode_alt():  require alt {0..8}:  " << alt;
+	throw std::range_error ( css.str() );
+    }
+
+    modify_funcsel( mask, alt );
+}
+
+
+/*
+* Read pins with RIO output enabled.
+*    Only meaningful for pins in RIO function (mode_input/mode_output).
+* return:
+*    () = bit mask of Gpio[27:0] with RioOutEn set
+*/
+uint32_t
+rgPinMode_Rp1::read_output()
+{
+    return  Rio.RioOutEn.read() & PinMask;
+}
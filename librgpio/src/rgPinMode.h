@@ -0,0 +1,104 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgPinMode_P
+#define rgPinMode_P
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgFselPin.h"
+#include "rgsIoCon.h"
+#include "rgsRio.h"
+
+//--------------------------------------------------------------------------
+// rgPinMode - Pin mode backends, selected once by SocEnum
+//--------------------------------------------------------------------------
+// Each backend has the same member function names, but no common base
+// class.  User code is written once as a functor with a template
+// operator(), and rgPinMode_dispatch() calls it with the backend for the
+// running platform.  Each instantiation calls its backend directly.
+//
+// Pins are a bit mask of Gpio[27:0], the 40-pin header pins on all models.
+// Alternate function numbers are NOT portable, see rgAltFuncName and
+// rgsFuncName for the meaning on each platform.
+//
+// e.g.
+//    struct setup_iic1 {		// Gpio[3:2] I2C1, Gpio[4] output
+//	template <class Pm>  void operator()( Pm& px ) {
+//	    px.mode_alt(    0x0000000c, (Pm::is_rp1 ? 3 : 0) );
+//	    px.mode_output( 0x00000010 );
+//	}
+//    };
+//    setup_iic1		fn;
+//    rgPinMode_dispatch( &amx, fn );
+
+class rgPinMode_Bcm {			// RPi4 and earlier
+  public:
+    static const uint32_t	PinMask = 0x0fffffff;
+    static const uint32_t	MaxAlt  = 5;
+    static const bool		is_rp1  = 0;
+
+    rgFselPin		Fsel;		// backend feature
+
+  public:
+    rgPinMode_Bcm( rgAddrMap  *xx );	// constructor
+
+    void		mode_input(  uint32_t mask );
+    void		mode_output( uint32_t mask );
+    void		mode_alt(    uint32_t mask,  uint32_t alt );
+
+    uint32_t		read_output();
+};
+
+
+class rgPinMode_Rp1 {			// RPi5, Bank0
+  public:
+    static const uint32_t	PinMask = 0x0fffffff;
+    static const uint32_t	MaxAlt  = 8;
+    static const bool		is_rp1  = 1;
+
+    static const uint32_t	FuncRio = 5;	// FuncSel_5 for SYS_RIO
+
+    rgsIoCon		IoCon;		// backend features
+    rgsRio		Rio;
+
+  public:
+    rgPinMode_Rp1( rgAddrMap  *xx );	// constructor
+
+    void		mode_input(  uint32_t mask );
+    void		mode_output( uint32_t mask );
+    void		mode_alt(    uint32_t mask,  uint32_t alt );
+
+    uint32_t		read_output();
+
+  private:
+    void		modify_funcsel( uint32_t mask,  uint32_t func );
+};
+
+
+/*
+* Call functor with the pin mode backend of the running platform.
+*    Backend object is constructed on each call, so hold it in the functor
+*    call for repeated use on hot paths.
+* call:
+*    rgPinMode_dispatch( &amx, fn )
+*    &amx = pointer to address map object with open device file
+*    fn   = functor with:  template <class Pm>  void operator()( Pm& px )
+*/
+template <class Func>
+void
+rgPinMode_dispatch(
+    rgAddrMap		*xx,
+    Func&		fn
+)
+{
+    if ( rgRpiRev::Global.SocEnum.find() == rgRpiRev::soc_BCM2712 ) {
+	rgPinMode_Rp1		px  ( xx );
+	fn( px );
+    }
+    else {
+	rgPinMode_Bcm		px  ( xx );
+	fn( px );
+    }
+}
+
+#endif
@@ -116,6 +116,43 @@ rgPwm::push_regs()
 }
 
 
+//--------------------------------------------------------------------------
+// Fifo writer pass
+//--------------------------------------------------------------------------
+// Shared by the CPU Fifo writers (rgPwmStream, rgPwmSerial).  The Fifo fill
+// level is not visible, only the Empty/Full flags.
+
+/*
+* Read Stat once for the Fifo room, and clear any error flags seen.
+*    Error flags are cleared by writing back the value read.  The Stat
+*    object cache is not changed.
+* call:
+*    self.fifo_room( gap )
+* return:
+*    ()  = words that can be written:  FifoEmpty_1=1 FifoDepth,
+*	   else FifoFull_1=0 one, else zero
+*    gap = GapErr_1 seen on Ch1 or Ch2, Fifo ran dry while in use
+*/
+uint32_t
+rgPwm::fifo_room(
+    bool&		gap
+)
+{
+    rgPwm_Stat		sx;
+
+    sx.put( Stat.read() );			// one status read
+
+    gap = sx.get_Ch1_GapErr_1() || sx.get_Ch2_GapErr_1();
+
+    if ( gap || sx.get_FifoReadErr_1() || sx.get_FifoWriteErr_1() ) {
+	Stat.write( sx.get() );			// clear flags seen
+    }
+
+    return  sx.get_FifoEmpty_1() ? FifoDepth :
+	    sx.get_FifoFull_1()  ? 0 : 1;
+}
+
+
 //--------------------------------------------------------------------------
 // Debug
 //--------------------------------------------------------------------------
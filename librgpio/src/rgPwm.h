@@ -175,6 +175,9 @@ class rgPwm {
     static const uint32_t	Ch2Range_offset = 0x20 /4;
     static const uint32_t	Ch2Data_offset  = 0x24 /4;
 
+  public:
+    static const uint32_t	FifoDepth    = 8;		// words
+
   public:
     rgPwm(			// constructor
 	rgAddrMap	*xx
@@ -183,6 +186,9 @@ class rgPwm {
     inline
     volatile uint32_t*	get_base_addr()  { return  GpioBase; }
 
+		// Fifo writer pass
+    uint32_t		fifo_room( bool&  gap );
+
 		// Object state operations
     void		init_put_reset();
 
@@ -0,0 +1,286 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgPwmDuty - Coherent PWM duty update for control loops
+//
+// See:  doc/pwm_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgPwm.h"
+#include "rgIoPins.h"
+#include "rgSysTimer.h"
+
+#include "rgPwmDuty.h"
+
+
+/*
+* Write a register only if the value changed.
+*/
+static inline void
+put_changed(
+    rgRegister		&reg,
+    uint32_t		&cache,
+    uint32_t		vv,
+    uint64_t		&cnt
+)
+{
+    if ( vv != cache ) {
+	reg.write( vv );
+	cache = vv;
+	cnt++;
+    }
+}
+
+
+/*
+* Constructor.
+*    No period sync, no latency measure.  Cache is zero until grab().
+* call:
+*    rgPwmDuty	pdx  ( &pwx );
+*    &pwx  = PWM object
+*/
+rgPwmDuty::rgPwmDuty(
+    rgPwm		*pwx
+)
+{
+    Pwm         = pwx;
+    Iox         = NULL;
+    PinMask     = 0;
+    Tmr         = NULL;
+    MaxPoll     = 1000000;
+
+    Ch1D        = 0;
+    Ch2D        = 0;
+    Ch1R        = 0;
+    Ch2R        = 0;
+
+    LastLatency = 0;
+    MaxLatency  = 0;
+
+    UpdateCnt   = 0;
+    WriteCnt    = 0;
+    SyncMissCnt = 0;
+}
+
+
+/*
+* Cache Data and Range from the registers.
+*    Call before the first update(), and after anything else writes them.
+*/
+void
+rgPwmDuty::grab()
+{
+    Ch1D = Pwm->Ch1Data.read();
+    Ch2D = Pwm->Ch2Data.read();
+    Ch1R = Pwm->Ch1Range.read();
+    Ch2R = Pwm->Ch2Range.read();
+}
+
+
+//--------------------------------------------------------------------------
+// Configuration
+//--------------------------------------------------------------------------
+
+/*
+* Configure period sync on the PWM output pin.
+*    Channel must be in M/S mode (Ch*_MsEnable_1=1), not inverted, so a
+*    rising edge is the start of a period.
+* call:
+*    self.config_PinSync( &iox, pin )
+*    &iox = IO pins object
+*    pin  = GPIO bit number of the PWM output {0..31}
+* exceptions:
+*    range_error  pin out of range
+*/
+void
+rgPwmDuty::config_PinSync(
+    rgIoPins		*iox,
+    uint32_t		pin
+)
+{
+    if ( pin > 31 ) {
+	std::ostringstream	css;
+	css << "rgPwmDuty::config_PinSync():  pin requires {0..31}:  " << pin;
+	throw std::range_error ( css.str() );
+    }
+
+    Iox     = iox;
+    PinMask = 1 << pin;
+}
+
+
+/*
+* Configure no period sync, write immediately.
+*/
+void
+rgPwmDuty::config_NoSync()
+{
+    Iox     = NULL;
+    PinMask = 0;
+}
+
+
+/*
+* Configure latency measure, and reset latency values.
+*    Requires pin sync to see the effect;  each update() then waits one
+*    more period.  Intended for characterizing a loop, not in production.
+* call:
+*    self.config_Measure( &stx )
+*    &stx = System Timer object, NULL= no measure
+*/
+void
+rgPwmDuty::config_Measure(
+    rgSysTimer		*stx
+)
+{
+    Tmr         = stx;
+    LastLatency = 0;
+    MaxLatency  = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Update
+//--------------------------------------------------------------------------
+
+/*
+* Update both channel Data values.
+*    With pin sync, wait for a period start first.  Then write only the
+*    changed registers, Ch1 then Ch2, with nothing in between.
+* call:
+*    self.update( d1, d2 )
+*    d1 = Ch1Data
+*    d2 = Ch2Data
+*/
+void
+rgPwmDuty::update(
+    uint32_t		d1,
+    uint32_t		d2
+)
+{
+    uint32_t		t0 = ( Tmr ) ? Tmr->TimeW0.read() : 0;
+
+    UpdateCnt++;
+
+    if ( Iox ) {
+	wait_period();
+    }
+
+    put_changed( Pwm->Ch1Data, Ch1D, d1, WriteCnt );
+    put_changed( Pwm->Ch2Data, Ch2D, d2, WriteCnt );
+
+    if ( Tmr && Iox ) {
+	measure( t0 );
+    }
+}
+
+
+/*
+* Update both channel Range and Data values.
+*    Ordered so Data never exceeds Range between writes:
+*    a shrinking Range writes Data first, a growing Range writes it last.
+*    The first writes of both channels go before the second writes.
+* call:
+*    self.update_range( r1, d1, r2, d2 )
+*    r1 = Ch1Range,  d1 = Ch1Data
+*    r2 = Ch2Range,  d2 = Ch2Data
+*/
+void
+rgPwmDuty::update_range(
+    uint32_t		r1,
+    uint32_t		d1,
+    uint32_t		r2,
+    uint32_t		d2
+)
+{
+    uint32_t		t0  = ( Tmr ) ? Tmr->TimeW0.read() : 0;
+    bool		dn1 = ( r1 < Ch1R );
+    bool		dn2 = ( r2 < Ch2R );
+
+    UpdateCnt++;
+
+    if ( Iox ) {
+	wait_period();
+    }
+
+    if ( dn1 ) { put_changed( Pwm->Ch1Data,  Ch1D, d1, WriteCnt ); }
+    else       { put_changed( Pwm->Ch1Range, Ch1R, r1, WriteCnt ); }
+
+    if ( dn2 ) { put_changed( Pwm->Ch2Data,  Ch2D, d2, WriteCnt ); }
+    else       { put_changed( Pwm->Ch2Range, Ch2R, r2, WriteCnt ); }
+
+    if ( dn1 ) { put_changed( Pwm->Ch1Range, Ch1R, r1, WriteCnt ); }
+    else       { put_changed( Pwm->Ch1Data,  Ch1D, d1, WriteCnt ); }
+
+    if ( dn2 ) { put_changed( Pwm->Ch2Range, Ch2R, r2, WriteCnt ); }
+    else       { put_changed( Pwm->Ch2Data,  Ch2D, d2, WriteCnt ); }
+
+    if ( Tmr && Iox ) {
+	measure( t0 );
+    }
+}
+
+
+//--------------------------------------------------------------------------
+// Private
+//--------------------------------------------------------------------------
+
+/*
+* Wait for a period start, rising edge of the PWM output pin.
+*    Waits for low, then high, limited to MaxPoll pin reads in total.
+*    A miss (e.g. channel not running, Data=0) is counted in SyncMissCnt.
+* return:
+*    ()  = true if edge seen, false if MaxPoll reached
+*/
+bool
+rgPwmDuty::wait_period()
+{
+    uint32_t		nn = MaxPoll;
+
+    while ( nn && (Iox->PinRead_w0.read() & PinMask) ) {	// high
+	nn--;
+    }
+
+    while ( nn && !(Iox->PinRead_w0.read() & PinMask) ) {	// low
+	nn--;
+    }
+
+    if ( nn == 0 ) {
+	SyncMissCnt++;
+	return  false;
+    }
+
+    return  true;
+}
+
+
+/*
+* Measure latency from t0 to the next period start.
+*    The new values are in effect from that period.
+*/
+void
+rgPwmDuty::measure(
+    uint32_t		t0
+)
+{
+    if ( ! wait_period() ) {
+	return;
+    }
+
+    LastLatency = Tmr->TimeW0.read() - t0;	// wrap-safe
+
+    if ( LastLatency > MaxLatency ) {
+	MaxLatency = LastLatency;
+    }
+}
+
@@ -0,0 +1,89 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgPwmDuty_P
+#define rgPwmDuty_P
+
+#include "rgPwm.h"
+#include "rgIoPins.h"
+#include "rgSysTimer.h"
+
+//--------------------------------------------------------------------------
+// rgPwmDuty - Coherent PWM duty update for control loops
+//--------------------------------------------------------------------------
+// Updates Ch1Data, Ch2Data (and optionally Range) with the fewest register
+// writes:  values are cached, unchanged registers are not written, and
+// a Range change is ordered so Data never exceeds Range in between.
+// Both channels are written back-to-back, no read-modify-write.
+//
+// Period sync (optional) waits for the start of a period, seen as a rising
+// edge of the PWM output pin in M/S mode, so both channels are written
+// early in the same period.  Stat Ch*_Active_1 only shows a channel is
+// transmitting, and does not mark the period boundary.
+//
+// Latency measure (optional, needs pin sync and System Timer) times from
+// update() entry to the next period start, when the new values are in
+// effect.
+//
+// e.g.
+//    rgPwmDuty		pdx  ( &pwx );
+//    pdx.grab();				// cache current registers
+//    pdx.config_PinSync( &iox, 18 );		// GPIO18 is PWM0 Ch1
+//    pdx.update( d1, d2 );
+
+class rgPwmDuty {
+  private:
+    rgPwm		*Pwm;		// PWM unit
+    rgIoPins		*Iox;		// pin sync, or NULL
+    uint32_t		PinMask;	// PinRead_w0 bit of PWM output
+    rgSysTimer		*Tmr;		// latency measure, or NULL
+    uint32_t		MaxPoll;	// limit pin reads per edge wait
+
+					// last written values
+    uint32_t		Ch1D;
+    uint32_t		Ch2D;
+    uint32_t		Ch1R;
+    uint32_t		Ch2R;
+
+    uint32_t		LastLatency;	// microseconds, 0= none
+    uint32_t		MaxLatency;	// microseconds
+
+    uint64_t		UpdateCnt;	// update calls
+    uint64_t		WriteCnt;	// register writes
+    uint64_t		SyncMissCnt;	// edge waits that hit MaxPoll
+
+  public:
+    rgPwmDuty(			// constructor
+	rgPwm		*pwx
+    );
+
+    void		grab();		// cache from registers
+
+    void		config_PinSync( rgIoPins  *iox,  uint32_t  pin );
+    void		config_NoSync();
+    void		config_Measure( rgSysTimer  *stx );
+
+    inline void		config_MaxPoll( uint32_t  n )	{ MaxPoll = n; }
+
+    void		update( uint32_t  d1,  uint32_t  d2 );
+
+    void		update_range(
+			    uint32_t		r1,
+			    uint32_t		d1,
+			    uint32_t		r2,
+			    uint32_t		d2
+			);
+
+    inline uint32_t	get_LastLatency_us()	{ return  LastLatency; }
+    inline uint32_t	get_MaxLatency_us()	{ return  MaxLatency; }
+
+    inline uint64_t	get_UpdateCnt()		{ return  UpdateCnt; }
+    inline uint64_t	get_WriteCnt()		{ return  WriteCnt; }
+    inline uint64_t	get_SyncMissCnt()	{ return  SyncMissCnt; }
+
+  private:
+    bool		wait_period();
+    void		measure( uint32_t  t0 );
+};
+
+#endif
+
@@ -0,0 +1,295 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgPwmSerial - PWM serializer bitstream encoder and Fifo writer
+//
+// See:  doc/pwm_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgPwm.h"
+
+#include "rgPwmSerial.h"
+
+
+/*
+* Constructor.
+*    Symbols default to WS2812, clock divisor is not calculated.
+* call:
+*    rgPwmSerial	psx  ( &pwx );
+*    &pwx  = PWM object
+*/
+rgPwmSerial::rgPwmSerial(
+    rgPwm		*pwx
+)
+{
+    Pwm       = pwx;
+
+    DivI      = 0;
+    DivF      = 0;
+
+    WordCnt   = 0;
+    GapCnt    = 0;
+    PollCnt   = 0;
+
+    config_Ws2812();
+}
+
+
+//--------------------------------------------------------------------------
+// Encoding
+//--------------------------------------------------------------------------
+
+/*
+* Configure symbols and build the byte expansion table.
+*    Symbols are line bits sent MSB first, right justified in nsym bits.
+* call:
+*    self.config_Symbols( sym0, sym1, nsym )
+*    sym0 = symbol for data bit 0
+*    sym1 = symbol for data bit 1
+*    nsym = line bits per data bit {1..4}
+* exceptions:
+*    range_error  nsym out of range, symbol wider than nsym bits
+*/
+void
+rgPwmSerial::config_Symbols(
+    uint32_t		sym0,
+    uint32_t		sym1,
+    uint32_t		nsym
+)
+{
+    if ( (nsym < 1) || (nsym > 4) ) {
+	std::ostringstream	css;
+	css << "rgPwmSerial::config_Symbols():  nsym range {1..4}:  " << nsym;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( (sym0 >> nsym) || (sym1 >> nsym) ) {
+	std::ostringstream	css;
+	css << "rgPwmSerial::config_Symbols():  symbol exceeds nsym bits:  0x"
+	    << hex << ( (sym0 >> nsym) ? sym0 : sym1 );
+	throw std::range_error ( css.str() );
+    }
+
+    Nsym = nsym;
+    Sym0 = sym0;
+    Sym1 = sym1;
+
+    for ( uint32_t bb=0;  bb < 256;  bb++ )
+    {
+	uint32_t	vv = 0;
+
+	for ( int ii=7;  ii >= 0;  ii-- ) {
+	    vv = (vv << nsym) | ( ((bb >> ii) & 0x1) ? sym1 : sym0 );
+	}
+
+	Tab[bb] = vv;
+    }
+}
+
+
+/*
+* Configure WS2812 symbols:  0= 100, 1= 110, 3 line bits per data bit.
+*    Use with a 1250 ns bit period (2.4 MHz line clock).
+*/
+void
+rgPwmSerial::config_Ws2812()
+{
+    config_Symbols( 0x4, 0x6, 3 );
+}
+
+
+/*
+* Number of Fifo words to encode nbyte with nsym line bits per data bit.
+*/
+uint32_t
+rgPwmSerial::words_needed(
+    uint32_t		nbyte,
+    uint32_t		nsym
+)
+{
+    uint64_t		nbit = (uint64_t) nbyte * 8 * nsym;
+
+    return  (nbit + WordBits - 1) / WordBits;
+}
+
+
+/*
+* Encode bytes into Fifo words.
+*    Each byte is 8*Nsym line bits from the table, MSB first, packed into
+*    32-bit words MSB first.  The last word is padded with zero bits.
+* call:
+*    self.encode( src, nbyte, dst, nword )
+*    src   = data bytes, sent MSB first
+*    nbyte = number of bytes
+*    dst   = output words
+*    nword = size of dst, at least words_needed()
+* return:
+*    ()  = number of words encoded
+* exceptions:
+*    range_error  dst too small
+*/
+uint32_t
+rgPwmSerial::encode(
+    const uint8_t	*src,
+    uint32_t		nbyte,
+    uint32_t		*dst,
+    uint32_t		nword
+)
+{
+    uint32_t		need = words_needed( nbyte, Nsym );
+
+    if ( nword < need ) {
+	std::ostringstream	css;
+	css << "rgPwmSerial::encode():  dst requires " << need
+	    << " words:  " << nword;
+	throw std::range_error ( css.str() );
+    }
+
+    uint32_t		bpb  = 8 * Nsym;	// line bits per byte, <= 32
+    uint64_t		acc  = 0;		// pending bits, low nb valid
+    uint32_t		nb   = 0;		// pending bit count, < 32
+    uint32_t		kk   = 0;
+
+    for ( uint32_t ii=0;  ii < nbyte;  ii++ )
+    {
+	acc = (acc << bpb) | Tab[src[ii]];
+	nb += bpb;
+
+	if ( nb >= WordBits ) {
+	    nb -= WordBits;
+	    dst[kk++] = acc >> nb;
+	}
+    }
+
+    if ( nb ) {
+	dst[kk++] = acc << (WordBits - nb);
+    }
+
+    return  kk;
+}
+
+
+//--------------------------------------------------------------------------
+// Timing
+//--------------------------------------------------------------------------
+
+/*
+* Calculate clock divisor for a data bit period.
+*    Line clock is Nsym / bit_ns, one line bit per PWM clock.  The divisor
+*    is rounded to 1/4096;  DivF=0 is exact with MASH 0 (integer).
+*    Ch1Range is get_Range(), the full 32-bit word.
+* call:
+*    self.calc_clock( src_hz, bit_ns )
+*    src_hz = clock source frequency, Hz
+*    bit_ns = data bit period, ns
+* exceptions:
+*    range_error  divisor out of range {2..4095}
+*/
+void
+rgPwmSerial::calc_clock(
+    uint32_t		src_hz,
+    uint32_t		bit_ns
+)
+{
+    uint64_t		den  = (uint64_t) Nsym * 1000000000;
+    uint64_t		dd   = ((uint64_t) src_hz * bit_ns * 4096 + den / 2)
+				/ den;		// divisor * 4096
+    uint64_t		di   = dd >> 12;
+
+    if ( (di < 2) || (di > 4095) ) {
+	std::ostringstream	css;
+	css << "rgPwmSerial::calc_clock():  divisor out of range {2..4095}:  "
+	    << di;
+	throw std::range_error ( css.str() );
+    }
+
+    DivI = di;
+    DivF = dd & 0xfff;
+}
+
+
+//--------------------------------------------------------------------------
+// Fifo writer
+//--------------------------------------------------------------------------
+
+/*
+* Write words to the Fifo, blocking until all are written.
+*    Polls Stat once per pass with rgPwm::fifo_room():  FifoEmpty_1=1
+*    writes up to FifoDepth words, else FifoFull_1=0 writes one word.
+*    Error flags seen are cleared, and GapErr_1 is counted in GapCnt.
+* call:
+*    self.write( src, nword )
+*/
+void
+rgPwmSerial::write(
+    const uint32_t	*src,
+    uint32_t		nword
+)
+{
+    uint32_t		ii = 0;
+
+    while ( ii < nword )
+    {
+	bool		gap;
+	uint32_t	room = Pwm->fifo_room( gap );
+	PollCnt++;
+
+	if ( gap ) {
+	    GapCnt++;
+	}
+
+	if ( room > nword - ii ) {
+	    room = nword - ii;
+	}
+
+	for ( ;  room;  room-- ) {
+	    Pwm->Fifo.write( src[ii++] );
+	}
+    }
+
+    WordCnt += nword;
+}
+
+
+/*
+* Encode and send bytes, one block at a time, blocking.
+*    A block of BlockSize bytes is a whole number of words for any Nsym,
+*    so blocks encode independently.  Error flags left from the previous
+*    frame (e.g. GapErr_1 of the latch idle) are cleared, not counted.
+*    Leave IdleBit_1 time after return for a latch.
+* call:
+*    self.send( src, nbyte )
+*/
+void
+rgPwmSerial::send(
+    const uint8_t	*src,
+    uint32_t		nbyte
+)
+{
+    bool		gap;
+
+    Pwm->fifo_room( gap );			// clear stale flags
+    PollCnt++;
+
+    while ( nbyte )
+    {
+	uint32_t	nb = ( nbyte < BlockSize ) ? nbyte : BlockSize;
+	uint32_t	nw = encode( src, nb, Word, BlockSize );
+
+	write( Word, nw );
+
+	src   += nb;
+	nbyte -= nb;
+    }
+}
+
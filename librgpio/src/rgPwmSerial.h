@@ -0,0 +1,93 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgPwmSerial_P
+#define rgPwmSerial_P
+
+#include "rgPwm.h"
+
+//--------------------------------------------------------------------------
+// rgPwmSerial - PWM serializer bitstream encoder and Fifo writer
+//--------------------------------------------------------------------------
+// In serializer mode (Ch1_SerMode_1=1, Ch1_UseFifo_1=1) the PWM shifts out
+// each 32-bit Fifo word MSB first, one bit per PWM clock, with Ch1Range=32.
+// Each data bit is expanded to a symbol of nsym line bits, e.g. WS2812
+// uses 3 bits per data bit:  0= 100, 1= 110 at 2.4 MHz (1.25 us per bit).
+// Expansion is by a 256-entry table of byte symbols, packed into words.
+// When the Fifo runs dry the line rests at IdleBit_1, which for WS2812
+// (IdleBit_1=0) is also the reset/latch once held long enough.
+//
+// e.g.
+//    rgPwmSerial	psx  ( &pwx );
+//    psx.config_Ws2812();
+//    psx.calc_clock( 19200000, 1250 );	// 19.2 MHz oscillator
+//    ... clock Divr from get_DivI(), get_DivF();  Ch1Range= get_Range()
+//    psx.send( grb, 3 * nled );
+
+class rgPwmSerial {
+  public:
+    static const uint32_t	FifoDepth = rgPwm::FifoDepth;	// words
+    static const uint32_t	WordBits  = 32;		// bits per Fifo word
+    static const uint32_t	BlockSize = 32;		// bytes per encode in send()
+
+  private:
+    rgPwm		*Pwm;		// PWM unit
+
+    uint32_t		Nsym;		// line bits per data bit {1..4}
+    uint32_t		Sym0;		// symbol for data bit 0
+    uint32_t		Sym1;		// symbol for data bit 1
+    uint32_t		Tab[256];	// byte to 8*Nsym line bits
+
+    uint32_t		DivI;		// clock integer divisor
+    uint32_t		DivF;		// clock fractional divisor, /4096
+
+    uint32_t		Word[BlockSize];	// encoded block in send()
+
+    uint64_t		WordCnt;	// words written to Fifo
+    uint64_t		GapCnt;		// GapErr_1 seen, underruns
+    uint64_t		PollCnt;	// Stat reads
+
+  public:
+    rgPwmSerial(		// constructor
+	rgPwm		*pwx
+    );
+
+		// Encoding
+
+    void		config_Symbols(
+			    uint32_t		sym0,
+			    uint32_t		sym1,
+			    uint32_t		nsym
+			);
+
+    void		config_Ws2812();
+
+    static uint32_t	words_needed( uint32_t  nbyte,  uint32_t  nsym );
+
+    uint32_t		encode(
+			    const uint8_t	*src,
+			    uint32_t		nbyte,
+			    uint32_t		*dst,
+			    uint32_t		nword
+			);
+
+		// Timing
+
+    void		calc_clock( uint32_t  src_hz,  uint32_t  bit_ns );
+
+    inline uint32_t	get_DivI()       { return  DivI; }
+    inline uint32_t	get_DivF()       { return  DivF; }
+    inline uint32_t	get_Range()      { return  WordBits; }
+
+		// Fifo writer
+
+    void		write( const uint32_t  *src,  uint32_t  nword );
+    void		send(  const uint8_t   *src,  uint32_t  nbyte );
+
+    inline uint32_t	get_Nsym()       { return  Nsym; }
+    inline uint64_t	get_WordCnt()    { return  WordCnt; }
+    inline uint64_t	get_GapCnt()     { return  GapCnt; }
+    inline uint64_t	get_PollCnt()    { return  PollCnt; }
+};
+
+#endif
+
@@ -0,0 +1,274 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgPwmSolve - PWM clock and Range solver for a target frequency
+//
+// See:  doc/pwm_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgClk.h"
+#include "rgPwm.h"
+
+#include "rgPwmSolve.h"
+
+
+/*
+* Constructor.
+*    Sources default to the fixed clocks of the SoC:
+*        RPi4:     Source_4=1  54 MHz oscillator,   Source_4=6  750 MHz PLLD
+*        earlier:  Source_4=1  19.2 MHz oscillator, Source_4=6  500 MHz PLLD
+*    PLLC is not included, as it changes with overclock settings.
+*    MaxClkHz defaults to 125 MHz.  Fractional divisor is allowed.
+* call:
+*    rgPwmSolve	slv;
+*/
+rgPwmSolve::rgPwmSolve()
+{
+    NumSrc    = 0;
+    MaxClkHz  = 125000000;
+    AllowFrac = 1;
+
+    Source    = 0;
+    DivI      = 0;
+    DivF      = 0;
+    Range     = 0;
+    Freq      = 0;
+    ErrPpb    = 0;
+
+    if ( rgRpiRev::Global.SocEnum.find() == rgRpiRev::soc_BCM2711 ) {
+	add_Source( 1,  54000000 );
+	add_Source( 6, 750000000 );
+    }
+    else {
+	add_Source( 1,  19200000 );
+	add_Source( 6, 500000000 );
+    }
+}
+
+
+//--------------------------------------------------------------------------
+// Configuration
+//--------------------------------------------------------------------------
+
+/*
+* Remove all clock sources.
+*/
+void
+rgPwmSolve::clear_Sources()
+{
+    NumSrc = 0;
+}
+
+
+/*
+* Add a clock source to search, in order of preference.
+* call:
+*    self.add_Source( src, hz )
+*    src = Source_4 value {0..15}
+*    hz  = source frequency, Hz, nonzero
+* exceptions:
+*    range_error  src out of range, hz is zero, too many sources
+*/
+void
+rgPwmSolve::add_Source(
+    uint32_t		src,
+    uint32_t		hz
+)
+{
+    if ( src > 15 ) {
+	std::ostringstream	css;
+	css << "rgPwmSolve::add_Source():  src requires {0..15}:  " << src;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( hz == 0 ) {
+	throw std::range_error ( "rgPwmSolve::add_Source():  hz is zero" );
+    }
+
+    if ( NumSrc >= MaxSrc ) {
+	std::ostringstream	css;
+	css << "rgPwmSolve::add_Source():  exceeds MaxSrc:  " << MaxSrc;
+	throw std::range_error ( css.str() );
+    }
+
+    SrcNum[NumSrc] = src;
+    SrcHz[NumSrc]  = hz;
+    NumSrc++;
+}
+
+
+//--------------------------------------------------------------------------
+// Solver
+//--------------------------------------------------------------------------
+
+/*
+* Solve for the clock source, divisor and Range closest to a frequency.
+*    For each source and each DivI {2..4095} with PWM clock <= MaxClkHz:
+*      integer:     Range = round( Fsrc / (freq * DivI) )
+*      fractional:  Range = floor( Fsrc / (freq * DivI) ),  then the
+*                   DivI.DivF nearest to Fsrc / (freq * Range)
+*    Candidates with Range < min_range are skipped.  The least relative
+*    error wins;  ties prefer integer divisor, then larger Range, then
+*    the earlier source and smaller DivI.
+* call:
+*    self.solve( freq_hz, min_range )
+*    freq_hz   = target PWM frequency, Hz
+*    min_range = minimum Range, duty resolution steps, 0 is 1
+* return:
+*    ()  = true if found, results in get_*()
+* exceptions:
+*    range_error  freq_hz is zero
+*/
+bool
+rgPwmSolve::solve(
+    uint32_t		freq_hz,
+    uint32_t		min_range
+)
+{
+    if ( freq_hz == 0 ) {
+	throw std::range_error ( "rgPwmSolve::solve():  freq_hz is zero" );
+    }
+
+    if ( min_range == 0 ) {
+	min_range = 1;
+    }
+
+    bool		found    = 0;
+    double		best_err = 0;
+
+    Source = 0;
+    DivI   = 0;
+    DivF   = 0;
+    Range  = 0;
+    Freq   = 0;
+    ErrPpb = 0;
+
+    for ( uint32_t ss=0;  ss < NumSrc;  ss++ )
+    {
+	double		hz = SrcHz[ss];
+	double		pp = hz / freq_hz;		// Div * Range
+
+	for ( uint32_t di=2;  di <= 4095;  di++ )
+	{
+	    if ( hz / di > MaxClkHz ) {
+		continue;
+	    }
+
+	    double	rq = pp / di;			// exact Range
+
+	    for ( int frac=0;  frac <= 1;  frac++ )
+	    {
+		uint64_t	rr;
+		uint32_t	fi = di;
+		uint32_t	ff = 0;
+
+		if ( frac ) {
+		    if ( ! AllowFrac ) {
+			break;
+		    }
+		    rr = (uint64_t) rq;			// floor, Div >= di
+		}
+		else {
+		    rr = (uint64_t) (rq + 0.5);
+		}
+
+		if ( (rr < min_range) || (rr > 0xffffffff) ) {
+		    continue;
+		}
+
+		if ( frac ) {
+		    uint64_t	dd = (uint64_t)
+				    (hz * 4096 / ((double) freq_hz * rr) + 0.5);
+		    fi = dd >> 12;
+		    ff = dd & 0xfff;
+
+		    if ( (ff == 0) || (fi > 4095) ) {	// integer done above
+			continue;
+		    }
+		}
+
+		double		fhz = hz * 4096 / ((fi * 4096.0 + ff) * rr);
+		double		err   = ( fhz > freq_hz )
+					? (fhz - freq_hz) / freq_hz
+					: (freq_hz - fhz) / freq_hz;
+
+		bool		better = ! found || (err < best_err) ||
+			( (err == best_err) &&
+			  ( ((ff == 0) && (DivF != 0)) ||
+			    (((ff == 0) == (DivF == 0)) && (rr > Range)) ) );
+
+		if ( better ) {
+		    found    = 1;
+		    best_err = err;
+		    Source   = SrcNum[ss];
+		    DivI     = fi;
+		    DivF     = ff;
+		    Range    = rr;
+		    Freq     = fhz;
+		}
+	    }
+	}
+    }
+
+    if ( found ) {
+	double		ppb = best_err * 1e9 + 0.5;
+	ErrPpb = ( ppb < 4294967295.0 ) ? (uint32_t) ppb : 0xffffffff;
+    }
+
+    return  found;
+}
+
+
+/*
+* Apply the solution to the PWM clock manager and both channel Ranges.
+*    Clock Cntl and Divr are replaced (Enable_1=1, Mash_2=get_Mash()) and
+*    applied with apply_nicely(), so the clock is stopped while changing.
+*    Ranges are written only if the clock was applied.
+* call:
+*    self.apply( &clk, &pwx )
+*    &clk = PWM clock manager, cm_ClkPwm
+*    &pwx = PWM object
+* return:
+*    ()  = status:  0= success, 1= clock busy timeout, clock is disabled
+* exceptions:
+*    range_error  no solution
+*/
+bool
+rgPwmSolve::apply(
+    rgClk		*clk,
+    rgPwm		*pwx
+)
+{
+    if ( Range == 0 ) {
+	throw std::range_error ( "rgPwmSolve::apply():  no solution" );
+    }
+
+    clk->Cntl.put( 0 );
+    clk->Cntl.put_Source_4( Source );
+    clk->Cntl.put_Mash_2(   get_Mash() );
+    clk->Cntl.put_Enable_1( 1 );
+
+    clk->Divr.put( 0 );
+    clk->Divr.put_DivI_12( DivI );
+    clk->Divr.put_DivF_12( DivF );
+
+    bool		busy = clk->apply_nicely();
+
+    if ( ! busy ) {
+	pwx->Ch1Range.write( Range );
+	pwx->Ch2Range.write( Range );
+    }
+
+    return  busy;
+}
+
@@ -0,0 +1,73 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgPwmSolve_P
+#define rgPwmSolve_P
+
+#include "rgClk.h"
+#include "rgPwm.h"
+
+//--------------------------------------------------------------------------
+// rgPwmSolve - PWM clock and Range solver for a target frequency
+//--------------------------------------------------------------------------
+// PWM frequency is  Fsrc / (Div * Range),  where Div = DivI + DivF/4096
+// is the PWM clock manager (cm_ClkPwm) divisor.  solve() searches the
+// configured clock sources, every DivI {2..4095} (plus the best DivF when
+// fractional is allowed), and the Range that fits, for the least
+// frequency error with Range at least the required resolution.
+// The search is a fixed loop of about 4094 steps per source, so run time
+// is bounded and the result is the same for the same inputs.
+//
+// Ties prefer an integer divisor (MASH 0, no jitter), then larger Range.
+//
+// e.g.
+//    rgPwmSolve	slv;
+//    if ( slv.solve( 25000, 1000 ) ) {		// 25 kHz, >= 1000 steps
+//	slv.apply( &clk, &pwx );
+//    }
+
+class rgPwmSolve {
+  public:
+    static const uint32_t	MaxSrc = 4;	// number of clock sources
+
+  private:
+    uint32_t		SrcNum[MaxSrc];	// Source_4 values
+    uint32_t		SrcHz[MaxSrc];	// source frequency, Hz
+    uint32_t		NumSrc;		// number of sources configured
+
+    uint32_t		MaxClkHz;	// limit on PWM clock
+    bool		AllowFrac;	// fractional divisor allowed
+
+					// result of solve()
+    uint32_t		Source;		// Source_4
+    uint32_t		DivI;		// DivI_12
+    uint32_t		DivF;		// DivF_12
+    uint32_t		Range;		// Ch1Range, Ch2Range
+    double		Freq;		// achieved frequency, Hz
+    uint32_t		ErrPpb;		// relative error, parts per billion
+
+  public:
+    rgPwmSolve();		// constructor
+
+    void		clear_Sources();
+    void		add_Source( uint32_t  src,  uint32_t  hz );
+
+    inline uint32_t	get_NumSrc()	{ return  NumSrc; }
+
+    inline void		config_MaxClk( uint32_t  hz )	{ MaxClkHz = hz; }
+    inline void		config_AllowFrac( bool  v )	{ AllowFrac = v; }
+
+    bool		solve( uint32_t  freq_hz,  uint32_t  min_range );
+
+    bool		apply( rgClk  *clk,  rgPwm  *pwx );
+
+    inline uint32_t	get_Source()	{ return  Source; }
+    inline uint32_t	get_DivI()	{ return  DivI; }
+    inline uint32_t	get_DivF()	{ return  DivF; }
+    inline uint32_t	get_Mash()	{ return  ( DivF ) ? 1 : 0; }
+    inline uint32_t	get_Range()	{ return  Range; }
+    inline double	get_Freq()	{ return  Freq; }
+    inline uint32_t	get_ErrPpb()	{ return  ErrPpb; }
+};
+
+#endif
+
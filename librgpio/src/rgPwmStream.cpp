@@ -0,0 +1,484 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgPwmStream - PWM Fifo sample streaming on rgPwm, no DMA
+//
+// See:  doc/pwm_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgPwm.h"
+
+#include "rgPwmStream.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+
+//--------------------------------------------------------------------------
+// rgPwmStream_Ring
+//--------------------------------------------------------------------------
+
+/*
+* Constructor.
+* call:
+*    rgPwmStream_Ring	ring  ( buf, size );
+*    buf  = sample storage, size entries
+*    size = number of entries, power of 2 {2..2^31}
+* exceptions:
+*    range_error  size not a power of 2
+*/
+rgPwmStream_Ring::rgPwmStream_Ring(
+    int16_t		*buf,
+    uint32_t		size
+)
+{
+    if ( (size < 2) || (size & (size - 1)) ) {
+	std::ostringstream	css;
+	css << "rgPwmStream_Ring:  size requires power of 2:  " << size;
+	throw std::range_error ( css.str() );
+    }
+
+    Buf  = buf;
+    Size = size;
+    Mask = size - 1;
+
+    Head.store( 0 );
+    Tail.store( 0 );
+}
+
+
+/*
+* Push samples, as many as fit.  Producer side.
+* call:
+*    self.push_block( src, n )
+* return:
+*    ()  = number of samples pushed, less than n when full
+*/
+uint32_t
+rgPwmStream_Ring::push_block(
+    const int16_t	*src,
+    uint32_t		n
+)
+{
+    uint32_t		hh   = Head.load( std::memory_order_relaxed );
+    uint32_t		tt   = Tail.load( std::memory_order_acquire );
+    uint32_t		room = Size - (hh - tt);
+
+    if ( n > room ) {
+	n = room;
+    }
+
+    for ( uint32_t ii=0;  ii < n;  ii++ ) {
+	Buf[(hh + ii) & Mask] = src[ii];
+    }
+
+    Head.store( hh + n, std::memory_order_release );
+    return  n;
+}
+
+
+/*
+* Pop samples, as many as available.  Consumer side.
+* call:
+*    self.pop_block( dst, n )
+* return:
+*    ()  = number of samples popped, less than n when empty
+*/
+uint32_t
+rgPwmStream_Ring::pop_block(
+    int16_t		*dst,
+    uint32_t		n
+)
+{
+    uint32_t		tt   = Tail.load( std::memory_order_relaxed );
+    uint32_t		have = Head.load( std::memory_order_acquire ) - tt;
+
+    if ( n > have ) {
+	n = have;
+    }
+
+    for ( uint32_t ii=0;  ii < n;  ii++ ) {
+	dst[ii] = Buf[(tt + ii) & Mask];
+    }
+
+    Tail.store( tt + n, std::memory_order_release );
+    return  n;
+}
+
+
+/*
+* Empty the ring.  Not concurrent with push_block(), pop_block().
+*/
+void
+rgPwmStream_Ring::clear()
+{
+    Head.store( 0 );
+    Tail.store( 0 );
+}
+
+
+//--------------------------------------------------------------------------
+// rgPwmStream_Feed
+//--------------------------------------------------------------------------
+
+/*
+* Constructor.
+*    No sample source;  use config_Ring() or config_Source().
+*/
+rgPwmStream_Feed::rgPwmStream_Feed()
+{
+    Ring      = NULL;
+    Src       = NULL;
+    SrcCtx    = NULL;
+
+    Range     = 0;
+    Range2    = 0;
+    OddNext   = 0;
+    WordPos   = 0;
+    WordLen   = 0;
+
+    StopReq.store( 0 );
+
+    WordCnt   = 0;
+    StarveCnt = 0;
+}
+
+
+/*
+* Configure ring sample source, replaces any callback.
+*/
+void
+rgPwmStream_Feed::config_Ring(
+    rgPwmStream_Ring	*ring
+)
+{
+    Ring   = ring;
+    Src    = NULL;
+    SrcCtx = NULL;
+}
+
+
+/*
+* Configure callback sample source, replaces any ring.
+* call:
+*    self.config_Source( fn, ctx )
+*    fn  = sample callback
+*    ctx = passed to fn
+*/
+void
+rgPwmStream_Feed::config_Source(
+    rgPwmStream_Source	fn,
+    void		*ctx
+)
+{
+    Ring   = NULL;
+    Src    = fn;
+    SrcCtx = ctx;
+}
+
+
+/*
+* Start a stream:  set the scale, clear counts and any converted words.
+*    Words alternate even, odd from the first sample, so interleaved stereo
+*    frames {Ch1, Ch2} take range, range2.
+* call:
+*    self.start( range, range2 )	stereo
+*    self.start( range )		mono, same as start( range, range )
+*    range  = full scale of even Fifo words, from the channel range register
+*    range2 = full scale of odd Fifo words
+*/
+void
+rgPwmStream_Feed::start(
+    uint32_t		range,
+    uint32_t		range2
+)
+{
+    Range     = range;
+    Range2    = range2;
+    OddNext   = 0;
+    WordPos   = 0;
+    WordLen   = 0;
+
+    StopReq.store( 0 );
+
+    WordCnt   = 0;
+    StarveCnt = 0;
+}
+
+
+/*
+* Write converted words to the Fifo register, refilling from the source.
+*    No samples available with room left is counted in StarveCnt.
+* call:
+*    self.write_fifo( &fifo, room )
+*    fifo = Fifo input register
+*    room = number of words the Fifo status allows
+* return:
+*    ()  = number of words written
+*/
+uint32_t
+rgPwmStream_Feed::write_fifo(
+    rgRegister		*fifo,
+    uint32_t		room
+)
+{
+    uint32_t		nw   = 0;
+
+    while ( nw < room ) {
+	if ( (WordPos >= WordLen) && ! refill() ) {
+	    StarveCnt++;
+	    break;
+	}
+
+	fifo->write( Word[WordPos++] );
+	nw++;
+    }
+
+    WordCnt += nw;
+    return  nw;
+}
+
+
+/*
+* Refill converted words from the sample source, one block.
+*    A block may end on an odd sample, so OddNext keeps the stereo phase.
+* return:
+*    ()  = true if any samples, false if none available
+*/
+bool
+rgPwmStream_Feed::refill()
+{
+    uint32_t		n = 0;
+
+    if ( Ring ) {
+	n = Ring->pop_block( Raw, BlockSize );
+    }
+    else if ( Src ) {
+	n = (*Src)( SrcCtx, Raw, BlockSize );
+	if ( n > BlockSize ) {
+	    n = BlockSize;
+	}
+    }
+
+    if ( OddNext ) {
+	rgPwmStream::convert2( Raw, Word, n, Range2, Range );
+    }
+    else {
+	rgPwmStream::convert2( Raw, Word, n, Range, Range2 );
+    }
+
+    OddNext = OddNext ^ (n & 0x1);
+    WordPos = 0;
+    WordLen = n;
+
+    return  ( n > 0 );
+}
+
+
+//--------------------------------------------------------------------------
+// rgPwmStream
+//--------------------------------------------------------------------------
+
+/*
+* Constructor.
+*    No sample source;  use config_Ring() or config_Source().
+* call:
+*    rgPwmStream	pst  ( &pwx );
+*    &pwx  = PWM object
+*/
+rgPwmStream::rgPwmStream(
+    rgPwm		*pwx
+)
+{
+    Pwm       = pwx;
+    GapCnt    = 0;
+    PollCnt   = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Sample conversion
+//--------------------------------------------------------------------------
+// NEON does 4 samples per step:  flipping the sign bit is the +32768
+// offset, then a widening 32 x 32 multiply and narrowing shift by 16.
+// Lanes {0,1} of each half are {even, odd}, so one {range, range2} vector
+// scales both halves.
+
+/*
+* Convert signed 16-bit samples to PWM data words.
+*    Offset binary, scaled to range:  -32768 is 0, +32767 is just under
+*    range.
+* call:
+*    rgPwmStream::convert( src, dst, n, range )
+*    src   = samples
+*    dst   = output words, n
+*    n     = number of samples
+*    range = channel Range value, full scale
+*/
+void
+rgPwmStream::convert(
+    const int16_t	*src,
+    uint32_t		*dst,
+    uint32_t		n,
+    uint32_t		range
+)
+{
+    convert2( src, dst, n, range, range );
+}
+
+
+/*
+* Convert interleaved stereo samples to PWM data words.
+*    Same as convert(), with even samples scaled to range and odd samples
+*    to range2, i.e. frames {Ch1, Ch2} by Ch1Range, Ch2Range.
+* call:
+*    rgPwmStream::convert2( src, dst, n, range, range2 )
+*    src    = samples, src[0] is an even word
+*    dst    = output words, n
+*    n      = number of samples
+*    range  = full scale of even words
+*    range2 = full scale of odd words
+*/
+void
+rgPwmStream::convert2(
+    const int16_t	*src,
+    uint32_t		*dst,
+    uint32_t		n,
+    uint32_t		range,
+    uint32_t		range2
+)
+{
+    uint32_t		i = 0;
+
+#ifdef __ARM_NEON
+    const uint16x4_t	off = vdup_n_u16( 0x8000 );
+    const uint32_t	rv[2] = { range, range2 };
+    const uint32x2_t	rr  = vld1_u32( rv );
+
+    for ( ;  i + 4 <= n;  i += 4 )
+    {
+	uint16x4_t	uu = veor_u16( vreinterpret_u16_s16( vld1_s16( src + i ) ),
+				       off );
+	uint32x4_t	ww = vmovl_u16( uu );
+	uint32x2_t	lo = vshrn_n_u64( vmull_u32( vget_low_u32(  ww ), rr ),
+					  16 );
+	uint32x2_t	hi = vshrn_n_u64( vmull_u32( vget_high_u32( ww ), rr ),
+					  16 );
+
+	vst1q_u32( dst + i, vcombine_u32( lo, hi ) );
+    }
+#endif
+
+    for ( ;  i < n;  i++ )
+    {
+	uint64_t	uu = (uint32_t)(src[i] + 32768);
+
+	dst[i] = (uu * ( (i & 0x1) ? range2 : range )) >> 16;
+    }
+}
+
+
+//--------------------------------------------------------------------------
+// Streaming
+//--------------------------------------------------------------------------
+
+/*
+* Start a stream.
+*    Read Cntl UseFifo and the Range of each channel on the Fifo for the
+*    scale, clear counts and any converted words.
+*	both on Fifo:	stereo, even words Ch1Range, odd words Ch2Range
+*	Ch2 only:	mono, Ch2Range
+*	otherwise:	mono, Ch1Range
+*    Setting Cntl (UseFifo, Enable) is left to the caller, as is
+*    ClearFifo_1, but UseFifo must be set before start().
+* exceptions:
+*    range_error  no sample source configured
+*/
+void
+rgPwmStream::start()
+{
+    if ( ! Feed.has_source() ) {
+	throw std::range_error ( "rgPwmStream::start():  no sample source" );
+    }
+
+    Pwm->Cntl.grab();
+    bool	fifo1 = Pwm->Cntl.get_Ch1_UseFifo_1();
+    bool	fifo2 = Pwm->Cntl.get_Ch2_UseFifo_1();
+
+    if ( fifo1 && fifo2 ) {
+	Feed.start( Pwm->Ch1Range.read(), Pwm->Ch2Range.read() );
+    }
+    else if ( fifo2 ) {
+	Feed.start( Pwm->Ch2Range.read() );
+    }
+    else {
+	Feed.start( Pwm->Ch1Range.read() );
+    }
+
+    GapCnt    = 0;
+    PollCnt   = 0;
+}
+
+
+/*
+* Service the Fifo, one pass.
+*    Non-blocking;  call often enough that the Fifo does not run dry
+*    (8 words at the sample rate).
+*    Read Stat once.  Error flags seen are cleared by writing it back,
+*    and GapErr_1 on either channel is counted in GapCnt.
+*    FifoEmpty_1=1:  write FifoDepth words without further reads.
+*    Else FifoFull_1=0:  write one word.
+*    No samples available with Fifo room is counted in StarveCnt.
+* call:
+*    self.service()
+* return:
+*    ()  = number of words written
+*/
+uint32_t
+rgPwmStream::service()
+{
+    bool		gap;
+    uint32_t		room = Pwm->fifo_room( gap );	// one status read
+
+    PollCnt++;
+
+    if ( gap ) {
+	GapCnt++;
+    }
+
+    return  Feed.write_fifo( &Pwm->Fifo, room );
+}
+
+
+/*
+* Stream until nword words are written, or stop().
+*    The last burst may exceed nword by up to FifoDepth - 1 words.
+* call:
+*    self.run( nword )
+*    nword = number of words, 0= until stop()
+* return:
+*    ()  = words written, get_WordCnt()
+*/
+uint64_t
+rgPwmStream::run(
+    uint64_t		nword
+)
+{
+    while ( Feed.running( nword ) ) {
+	service();
+    }
+
+    return  Feed.get_WordCnt();
+}
+
@@ -0,0 +1,190 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgPwmStream_P
+#define rgPwmStream_P
+
+#include <atomic>
+
+#include "rgPwm.h"
+
+//--------------------------------------------------------------------------
+// rgPwmStream - PWM Fifo sample streaming on rgPwm, no DMA
+//--------------------------------------------------------------------------
+// Feeds signed 16-bit samples, scaled to Range, into the shared PWM Fifo.
+// With both channels using the Fifo (Ch1_UseFifo_1=1, Ch2_UseFifo_1=1)
+// the hardware takes words alternately for Ch1, Ch2, so samples are
+// interleaved stereo frames {Ch1, Ch2}, scaled by Ch1Range, Ch2Range.
+// With one channel, mono, scaled by the Range of that channel.
+// Samples come from a single-producer/single-consumer ring, or from a
+// callback.  Each service() pass reads Stat once;  GapErr_1 (Fifo ran dry
+// while in use) is counted as an underrun.
+//
+// e.g.
+//    int16_t		buf[8192];
+//    rgPwmStream_Ring	ring  ( buf, 8192 );
+//    rgPwmStream	pst   ( &pwx );
+//    pst.config_Ring( &ring );
+//    pst.start();			// after Cntl, Ch1Range, Ch2Range configured
+//    pst.run( 0 );			// until stop() from another thread
+
+//--------------------------------------------------------------------------
+// Single-producer/single-consumer ring of samples.
+//    Storage is supplied by the caller, size a power of 2.
+//    Head and Tail are free-running indexes;  each is written by only one
+//    side, and published with release/acquire ordering.
+
+class rgPwmStream_Ring {
+  private:
+    int16_t			*Buf;		// storage
+    uint32_t			Size;		// number of entries
+    uint32_t			Mask;		// Size - 1
+
+    std::atomic<uint32_t>	Head;		// next write, producer
+    std::atomic<uint32_t>	Tail;		// next read, consumer
+
+  public:
+    rgPwmStream_Ring(		// constructor
+	int16_t		*buf,
+	uint32_t	size
+    );
+
+		// Producer side
+    uint32_t		push_block( const int16_t  *src,  uint32_t  n );
+
+		// Consumer side
+    uint32_t		pop_block(  int16_t  *dst,  uint32_t  n );
+
+    inline uint32_t	count()
+			{
+			    return  Head.load( std::memory_order_acquire ) -
+				    Tail.load( std::memory_order_acquire );
+			}
+
+    inline uint32_t	get_Size()  { return  Size; }
+
+    void		clear();	// not concurrent with push, pop
+};
+
+
+//--------------------------------------------------------------------------
+// Sample callback:  put up to n samples in buf, return number put.
+//    Zero means none available now;  it is called again on a later pass.
+
+typedef uint32_t (*rgPwmStream_Source)(
+    void		*ctx,
+    int16_t		*buf,
+    uint32_t		n
+);
+
+
+//--------------------------------------------------------------------------
+// Sample feed:  source, block conversion, and Fifo word writes.
+//    Shared by rgPwmStream and rgsPwmStream, which differ only in how the
+//    Fifo status gives the room to write.
+
+class rgPwmStream_Feed {
+  public:
+    static const uint32_t	BlockSize = 64;		// samples per convert
+
+  private:
+    rgPwmStream_Ring	*Ring;		// sample source, or NULL
+    rgPwmStream_Source	Src;		// sample callback, or NULL
+    void		*SrcCtx;	// callback context
+
+    uint32_t		Range;		// scale of even words, from start()
+    uint32_t		Range2;		// scale of odd words, from start()
+    bool		OddNext;	// next sample converted is an odd word
+
+    int16_t		Raw[BlockSize];		// samples from source
+    uint32_t		Word[BlockSize];	// converted Fifo words
+    uint32_t		WordPos;	// next Word[] to write
+    uint32_t		WordLen;	// Word[] valid
+
+    std::atomic<bool>	StopReq;	// set by stop()
+
+    uint64_t		WordCnt;	// words written to Fifo
+    uint64_t		StarveCnt;	// passes with Fifo room, no samples
+
+  public:
+    rgPwmStream_Feed();		// constructor
+
+    void		config_Ring( rgPwmStream_Ring  *ring );
+    void		config_Source( rgPwmStream_Source  fn,  void  *ctx );
+
+    inline bool		has_source()  { return  (Ring != NULL) || (Src != NULL); }
+
+    void		start( uint32_t  range,  uint32_t  range2 );
+    inline void		start( uint32_t  range )  { start( range, range ); }
+    uint32_t		write_fifo( rgRegister  *fifo,  uint32_t  room );
+
+    inline bool		running( uint64_t  nword )
+			{
+			    return  ! StopReq.load( std::memory_order_relaxed )
+				    && ( (nword == 0) || (WordCnt < nword) );
+			}
+
+    inline void		stop()    { StopReq.store( 1 ); }
+
+    inline uint32_t	get_Range()      { return  Range; }
+    inline uint32_t	get_Range2()     { return  Range2; }
+    inline uint64_t	get_WordCnt()    { return  WordCnt; }
+    inline uint64_t	get_StarveCnt()  { return  StarveCnt; }
+
+  private:
+    bool		refill();
+};
+
+
+//--------------------------------------------------------------------------
+
+class rgPwmStream {
+  public:
+    static const uint32_t	FifoDepth = rgPwm::FifoDepth;	// words
+
+  private:
+    rgPwm		*Pwm;		// PWM unit
+    rgPwmStream_Feed	Feed;		// samples, Range from Ch1Range, Ch2Range
+
+    uint64_t		GapCnt;		// GapErr_1 seen, underruns
+    uint64_t		PollCnt;	// Stat reads
+
+  public:
+    rgPwmStream(		// constructor
+	rgPwm		*pwx
+    );
+
+    inline void		config_Ring( rgPwmStream_Ring  *ring )
+			    { Feed.config_Ring( ring ); }
+    inline void		config_Source( rgPwmStream_Source  fn,  void  *ctx )
+			    { Feed.config_Source( fn, ctx ); }
+
+    void		start();
+    uint32_t		service();
+    uint64_t		run( uint64_t  nword );
+    inline void		stop()    { Feed.stop(); }
+
+    static void		convert(
+			    const int16_t	*src,
+			    uint32_t		*dst,
+			    uint32_t		n,
+			    uint32_t		range
+			);
+
+    static void		convert2(
+			    const int16_t	*src,
+			    uint32_t		*dst,
+			    uint32_t		n,
+			    uint32_t		range,
+			    uint32_t		range2
+			);
+
+    inline uint32_t	get_Range()      { return  Feed.get_Range(); }
+    inline uint32_t	get_Range2()     { return  Feed.get_Range2(); }
+    inline uint64_t	get_WordCnt()    { return  Feed.get_WordCnt(); }
+    inline uint64_t	get_GapCnt()     { return  GapCnt; }
+    inline uint64_t	get_StarveCnt()  { return  Feed.get_StarveCnt(); }
+    inline uint64_t	get_PollCnt()    { return  PollCnt; }
+};
+
+#endif
+
@@ -71,6 +71,12 @@ rgSpi0::rgSpi0(
       DmaLen.init_addr( GpioBase +   DmaLen_offset );
        Lossi.init_addr( GpioBase +    Lossi_offset );
       DmaReq.init_addr( GpioBase +   DmaReq_offset );
+
+    XferLen     = 0;
+    TxCnt       = 0;
+    RxCnt       = 0;
+    PollCnt     = 0;
+    FillByte    = 0x00;
 }
 
 
@@ -137,6 +143,267 @@ rgSpi0::push_regs()
 }
 
 
+//--------------------------------------------------------------------------
+// Polled transfer engine
+//--------------------------------------------------------------------------
+// Full-duplex byte transfer through the Tx/Rx Fifo, polling CntlStat.
+// Keeps up to FifoDepth bytes in flight (written to Tx, not yet read from Rx),
+// so the Rx Fifo can never overflow.  Chip select is held by RunActive_1
+// from start_xfer() to end_xfer().
+// Tx and Rx data are walked through rgIoVec cursors, so a scatter/gather
+// list (start_xferv()) costs the same as one buffer, with no copy.
+// Each service_xfer() pass reads CntlStat exactly once, and decodes all
+// status bits from that one value.
+
+					// CntlStat status bits
+static const uint32_t	Spi0_RxFullStop  = 1 << 20;	// RXF
+static const uint32_t	Spi0_TxHasSpace  = 1 << 18;	// TXD
+static const uint32_t	Spi0_RxHasData   = 1 << 17;	// RXD
+static const uint32_t	Spi0_TxEmpty     = 1 << 16;	// DONE
+
+
+/*
+* Full-duplex transfer, blocking until all bytes are received.
+*    Chip select is released (RunActive_1=0) at the end.
+*    Other CntlStat configuration (ChipSelectN_2, clock mode) is unchanged.
+* call:
+*    self.transfer( tx, rx, n )
+*    tx  = Tx data, NULL= send FillByte (Rx-only)
+*    rx  = Rx data buffer, NULL= discard (Tx-only)
+*    n   = number of bytes
+* return:
+*    ()  = number of bytes transferred, n
+*/
+size_t
+rgSpi0::transfer(
+    const uint8_t	*tx,
+    uint8_t		*rx,
+    size_t		n
+)
+{
+    start_xfer( tx, rx, n );
+
+    while ( ! service_xfer() ) {
+    }
+
+    end_xfer();
+
+    return  RxCnt;
+}
+
+
+/*
+* Start a transfer.
+*    Clear both Fifos and set RunActive_1=1 (assert chip select).
+*    Buffers must remain valid until is_xfer_done().
+* call:
+*    self.start_xfer( tx, rx, n )
+*    tx  = Tx data, NULL= send FillByte
+*    rx  = Rx data buffer, NULL= discard
+*    n   = number of bytes, 0 is done immediately
+*/
+void
+rgSpi0::start_xfer(
+    const uint8_t	*tx,
+    uint8_t		*rx,
+    size_t		n
+)
+{
+    TxOne.iov_base = (void*) tx;	// NULL segment is fill/discard
+    TxOne.iov_len  = n;
+    RxOne.iov_base = rx;
+    RxOne.iov_len  = n;
+
+    XferTx.init( &TxOne, 1 );
+    XferRx.init( &RxOne, 1 );
+    begin_xfer( n );
+}
+
+
+/*
+* Full-duplex scatter/gather transfer, blocking until all bytes are received.
+*    As transfer(), with Tx and Rx each a list of segments walked directly
+*    by the Fifo loop, e.g. header, payload and CRC in separate buffers.
+* call:
+*    self.transferv( txv, ntx, rxv, nrx )
+*    txv = Tx segment list, NULL base= send FillByte
+*    ntx = number of Tx segments
+*    rxv = Rx segment list, NULL base= discard
+*    nrx = number of Rx segments
+* return:
+*    ()  = number of bytes transferred, larger of the Tx and Rx totals
+*/
+size_t
+rgSpi0::transferv(
+    const struct iovec	*txv,
+    uint32_t		ntx,
+    const struct iovec	*rxv,
+    uint32_t		nrx
+)
+{
+    start_xferv( txv, ntx, rxv, nrx );
+
+    while ( ! service_xfer() ) {
+    }
+
+    end_xfer();
+
+    return  RxCnt;
+}
+
+
+/*
+* Start a scatter/gather transfer.
+*    Length is the larger of the Tx and Rx totals.  A shorter Tx list is
+*    padded with FillByte, a shorter Rx list discards the rest.
+*    Segment lists and buffers must remain valid until is_xfer_done().
+* call:
+*    self.start_xferv( txv, ntx, rxv, nrx )
+*    Arguments are as for transferv().
+*/
+void
+rgSpi0::start_xferv(
+    const struct iovec	*txv,
+    uint32_t		ntx,
+    const struct iovec	*rxv,
+    uint32_t		nrx
+)
+{
+    size_t		ntot = rgIoVec::total( txv, ntx );
+    size_t		nrot = rgIoVec::total( rxv, nrx );
+
+    XferTx.init( txv, ntx );
+    XferRx.init( rxv, nrx );
+    begin_xfer( (ntot > nrot) ? ntot : nrot );
+}
+
+
+/*
+* Begin a transfer of n bytes, Tx and Rx cursors already set.
+*    Clear both Fifos and set RunActive_1=1 (assert chip select).
+*/
+void
+rgSpi0::begin_xfer(
+    size_t		n
+)
+{
+    XferLen     = n;
+    TxCnt       = 0;
+    RxCnt       = 0;
+    PollCnt     = 0;
+
+    CntlStat.grab();
+    CntlStat.put_ClearRxTxFifo_2( 0x3 );
+    CntlStat.put_RunActive_1(     1 );
+    CntlStat.push();
+}
+
+
+/*
+* Service a started transfer, one pass.
+*    Non-blocking;  call repeatedly until it returns true.
+*    When CntlStat shows Tx done (or Rx full), every byte in flight is
+*    already in the Rx Fifo, so they are all read, and the Tx Fifo is then
+*    refilled with up to FifoDepth bytes, all without further status reads.
+*    Otherwise move at most one byte each way.
+*    Rx data is always read (even when discarded), since a full Rx Fifo
+*    stops the serial clock.
+* call:
+*    self.service_xfer()
+* return:
+*    ()  = true when all n bytes are received
+*/
+bool
+rgSpi0::service_xfer()
+{
+    if ( RxCnt >= XferLen ) {
+	return  1;
+    }
+
+    uint32_t		cs = CntlStat.read();		// one status read
+    PollCnt++;
+
+    if ( cs & (Spi0_TxEmpty | Spi0_RxFullStop) ) {	// all in Rx Fifo
+	while ( RxCnt < TxCnt ) {
+	    XferRx.put( Fifo.read() );
+	    RxCnt++;
+	}
+
+	size_t		room = XferLen - TxCnt;
+	if ( room > FifoDepth ) {
+	    room = FifoDepth;
+	}
+
+	while ( room-- ) {
+	    Fifo.write( XferTx.get( FillByte ) );
+	    TxCnt++;
+	}
+    }
+    else {
+	if ( (cs & Spi0_RxHasData) && (RxCnt < TxCnt) ) {
+	    XferRx.put( Fifo.read() );
+	    RxCnt++;
+	}
+
+	if ( (cs & Spi0_TxHasSpace) && (TxCnt < XferLen) &&
+	     ((TxCnt - RxCnt) < FifoDepth)
+	) {
+	    Fifo.write( XferTx.get( FillByte ) );
+	    TxCnt++;
+	}
+    }
+
+    return  ( RxCnt >= XferLen );
+}
+
+
+/*
+* End a transfer.
+*    Set RunActive_1=0 (release chip select).
+*    Not needed between back-to-back transfers that share one chip select
+*    frame;  start_xfer() leaves RunActive_1=1.
+*/
+void
+rgSpi0::end_xfer()
+{
+    CntlStat.grab();
+    CntlStat.put_ClearRxTxFifo_2( 0x0 );
+    CntlStat.put_RunActive_1(     0 );
+    CntlStat.push();
+}
+
+
+//--------------------------------------------------------------------------
+// DMA mode
+//--------------------------------------------------------------------------
+
+/*
+* Fifo header word for a DMA transfer.
+*    With DmaEnable_1=1 and RunActive_1=0, the first Tx Fifo write sets
+*    DmaLen[15:0] from bits [31:16] and CntlStat[7:0] from bits [7:0].
+*    The header takes CntlStat[7:0] from the object, with RunActive_1=1.
+*    Put it as the first word of the Tx memory given to rgDma_Chain.
+* call:
+*    self.dma_header( n )
+*    n   = number of bytes to transfer {0..0xffff}
+* exceptions:
+*    range_error if n exceeds 16 bits
+*/
+uint32_t
+rgSpi0::dma_header(
+    uint32_t		n
+)
+{
+    if ( n > 0xffff ) {
+	std::ostringstream	css;
+	css << "rgSpi0::dma_header():  require n <= 0xffff:  " << n;
+	throw std::range_error ( css.str() );
+    }
+
+    return  (n << 16) | (CntlStat.get() & 0x7f) | 0x80;
+}
+
+
 //--------------------------------------------------------------------------
 // Debug
 //--------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #define rgSpi0_P
 
 #include "rgRegister.h"
+#include "rgIoVec.h"
 
 //--------------------------------------------------------------------------
 // rGPIO SPI0 Master class.  Spi0
@@ -121,6 +122,17 @@ class rgSpi0 {
     uint32_t		SpiNum;		// SPI unit number {0,3,4,5,6}
     uint32_t		FeatureAddr;	// BCM doc address, in constructor
 
+				// Transfer engine state
+    rgIoVec		XferTx;		// Tx data cursor
+    rgIoVec		XferRx;		// Rx data cursor
+    struct iovec	TxOne;		// Tx segment of start_xfer()
+    struct iovec	RxOne;		// Rx segment of start_xfer()
+    size_t		XferLen;	// bytes in transfer
+    size_t		TxCnt;		// bytes written to Fifo
+    size_t		RxCnt;		// bytes read from Fifo
+    uint32_t		PollCnt;	// CntlStat reads in transfer
+    uint8_t		FillByte;	// Tx byte for NULL or short Tx data
+
   public:
 				// Register data
     rgSpi0_CntlStat	CntlStat;	// CS    Control and Status
@@ -141,6 +153,9 @@ class rgSpi0 {
     static const uint32_t	Lossi_offset     = 0x10 /4;
     static const uint32_t	DmaReq_offset    = 0x14 /4;
 
+  public:
+    static const uint32_t	FifoDepth        = 64;	// bytes, each of Tx, Rx
+
   public:
     rgSpi0(			// constructor
 	rgAddrMap	*xx,
@@ -153,6 +168,51 @@ class rgSpi0 {
 		// Direct control:  (modify register fields)
 //  void		clear_fifos();	#!! not implemented
 
+		// Polled transfer engine
+    size_t		transfer(
+			    const uint8_t	*tx,
+			    uint8_t		*rx,
+			    size_t		n
+			);
+
+    void		start_xfer(
+			    const uint8_t	*tx,
+			    uint8_t		*rx,
+			    size_t		n
+			);
+
+    size_t		transferv(
+			    const struct iovec	*txv,
+			    uint32_t		ntx,
+			    const struct iovec	*rxv,
+			    uint32_t		nrx
+			);
+
+    void		start_xferv(
+			    const struct iovec	*txv,
+			    uint32_t		ntx,
+			    const struct iovec	*rxv,
+			    uint32_t		nrx
+			);
+
+    bool		service_xfer();
+    void		end_xfer();
+
+    inline bool		is_xfer_done()    { return  (RxCnt >= XferLen); }
+    inline size_t	get_XferTxCnt()   { return  TxCnt; }
+    inline size_t	get_XferRxCnt()   { return  RxCnt; }
+    inline uint32_t	get_PollCnt()     { return  PollCnt; }
+
+    inline void		config_FillByte( uint8_t v )  { FillByte = v; }
+    inline uint8_t	config_FillByte()             { return  FillByte; }
+
+  private:
+    void		begin_xfer( size_t  n );
+
+  public:
+		// DMA mode
+    uint32_t		dma_header( uint32_t  n );
+
 		// Object state operations
     void		init_put_reset();
 
@@ -0,0 +1,506 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgSpi0Lossi - LoSSI display panel streaming on SPI0
+//
+// See:  BCM2835 ARM Peripherals (2012)
+//	p.150  10.2.3  LoSSI mode
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+
+#include "rgSpi0Lossi.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+					// CntlStat status bits
+static const uint32_t	Spi0_RxFullStop  = 1 << 20;	// RXF
+static const uint32_t	Spi0_TxHasSpace  = 1 << 18;	// TXD
+static const uint32_t	Spi0_RxHasData   = 1 << 17;	// RXD
+static const uint32_t	Spi0_TxEmpty     = 1 << 16;	// DONE
+
+static const uint32_t	LossiBurst = 16;	// Fifo words, 16 x 32-bit entries
+static const uint16_t	LossiData  = 0x100;	// D/C bit, 1= data
+
+/*
+* Constructor.
+*    Pixel format defaults to pix_RGB565.
+* call:
+*    rgSpi0Lossi	lx  ( &spx, width, height );
+*    spx    = SPI0 unit object, clock and chip select already configured
+*    width  = panel width,  pixels {1..MaxWidth}
+*    height = panel height, pixels {1..65535}
+* exceptions:
+*    range_error if size out of range
+*/
+rgSpi0Lossi::rgSpi0Lossi(
+    rgSpi0		*spx,
+    uint32_t		width,
+    uint32_t		height
+)
+{
+    if ( (width == 0) || (width > MaxWidth) ) {
+	std::ostringstream	css;
+	css << "rgSpi0Lossi:  require width {1.." << MaxWidth << "}:  "
+	    << width;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( (height == 0) || (height > 0xffff) ) {
+	std::ostringstream	css;
+	css << "rgSpi0Lossi:  require height {1..65535}:  " << height;
+	throw std::range_error ( css.str() );
+    }
+
+    Spi      = spx;
+    Width    = width;
+    Height   = height;
+    Fmt      = pix_RGB565;
+    WordCnt  = 0;
+    PollCnt  = 0;
+    InFlight = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Pixel row conversion
+//--------------------------------------------------------------------------
+// With NEON, 8 pixels per step:  vld4 splits the little-endian pixel words
+// into b, g, r byte lanes, and vst2/vst3 interleave the output words.
+// The scalar loop does the remaining pixels, and all of them elsewhere.
+
+/*
+* Convert RGB888 pixels to RGB565 LoSSI data words, 2 per pixel.
+* call:
+*    rgSpi0Lossi::pack_rgb565( src, dst, n )
+*    src = pixels 0x00rrggbb
+*    dst = output words, at least 2*n
+*    n   = number of pixels
+* return:
+*    ()  = number of words
+*/
+uint32_t
+rgSpi0Lossi::pack_rgb565(
+    const uint32_t	*src,
+    uint16_t		*dst,
+    uint32_t		n
+)
+{
+    uint32_t		i = 0;
+
+#ifdef __ARM_NEON
+    const uint16x8_t	dd = vdupq_n_u16( LossiData );
+
+    for ( ;  i + 8 <= n;  i += 8 )
+    {
+	uint8x8x4_t	px = vld4_u8( (const uint8_t*)(src + i) );  // b,g,r,0
+	uint8x8_t	hi = vorr_u8( vand_u8( px.val[2], vdup_n_u8( 0xf8 ) ),
+				      vshr_n_u8( px.val[1], 5 ) );
+	uint8x8_t	lo = vorr_u8( vand_u8( vshl_n_u8( px.val[1], 3 ),
+					       vdup_n_u8( 0xe0 ) ),
+				      vshr_n_u8( px.val[0], 3 ) );
+	uint16x8x2_t	ww;
+
+	ww.val[0] = vorrq_u16( vmovl_u8( hi ), dd );
+	ww.val[1] = vorrq_u16( vmovl_u8( lo ), dd );
+	vst2q_u16( dst + 2*i, ww );
+    }
+#endif
+
+    for ( ;  i < n;  i++ )
+    {
+	uint32_t	pp = src[i];
+	uint32_t	rr = (pp >> 16) & 0xff;
+	uint32_t	gg = (pp >>  8) & 0xff;
+	uint32_t	bb =  pp        & 0xff;
+
+	dst[2*i]     = LossiData | ( (rr & 0xf8)        | (gg >> 5) );
+	dst[2*i + 1] = LossiData | ( ((gg << 3) & 0xe0) | (bb >> 3) );
+    }
+
+    return  2 * n;
+}
+
+
+/*
+* Convert RGB888 pixels to RGB666 LoSSI data words, 3 per pixel.
+*    Each color is the upper 6 bits, left aligned in its byte.
+* return:
+*    ()  = number of words
+*/
+uint32_t
+rgSpi0Lossi::pack_rgb666(
+    const uint32_t	*src,
+    uint16_t		*dst,
+    uint32_t		n
+)
+{
+    uint32_t		i = 0;
+
+#ifdef __ARM_NEON
+    const uint16x8_t	dd = vdupq_n_u16( LossiData );
+    const uint8x8_t	mk = vdup_n_u8( 0xfc );
+
+    for ( ;  i + 8 <= n;  i += 8 )
+    {
+	uint8x8x4_t	px = vld4_u8( (const uint8_t*)(src + i) );  // b,g,r,0
+	uint16x8x3_t	ww;
+
+	ww.val[0] = vorrq_u16( vmovl_u8( vand_u8( px.val[2], mk ) ), dd );
+	ww.val[1] = vorrq_u16( vmovl_u8( vand_u8( px.val[1], mk ) ), dd );
+	ww.val[2] = vorrq_u16( vmovl_u8( vand_u8( px.val[0], mk ) ), dd );
+	vst3q_u16( dst + 3*i, ww );
+    }
+#endif
+
+    for ( ;  i < n;  i++ )
+    {
+	uint32_t	pp = src[i];
+
+	dst[3*i]     = LossiData | ( (pp >> 16) & 0xfc );
+	dst[3*i + 1] = LossiData | ( (pp >>  8) & 0xfc );
+	dst[3*i + 2] = LossiData | (  pp        & 0xfc );
+    }
+
+    return  3 * n;
+}
+
+
+//--------------------------------------------------------------------------
+// Fifo streaming (private)
+//--------------------------------------------------------------------------
+
+/*
+* Begin a session:  LoSSI mode, clear Fifos, assert chip select.
+*/
+void
+rgSpi0Lossi::begin()
+{
+    WordCnt  = 0;
+    PollCnt  = 0;
+    InFlight = 0;
+
+    Spi->CntlStat.grab();
+    Spi->CntlStat.put_LossiEnable_1(   1 );
+    Spi->CntlStat.put_ClearRxTxFifo_2( 0x3 );
+    Spi->CntlStat.put_RunActive_1(     1 );
+    Spi->CntlStat.push();
+}
+
+
+/*
+* End a session:  wait for Tx done, release chip select.
+*    Rx is read as in put_words(), so a full Rx Fifo can not stop the clock
+*    before Tx empties.  With at most LossiBurst words in flight, RxFull_1
+*    also means every word is sent.
+*    LossiEnable_1 is left on.
+*/
+void
+rgSpi0Lossi::end()
+{
+    while ( 1 )
+    {
+	uint32_t	cs = Spi->CntlStat.read();	// one status read
+	PollCnt++;
+
+	if ( cs & (Spi0_TxEmpty | Spi0_RxFullStop) ) {	// all in Rx Fifo
+	    drain_rx();
+	    break;
+	}
+
+	if ( (cs & Spi0_RxHasData) && InFlight ) {
+	    Spi->Fifo.read();
+	    InFlight--;
+	}
+    }
+
+    Spi->CntlStat.grab();
+    Spi->CntlStat.put_ClearRxTxFifo_2( 0x0 );
+    Spi->CntlStat.put_RunActive_1(     0 );
+    Spi->CntlStat.push();
+}
+
+
+/*
+* Read and discard all Rx words in flight.
+*    Only when CntlStat shows Tx done or Rx full, i.e. they are all in the
+*    Rx Fifo.
+*/
+void
+rgSpi0Lossi::drain_rx()
+{
+    while ( InFlight ) {
+	Spi->Fifo.read();
+	InFlight--;
+    }
+}
+
+
+/*
+* Write 9-bit words to the Fifo, keeping it topped up.
+*    Each pass reads CntlStat once, as rgSpi0::service_xfer().  With Tx
+*    empty or Rx full, every word in flight is in the Rx Fifo, so they are
+*    all read and a whole burst is written, with no more status reads.
+*    Otherwise move at most one word each way.
+*    Words in flight (written, not yet read back) are capped at LossiBurst,
+*    so Rx can hold them all, and RxFull_1 never stops the clock with Tx
+*    words left.  Rx data is discarded.
+*/
+void
+rgSpi0Lossi::put_words(
+    const uint16_t	*wv,
+    uint32_t		n
+)
+{
+    uint32_t		ii = 0;
+
+    while ( ii < n )
+    {
+	uint32_t	cs = Spi->CntlStat.read();	// one status read
+	PollCnt++;
+
+	if ( cs & (Spi0_TxEmpty | Spi0_RxFullStop) ) {	// all in Rx Fifo
+	    drain_rx();
+
+	    uint32_t	room = n - ii;
+	    if ( room > LossiBurst ) {
+		room = LossiBurst;
+	    }
+
+	    InFlight = room;
+	    while ( room-- ) {
+		Spi->Fifo.write( wv[ii++] );
+	    }
+	}
+	else {
+	    if ( (cs & Spi0_RxHasData) && InFlight ) {
+		Spi->Fifo.read();
+		InFlight--;
+	    }
+
+	    if ( (cs & Spi0_TxHasSpace) && (InFlight < LossiBurst) ) {
+		Spi->Fifo.write( wv[ii++] );
+		InFlight++;
+	    }
+	}
+    }
+
+    WordCnt += n;
+}
+
+
+/*
+* Write a command word and its parameter words.
+*/
+void
+rgSpi0Lossi::put_cmd(
+    uint8_t		cmd,
+    const uint8_t	*param,
+    uint32_t		n
+)
+{
+    uint16_t		wv[LossiBurst];
+    uint32_t		k = 0;
+
+    wv[k++] = cmd;			// D/C= 0 command
+
+    for ( uint32_t i=0;  i < n;  i++ )
+    {
+	wv[k++] = LossiData | param[i];
+
+	if ( k == LossiBurst ) {
+	    put_words( wv, k );
+	    k = 0;
+	}
+    }
+
+    if ( k ) {
+	put_words( wv, k );
+    }
+}
+
+
+/*
+* Write window commands and pixel rows of one clipped rectangle.
+*/
+void
+rgSpi0Lossi::put_rect(
+    const uint32_t	*fb,
+    uint32_t		stride,
+    Rect&		rx
+)
+{
+    uint32_t		x1 = rx.X + rx.W - 1;
+    uint32_t		y1 = rx.Y + rx.H - 1;
+
+    uint8_t		caset[4] = {
+	(uint8_t)(rx.X >> 8), (uint8_t)rx.X, (uint8_t)(x1 >> 8), (uint8_t)x1
+    };
+    uint8_t		raset[4] = {
+	(uint8_t)(rx.Y >> 8), (uint8_t)rx.Y, (uint8_t)(y1 >> 8), (uint8_t)y1
+    };
+
+    put_cmd( Dcs_CASET, caset, 4 );
+    put_cmd( Dcs_RASET, raset, 4 );
+    put_cmd( Dcs_RAMWR, 0,     0 );
+
+    for ( uint32_t row = rx.Y;  row <= y1;  row++ )
+    {
+	const uint32_t	*src = fb + (row * stride) + rx.X;
+	uint32_t	nw;
+
+	if ( Fmt == pix_RGB666 ) {
+	    nw = pack_rgb666( src, RowBuf, rx.W );
+	}
+	else {
+	    nw = pack_rgb565( src, RowBuf, rx.W );
+	}
+
+	put_words( RowBuf, nw );
+    }
+}
+
+
+//--------------------------------------------------------------------------
+// Panel operations
+//--------------------------------------------------------------------------
+
+/*
+* Clip a rectangle to the panel.
+* call:
+*    self.clip_rect( rx )
+* return:
+*    ()  = true if anything is left, rx is modified
+*/
+bool
+rgSpi0Lossi::clip_rect(
+    Rect&		rx
+)
+{
+    if ( (rx.W == 0) || (rx.H == 0) || (rx.X >= Width) || (rx.Y >= Height) ) {
+	return  0;
+    }
+
+    if ( rx.W > Width  - rx.X ) { rx.W = Width  - rx.X; }
+    if ( rx.H > Height - rx.Y ) { rx.H = Height - rx.Y; }
+
+    return  1;
+}
+
+
+/*
+* Send one command with parameters, in its own chip select frame.
+* call:
+*    self.send_cmd( cmd )
+*    self.send_cmd( cmd, param, n )
+*    cmd   = command byte
+*    param = parameter bytes
+*    n     = number of parameter bytes
+*/
+void
+rgSpi0Lossi::send_cmd(
+    uint8_t		cmd,
+    const uint8_t	*param,
+    uint32_t		n
+)
+{
+    begin();
+    put_cmd( cmd, param, n );
+    end();
+}
+
+
+/*
+* Push one rectangle of the framebuffer to the panel.
+*    The rectangle is clipped to the panel.
+* call:
+*    self.push_rect( fb, stride, rx )
+*    fb     = framebuffer, pixels 0x00rrggbb, row 0 first
+*    stride = framebuffer row length, pixels
+*    rx     = rectangle, framebuffer and panel coordinates are the same
+* return:
+*    ()  = number of pixels sent
+*/
+uint32_t
+rgSpi0Lossi::push_rect(
+    const uint32_t	*fb,
+    uint32_t		stride,
+    Rect		rx
+)
+{
+    if ( ! clip_rect( rx ) ) {
+	WordCnt = 0;
+	PollCnt = 0;
+	return  0;
+    }
+
+    begin();
+    put_rect( fb, stride, rx );
+    end();
+
+    return  rx.W * rx.H;
+}
+
+
+/*
+* Push a list of dirty rectangles in one chip select frame.
+*    Each is clipped;  empty ones are skipped.
+*    Overlapping rectangles are sent more than once;  the caller may merge
+*    them into a bounding rectangle first.
+* call:
+*    self.push_dirty( fb, stride, rv, n )
+*    rv  = array of rectangles
+*    n   = number of rectangles
+* return:
+*    ()  = number of pixels sent
+*/
+uint32_t
+rgSpi0Lossi::push_dirty(
+    const uint32_t	*fb,
+    uint32_t		stride,
+    const Rect		*rv,
+    uint32_t		n
+)
+{
+    uint32_t		npix   = 0;
+    bool		opened = 0;
+
+    WordCnt = 0;
+    PollCnt = 0;
+
+    for ( uint32_t ii=0;  ii < n;  ii++ )
+    {
+	Rect		rx = rv[ii];
+
+	if ( ! clip_rect( rx ) ) {
+	    continue;
+	}
+
+	if ( ! opened ) {
+	    begin();
+	    opened = 1;
+	}
+
+	put_rect( fb, stride, rx );
+	npix += rx.W * rx.H;
+    }
+
+    if ( opened ) {
+	end();
+    }
+
+    return  npix;
+}
+
@@ -0,0 +1,111 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgSpi0Lossi_P
+#define rgSpi0Lossi_P
+
+#include "rgSpi0.h"
+
+//--------------------------------------------------------------------------
+// rgSpi0Lossi - LoSSI display panel streaming on SPI0
+//--------------------------------------------------------------------------
+// LoSSI sends 9-bit words, bit [8] is D/C:  0= command, 1= parameter/data.
+// Window and memory write use MIPI DCS commands CASET, RASET, RAMWR.
+// Framebuffer pixels are RGB888 words 0x00rrggbb, converted a row at a
+// time to the panel format.
+
+class rgSpi0Lossi {
+  public:
+    enum PixFmt {
+	pix_RGB565 = 0,		// 2 bytes per pixel
+	pix_RGB666 = 1,		// 3 bytes per pixel, 6 bits left aligned
+    };
+
+    struct Rect {
+	uint32_t	X;		// left column
+	uint32_t	Y;		// top row
+	uint32_t	W;		// width,  0= empty
+	uint32_t	H;		// height, 0= empty
+    };
+
+    static const uint32_t	MaxWidth  = 1024;	// pixels per row
+
+    static const uint8_t	Dcs_CASET = 0x2a;	// column address set
+    static const uint8_t	Dcs_RASET = 0x2b;	// row address set
+    static const uint8_t	Dcs_RAMWR = 0x2c;	// memory write
+
+  private:
+    rgSpi0		*Spi;		// SPI0 unit
+    uint32_t		Width;		// panel width,  pixels
+    uint32_t		Height;		// panel height, pixels
+    PixFmt		Fmt;		// panel pixel format
+
+    uint32_t		WordCnt;	// Fifo words written, last operation
+    uint32_t		PollCnt;	// CntlStat reads, last operation
+    uint32_t		InFlight;	// words written, not yet read from Rx
+
+    uint16_t		RowBuf[3 * MaxWidth];	// one row of 9-bit words
+
+  public:
+    rgSpi0Lossi(		// constructor
+	rgSpi0		*spx,
+	uint32_t	width,
+	uint32_t	height
+    );
+
+    inline void		config_PixFmt( PixFmt v )  { Fmt = v; }
+    inline PixFmt	config_PixFmt()            { return  Fmt; }
+
+    inline uint32_t	get_Width()     { return  Width; }
+    inline uint32_t	get_Height()    { return  Height; }
+    inline uint32_t	get_WordCnt()   { return  WordCnt; }
+    inline uint32_t	get_PollCnt()   { return  PollCnt; }
+
+    void		send_cmd(
+			    uint8_t		cmd,
+			    const uint8_t	*param = 0,
+			    uint32_t		n      = 0
+			);
+
+    uint32_t		push_rect(
+			    const uint32_t	*fb,
+			    uint32_t		stride,
+			    Rect		rx
+			);
+
+    uint32_t		push_dirty(
+			    const uint32_t	*fb,
+			    uint32_t		stride,
+			    const Rect		*rv,
+			    uint32_t		n
+			);
+
+    bool		clip_rect( Rect&  rx );
+
+		// Pixel row conversion, return number of words
+    static uint32_t	pack_rgb565(
+			    const uint32_t	*src,
+			    uint16_t		*dst,
+			    uint32_t		n
+			);
+    static uint32_t	pack_rgb666(
+			    const uint32_t	*src,
+			    uint16_t		*dst,
+			    uint32_t		n
+			);
+
+  private:
+    void		begin();
+    void		end();
+    void		drain_rx();
+    void		put_words( const uint16_t  *wv,  uint32_t  n );
+    void		put_cmd(
+			    uint8_t		cmd,
+			    const uint8_t	*param,
+			    uint32_t		n
+			);
+    void		put_rect( const uint32_t  *fb,  uint32_t  stride,
+				  Rect&  rx );
+};
+
+#endif
+
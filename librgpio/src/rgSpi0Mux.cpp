@@ -0,0 +1,280 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgSpi0Mux - Concurrent transfers on several SPI0 units, one thread
+//
+// See:  doc/spi0_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+
+#include "rgSpi0Mux.h"
+
+/*
+* Constructor.
+*    No units.
+* call:
+*    rgSpi0Mux		mux;
+*/
+rgSpi0Mux::rgSpi0Mux()
+{
+    clear();
+}
+
+
+//--------------------------------------------------------------------------
+// Setup
+//--------------------------------------------------------------------------
+
+/*
+* Add a transfer on one unit.
+*    Each unit may appear only once.  Buffers must remain valid until done.
+* call:
+*    self.add_xfer( &spx, tx, rx, n )
+*    spx = SPI0 unit object
+*    tx  = Tx data, NULL= send FillByte of the unit
+*    rx  = Rx data buffer, NULL= discard
+*    n   = number of bytes
+* return:
+*    ()  = index of this unit, for statistics
+* exceptions:
+*    range_error if full, or unit already added
+*/
+uint32_t
+rgSpi0Mux::add_xfer(
+    rgSpi0		*spx,
+    const uint8_t	*tx,
+    uint8_t		*rx,
+    size_t		n
+)
+{
+    if ( NumUnit >= MaxUnit ) {
+	std::ostringstream	css;
+	css << "rgSpi0Mux::add_xfer():  exceeds MaxUnit:  " << MaxUnit;
+	throw std::range_error ( css.str() );
+    }
+
+    for ( uint32_t ii=0;  ii < NumUnit;  ii++ )
+    {
+	if ( Unit[ii].Spi->get_base_addr() == spx->get_base_addr() ) {
+	    std::ostringstream	css;
+	    css << "rgSpi0Mux::add_xfer():  duplicate spi unit:  "
+		<< spx->get_unit_num();
+	    throw std::range_error ( css.str() );
+	}
+    }
+
+    Slot&	ux = Unit[NumUnit];
+
+    ux.Spi      = spx;
+    ux.Tx       = tx;
+    ux.Rx       = rx;
+    ux.Len      = n;
+    ux.StallCnt = 0;
+    ux.Active   = 0;
+
+    return  NumUnit++;
+}
+
+
+/*
+* Remove all units.
+*/
+void
+rgSpi0Mux::clear()
+{
+    NumUnit = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Transfer
+//--------------------------------------------------------------------------
+
+/*
+* Start transfers on all units.
+*    Each unit clears its Fifos and asserts chip select.
+*/
+void
+rgSpi0Mux::start_all()
+{
+    for ( uint32_t ii=0;  ii < NumUnit;  ii++ )
+    {
+	Slot&	ux = Unit[ii];
+
+	ux.Spi->start_xfer( ux.Tx, ux.Rx, ux.Len );
+	ux.StallCnt = 0;
+	ux.Active   = 1;
+    }
+}
+
+
+/*
+* Service all active units, one pass each.
+*    A unit that completes has its chip select released.
+*    A pass that moves no bytes counts as a stall (Fifo not ready).
+* call:
+*    self.service_all()
+* return:
+*    ()  = number of units still active
+*/
+uint32_t
+rgSpi0Mux::service_all()
+{
+    uint32_t		active = 0;
+
+    for ( uint32_t ii=0;  ii < NumUnit;  ii++ )
+    {
+	Slot&	ux = Unit[ii];
+
+	if ( ! ux.Active ) {
+	    continue;
+	}
+
+	rgSpi0		*spx   = ux.Spi;
+	size_t		before = spx->get_XferTxCnt() + spx->get_XferRxCnt();
+
+	if ( spx->service_xfer() ) {
+	    spx->end_xfer();
+	    ux.Active = 0;
+	    continue;
+	}
+
+	if ( spx->get_XferTxCnt() + spx->get_XferRxCnt() == before ) {
+	    ux.StallCnt++;
+	}
+
+	active++;
+    }
+
+    return  active;
+}
+
+
+/*
+* End transfers on all units still active.
+*    Abandons incomplete transfers, releasing chip select.
+*/
+void
+rgSpi0Mux::end_all()
+{
+    for ( uint32_t ii=0;  ii < NumUnit;  ii++ )
+    {
+	if ( Unit[ii].Active ) {
+	    Unit[ii].Spi->end_xfer();
+	    Unit[ii].Active = 0;
+	}
+    }
+}
+
+
+/*
+* Run all transfers to completion, blocking.
+* return:
+*    ()  = total bytes received on all units
+*/
+size_t
+rgSpi0Mux::run()
+{
+    start_all();
+
+    while ( service_all() ) {
+    }
+
+    return  get_TotalCnt();
+}
+
+
+//--------------------------------------------------------------------------
+// Statistics
+//--------------------------------------------------------------------------
+
+/*
+* Check index is in use.
+* exceptions:
+*    range_error if not
+*/
+void
+rgSpi0Mux::check_index(
+    const char		*fn,
+    uint32_t		ii
+)
+{
+    if ( ii >= NumUnit ) {
+	std::ostringstream	css;
+	css << "rgSpi0Mux::" << fn << "():  index exceeds NumUnit:  " << ii;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Get bytes received on one unit.
+* call:
+*    self.get_ByteCnt( ii )
+*    ii  = index returned by add_xfer()
+* exceptions:
+*    range_error if index not in use
+*/
+size_t
+rgSpi0Mux::get_ByteCnt(
+    uint32_t		ii
+)
+{
+    check_index( "get_ByteCnt", ii );
+    return  Unit[ii].Spi->get_XferRxCnt();
+}
+
+
+/*
+* Get CntlStat reads on one unit.
+*/
+uint32_t
+rgSpi0Mux::get_PollCnt(
+    uint32_t		ii
+)
+{
+    check_index( "get_PollCnt", ii );
+    return  Unit[ii].Spi->get_PollCnt();
+}
+
+
+/*
+* Get stall count on one unit, service passes that moved no bytes.
+*/
+uint32_t
+rgSpi0Mux::get_StallCnt(
+    uint32_t		ii
+)
+{
+    check_index( "get_StallCnt", ii );
+    return  Unit[ii].StallCnt;
+}
+
+
+/*
+* Get total bytes received on all units.
+*/
+size_t
+rgSpi0Mux::get_TotalCnt()
+{
+    size_t		sum = 0;
+
+    for ( uint32_t ii=0;  ii < NumUnit;  ii++ )
+    {
+	sum += Unit[ii].Spi->get_XferRxCnt();
+    }
+
+    return  sum;
+}
+
@@ -0,0 +1,67 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgSpi0Mux_P
+#define rgSpi0Mux_P
+
+#include "rgSpi0.h"
+
+//--------------------------------------------------------------------------
+// rgSpi0Mux - Concurrent transfers on several SPI0 units, one thread
+//--------------------------------------------------------------------------
+// Each rgSpi0 unit {0,3,4,5,6} on RPi4 has its own Fifo and clock, so
+// transfers on different units can run at the same time.  One polling loop
+// round-robins rgSpi0::service_xfer() over all active units.
+//
+// e.g.
+//    rgSpi0Mux		mux;
+//    mux.add_xfer( &spi3, tx3, rx3, 512 );
+//    mux.add_xfer( &spi4, tx4, rx4, 512 );
+//    mux.run();
+
+class rgSpi0Mux {
+  public:
+    static const uint32_t	MaxUnit = 5;	// units {0,3,4,5,6}
+
+  private:
+    struct Slot {
+	rgSpi0		*Spi;		// unit object
+	const uint8_t	*Tx;		// Tx data, NULL= FillByte
+	uint8_t		*Rx;		// Rx data, NULL= discard
+	size_t		Len;		// bytes in transfer
+	uint32_t	StallCnt;	// service passes with no progress
+	bool		Active;		// started, not yet done
+    };
+
+    Slot		Unit[MaxUnit];
+    uint32_t		NumUnit;	// number of Unit[] in use
+
+  public:
+    rgSpi0Mux();			// constructor
+
+    uint32_t		add_xfer(
+			    rgSpi0		*spx,
+			    const uint8_t	*tx,
+			    uint8_t		*rx,
+			    size_t		n
+			);
+    void		clear();
+
+    void		start_all();
+    uint32_t		service_all();
+    void		end_all();
+
+    size_t		run();
+
+		// Statistics, index in order of add_xfer()
+    inline uint32_t	get_NumUnit()   { return  NumUnit; }
+    size_t		get_ByteCnt(  uint32_t ii );
+    uint32_t		get_PollCnt(  uint32_t ii );
+    uint32_t		get_StallCnt( uint32_t ii );
+    size_t		get_TotalCnt();
+
+  private:
+    void		check_index( const char* fn,  uint32_t ii );
+};
+
+#endif
+
@@ -0,0 +1,178 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgSpi0Queue - Batched small transactions on one SPI0 unit
+//
+// See:  doc/spi0_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+
+#include "rgSpi0Queue.h"
+
+					// CntlStat bits
+static const uint32_t	Spi0_TxEmpty     = 1 << 16;	// DONE
+static const uint32_t	Spi0_RunActive   = 1 <<  7;	// TA
+static const uint32_t	Spi0_ClearFifo   = 3 <<  4;	// CLEAR
+static const uint32_t	Spi0_ChipSelect  = 3 <<  0;	// CS
+
+/*
+* Constructor.
+* call:
+*    rgSpi0Queue	qx  ( &spx );
+*    spx = SPI0 unit object
+*/
+rgSpi0Queue::rgSpi0Queue(
+    rgSpi0		*spx
+)
+{
+    Spi      = spx;
+    Reorder  = 0;
+    XactCnt  = 0;
+    FrameCnt = 0;
+    PollCnt  = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Run queue
+//--------------------------------------------------------------------------
+
+/*
+* Run transactions back-to-back, blocking.
+*    All descriptors are checked before any hardware access.
+*    With Reorder, transactions run grouped by Cs (0 first), keeping their
+*    order within each Cs, so Merge can join more of them.
+*    CntlStat is restored to its original value at the end (RunActive_1=0).
+* call:
+*    self.run( xv, n )
+*    xv  = array of transaction descriptors
+*    n   = number of descriptors
+* return:
+*    ()  = number of transactions done
+* exceptions:
+*    range_error if Cs exceeds 3, or a frame exceeds FifoDepth
+*/
+uint32_t
+rgSpi0Queue::run(
+    rgSpi0_Xact		*xv,
+    uint32_t		n
+)
+{
+    for ( uint32_t ii=0;  ii < n;  ii++ )
+    {
+	if ( xv[ii].Cs > 3 ) {
+	    std::ostringstream	css;
+	    css << "rgSpi0Queue::run():  Cs exceeds 3 in xv[" << ii << "]:  "
+		<< xv[ii].Cs;
+	    throw std::range_error ( css.str() );
+	}
+
+	if ( xv[ii].TxLen + xv[ii].RxLen > rgSpi0::FifoDepth ) {
+	    std::ostringstream	css;
+	    css << "rgSpi0Queue::run():  frame exceeds FifoDepth in xv["
+		<< ii << "]:  " << (xv[ii].TxLen + xv[ii].RxLen);
+	    throw std::range_error ( css.str() );
+	}
+    }
+
+    XactCnt  = 0;
+    FrameCnt = 0;
+    PollCnt  = 0;
+
+    uint32_t	orig = Spi->CntlStat.read();	// the only read-modify-write
+    uint32_t	base = orig & ~(Spi0_ChipSelect | Spi0_RunActive |
+				Spi0_ClearFifo);
+
+    Spi->CntlStat.write( base | Spi0_ClearFifo );	// start with empty Fifos
+
+    bool	open   = 0;		// frame is open (RunActive_1=1)
+    uint32_t	opencs = 0;		// Cs of open frame
+
+    uint32_t	cs_lo  = 0;		// Cs pass range
+    uint32_t	cs_hi  = Reorder ? 3 : 0;
+
+    for ( uint32_t pass = cs_lo;  pass <= cs_hi;  pass++ )
+    {
+	for ( uint32_t ii=0;  ii < n;  ii++ )
+	{
+	    rgSpi0_Xact&	xx = xv[ii];
+
+	    if ( Reorder && (xx.Cs != pass) ) {
+		continue;
+	    }
+
+	    if ( open && !( xx.Merge && (xx.Cs == opencs) ) ) {
+		Spi->CntlStat.write( base | opencs );		// end frame
+		open = 0;
+	    }
+
+	    if ( ! open ) {
+		Spi->CntlStat.write( base | xx.Cs | Spi0_RunActive );
+		open   = 1;
+		opencs = xx.Cs;
+		FrameCnt++;
+	    }
+
+	    do_xact( xx );
+	    XactCnt++;
+	}
+    }
+
+    Spi->CntlStat.write( orig & ~(Spi0_RunActive | Spi0_ClearFifo) );
+
+    return  XactCnt;
+}
+
+
+/*
+* Do one transaction in an open frame.
+*    Frame fits in Fifo, which is empty on entry and on return.
+*/
+void
+rgSpi0Queue::do_xact(
+    rgSpi0_Xact&	xx
+)
+{
+    uint8_t		fill = Spi->config_FillByte();
+
+    for ( uint32_t i=0;  i < xx.TxLen;  i++ )
+    {
+	Spi->Fifo.write( xx.Tx ? xx.Tx[i] : fill );
+    }
+
+    for ( uint32_t i=0;  i < xx.RxLen;  i++ )
+    {
+	Spi->Fifo.write( fill );
+    }
+
+    if ( xx.TxLen + xx.RxLen == 0 ) {
+	return;
+    }
+
+    do {
+	PollCnt++;
+    } while ( ! (Spi->CntlStat.read() & Spi0_TxEmpty) );
+
+    for ( uint32_t i=0;  i < xx.TxLen;  i++ )
+    {
+	Spi->Fifo.read();
+    }
+
+    for ( uint32_t i=0;  i < xx.RxLen;  i++ )
+    {
+	uint8_t		vv = Spi->Fifo.read();
+	if ( xx.Rx ) { xx.Rx[i] = vv; }
+    }
+}
+
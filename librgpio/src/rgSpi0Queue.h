@@ -0,0 +1,66 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgSpi0Queue_P
+#define rgSpi0Queue_P
+
+#include "rgSpi0.h"
+
+//--------------------------------------------------------------------------
+// rgSpi0Queue - Batched small transactions on one SPI0 unit
+//--------------------------------------------------------------------------
+// Each transaction is one chip select frame:  write TxLen bytes, then clock
+// RxLen more bytes (sending FillByte) into Rx.  A whole frame fits in the
+// Fifo, so it is written in one burst, then one wait for TxEmpty_1.
+// CntlStat is read once per run();  each frame then costs two CntlStat
+// writes (start, end) with no read-modify-write.
+//
+// e.g.
+//    rgSpi0_Xact	xv[] = {
+//	// Cs  Tx    TxLen  Rx    RxLen  Merge
+//	{  0,  cmdA, 2,     rxA,  2,     0 },
+//	{  1,  cmdB, 1,     rxB,  4,     0 },
+//    };
+//    rgSpi0Queue	qx  ( &spx );
+//    qx.run( xv, 2 );
+
+struct rgSpi0_Xact {
+    uint32_t		Cs;		// ChipSelectN_2 {0..3}
+    const uint8_t	*Tx;		// Tx data, NULL= FillByte
+    uint32_t		TxLen;		// Tx bytes, Rx discarded
+    uint8_t		*Rx;		// Rx data, NULL= discard
+    uint32_t		RxLen;		// Rx bytes, clocked after Tx
+    bool		Merge;		// 1= may share frame with previous
+					//    transaction on the same Cs
+};
+
+
+class rgSpi0Queue {
+  private:
+    rgSpi0		*Spi;		// SPI0 unit
+    bool		Reorder;	// 1= group transactions by Cs
+
+    uint32_t		XactCnt;	// transactions done, last run()
+    uint32_t		FrameCnt;	// chip select frames, last run()
+    uint32_t		PollCnt;	// CntlStat reads, last run()
+
+  public:
+    rgSpi0Queue( rgSpi0  *spx );	// constructor
+
+    inline void		config_Reorder( bool v )  { Reorder = v; }
+    inline bool		config_Reorder()          { return  Reorder; }
+
+    uint32_t		run(
+			    rgSpi0_Xact		*xv,
+			    uint32_t		n
+			);
+
+    inline uint32_t	get_XactCnt()   { return  XactCnt; }
+    inline uint32_t	get_FrameCnt()  { return  FrameCnt; }
+    inline uint32_t	get_PollCnt()   { return  PollCnt; }
+
+  private:
+    void		do_xact( rgSpi0_Xact& xx );
+};
+
+#endif
+
@@ -12,6 +12,7 @@
 #include <sstream>	// std::ostringstream
 #include <string>
 #include <stdexcept>
+#include <atomic>
 
 using namespace std;
 
@@ -62,6 +63,19 @@ rgUniSpi::rgUniSpi(
      Peek.init_addr( GpioBase + delta +  Peek_offset );
      Fifo.init_addr( GpioBase + delta +  Fifo_offset );
     FifoH.init_addr( GpioBase + delta + FifoH_offset );
+
+    XferLen     = 0;
+    TxCnt       = 0;
+    RxCnt       = 0;
+    InFlight    = 0;
+    PollCnt     = 0;
+    FillByte    = 0x00;
+
+    WordBytes   = 1;
+    VarWidth    = 0;
+    OutMsb      = 0;
+    InMsb       = 0;
+    CsBits      = 0;
 }
 
 //--------------------------------------------------------------------------
@@ -92,23 +106,496 @@ rgUniSpi::read_SpiEnable_1()
 
 /*
 * Write the SPI Access Enable bit.
-*    Direct register read/modify/write, not Atomic.
+*    Read/modify/write serialized by write_AuxEn_mask().
 */
 void
 rgUniSpi::write_SpiEnable_1( uint32_t  val )
 {
-    volatile uint32_t*		addr;
-    uint32_t			mask;
+    write_AuxEn_mask( (0x1 << SpiNum), (val ? (0x1 << SpiNum) : 0) );
+}
+
+
+/*
+* Lock for AuxEn read/modify/write.
+*    Shared by all rgUniSpi objects in the process, since Spi1 and Spi2
+*    (and the Mini UART) share one AuxEn register.
+*    Does not protect against other processes or the kernel.
+*/
+static std::atomic_flag		AuxEn_lock = ATOMIC_FLAG_INIT;
+
+
+/*
+* Write several AuxEn bits in one read/modify/write.
+*    Serialized with a spin lock, so threads driving Spi1 and Spi2 do not
+*    lose each other's enable bits.  The lock is held only for the one
+*    register read and write.
+*    e.g. enable both SPIs at once:  write_AuxEn_mask( 0x6, 0x6 )
+* call:
+*    self.write_AuxEn_mask( mask, val )
+*    mask = bits to modify, {0..7}
+*    val  = new bit values, only bits in mask are used
+* exceptions:
+*    range_error  mask exceeds 0x7
+*/
+void
+rgUniSpi::write_AuxEn_mask(
+    uint32_t		mask,
+    uint32_t		val
+)
+{
+    if ( mask > 0x7 ) {
+	std::ostringstream	css;
+	css << "rgUniSpi::write_AuxEn_mask():  mask exceeds 0x7:  0x"
+	    << hex << mask;
+	throw std::range_error ( css.str() );
+    }
+
+    volatile uint32_t*		addr = AuxEn.addr();
+
+    while ( AuxEn_lock.test_and_set( std::memory_order_acquire ) ) {
+    }
+
+    *addr = (*addr & ~mask) | (val & mask);
+
+    AuxEn_lock.clear( std::memory_order_release );
+}
+
+//--------------------------------------------------------------------------
+// Streaming transfer engine
+//--------------------------------------------------------------------------
+// Full-duplex byte stream transfer, split into Fifo words.
+// Every word but the last is written to FifoH (hold CS), the last to Fifo
+// (release CS), making one chip select frame of any length.
+// Word size comes from the current Cntl0/Cntl1 configuration:
+//    VariableWidth_1=0:  ShiftLength_6 bits {8,16,24,32}, n a multiple of it.
+//    VariableWidth_1=1:  24-bit words, the last word shortened to fit n.
+// Words in flight (written to Tx, not yet read from Rx) are limited to
+// FifoDepth, so the Rx Fifo can never overflow.
+// Tx and Rx bytes are walked through rgIoVec cursors, so a word may span
+// two segments of a scatter/gather list (start_xferv()), with no copy.
+// Each service_xfer() pass reads Stat exactly once.
+
+					// Stat fields
+static const uint32_t	USpi_RxLevel_pos  = 20;
+static const uint32_t	USpi_Level_mask   = 0x7;
+static const uint32_t	USpi_RxEmpty      = 1 << 7;
+
+
+/*
+* Full-duplex transfer, blocking until all bytes are received.
+*    One chip select frame.  Configuration registers are unchanged.
+* call:
+*    self.transfer( tx, rx, n )
+*    tx  = Tx data, NULL= send FillByte (Rx-only)
+*    rx  = Rx data buffer, NULL= discard (Tx-only)
+*    n   = number of bytes
+* return:
+*    ()  = number of bytes transferred, n
+* exceptions:
+*    range_error  from start_xfer()
+*/
+size_t
+rgUniSpi::transfer(
+    const uint8_t	*tx,
+    uint8_t		*rx,
+    size_t		n
+)
+{
+    start_xfer( tx, rx, n );
+
+    while ( ! service_xfer() ) {
+    }
+
+    return  RxCnt;
+}
+
+
+/*
+* Start a transfer.
+*    Read Cntl0, Cntl1 to derive the word format.  No data is moved.
+*    Buffers must remain valid until is_xfer_done().
+*    The Fifos are assumed empty (e.g. after ClearFifos_1).
+* call:
+*    self.start_xfer( tx, rx, n )
+*    tx  = Tx data, NULL= send FillByte
+*    rx  = Rx data buffer, NULL= discard
+*    n   = number of bytes, 0 is done immediately
+* exceptions:
+*    range_error  ShiftLength_6 not in {8,16,24,32}
+*    range_error  n not a multiple of the word size
+*/
+void
+rgUniSpi::start_xfer(
+    const uint8_t	*tx,
+    uint8_t		*rx,
+    size_t		n
+)
+{
+    begin_xfer( "start_xfer", n );
+
+    TxOne.iov_base = (void*) tx;	// NULL segment is fill/discard
+    TxOne.iov_len  = n;
+    RxOne.iov_base = rx;
+    RxOne.iov_len  = n;
+
+    XferTx.init( &TxOne, 1 );
+    XferRx.init( &RxOne, 1 );
+}
+
+
+/*
+* Full-duplex scatter/gather transfer, blocking until all bytes are received.
+*    As transfer(), with Tx and Rx each a list of segments walked directly
+*    by pack_word() and unpack_word().  Segments need not be whole words.
+* call:
+*    self.transferv( txv, ntx, rxv, nrx )
+*    txv = Tx segment list, NULL base= send FillByte
+*    ntx = number of Tx segments
+*    rxv = Rx segment list, NULL base= discard
+*    nrx = number of Rx segments
+* return:
+*    ()  = number of bytes transferred, larger of the Tx and Rx totals
+* exceptions:
+*    range_error  from start_xferv()
+*/
+size_t
+rgUniSpi::transferv(
+    const struct iovec	*txv,
+    uint32_t		ntx,
+    const struct iovec	*rxv,
+    uint32_t		nrx
+)
+{
+    start_xferv( txv, ntx, rxv, nrx );
+
+    while ( ! service_xfer() ) {
+    }
+
+    return  RxCnt;
+}
+
+
+/*
+* Start a scatter/gather transfer.
+*    Length is the larger of the Tx and Rx totals.  A shorter Tx list is
+*    padded with FillByte, a shorter Rx list discards the rest.
+*    Segment lists and buffers must remain valid until is_xfer_done().
+* call:
+*    self.start_xferv( txv, ntx, rxv, nrx )
+*    Arguments are as for transferv().
+* exceptions:
+*    range_error  ShiftLength_6 not in {8,16,24,32}
+*    range_error  length not a multiple of the word size
+*/
+void
+rgUniSpi::start_xferv(
+    const struct iovec	*txv,
+    uint32_t		ntx,
+    const struct iovec	*rxv,
+    uint32_t		nrx
+)
+{
+    size_t		ntot = rgIoVec::total( txv, ntx );
+    size_t		nrot = rgIoVec::total( rxv, nrx );
+
+    begin_xfer( "start_xferv", (ntot > nrot) ? ntot : nrot );
+
+    XferTx.init( txv, ntx );
+    XferRx.init( rxv, nrx );
+}
+
+
+/*
+* Begin a transfer of n bytes.
+*    Read Cntl0, Cntl1 to derive the word format, reset counts.
+* exceptions:
+*    range_error  ShiftLength_6 not in {8,16,24,32}
+*    range_error  n not a multiple of the word size
+*/
+void
+rgUniSpi::begin_xfer(
+    const char		*fn,
+    size_t		n
+)
+{
+    Cntl0.grab();
+    Cntl1.grab();
+
+    VarWidth = Cntl0.get_VariableWidth_1();
+    OutMsb   = Cntl0.get_OutMsbFirst_1();
+    InMsb    = Cntl1.get_InMsbFirst_1();
+    CsBits   = 0;
 
-    addr = AuxEn.addr();
+    if ( Cntl0.get_VariableCs_1() ) {
+	CsBits = Cntl0.get_ChipSelects_3() << 29;
+    }
 
-    if ( val ) {
-	mask =   0x1 << SpiNum;
-	*addr |= mask;
+    if ( VarWidth ) {
+	WordBytes = 3;
     }
     else {
-	mask = ~(0x1 << SpiNum);
-	*addr &= mask;
+	uint32_t	len = Cntl0.get_ShiftLength_6();
+
+	if ( (len == 0) || (len > 32) || (len & 0x7) ) {
+	    std::ostringstream	css;
+	    css << "rgUniSpi::" << fn
+		<< "():  ShiftLength_6 requires {8,16,24,32}:  " << len;
+	    throw std::range_error ( css.str() );
+	}
+
+	WordBytes = len >> 3;
+
+	if ( n % WordBytes ) {
+	    std::ostringstream	css;
+	    css << "rgUniSpi::" << fn << "():  n not a multiple of "
+		<< WordBytes << " bytes:  " << n;
+	    throw std::range_error ( css.str() );
+	}
+    }
+
+    XferLen     = n;
+    TxCnt       = 0;
+    RxCnt       = 0;
+    InFlight    = 0;
+    PollCnt     = 0;
+}
+
+
+/*
+* Service a started transfer, one pass.
+*    Non-blocking;  call repeatedly until it returns true.
+*    Read Stat once, read every available Rx word, then refill Tx up to
+*    FifoDepth words in flight.
+*    Rx data is always read (even when discarded), since a full Rx Fifo
+*    stops the transfer.
+* call:
+*    self.service_xfer()
+* return:
+*    ()  = true when all n bytes are received
+*/
+bool
+rgUniSpi::service_xfer()
+{
+    if ( RxCnt >= XferLen ) {
+	return  1;
+    }
+
+    uint32_t		st = Stat.read();		// one status read
+    PollCnt++;
+
+    uint32_t		rxlev = (st >> USpi_RxLevel_pos) & USpi_Level_mask;
+
+    if ( (rxlev == 0) && !(st & USpi_RxEmpty) ) {
+	rxlev = 1;
+    }
+
+    while ( rxlev && InFlight ) {
+	size_t		nb = XferLen - RxCnt;
+	if ( nb > WordBytes ) {
+	    nb = WordBytes;
+	}
+
+	unpack_word( Fifo.read(), nb );
+	rxlev--;
+	InFlight--;
+    }
+
+    while ( (InFlight < FifoDepth) && (TxCnt < XferLen) ) {
+	size_t		nb = XferLen - TxCnt;
+	if ( nb > WordBytes ) {
+	    nb = WordBytes;
+	}
+
+	uint32_t	vv = pack_word( nb );
+
+	if ( TxCnt < XferLen ) {
+	    FifoH.write( vv );		// hold CS
+	}
+	else {
+	    Fifo.write( vv );		// last word, release CS
+	}
+	InFlight++;
+    }
+
+    return  ( RxCnt >= XferLen );
+}
+
+
+/*
+* Pack the next Tx bytes into one Fifo word.
+*    Whole bytes are shifted into place, no per-bit operations.
+*    OutMsbFirst_1=1:  first byte most significant, left justified at
+*        bit 31 (or bit 23 with VariableWidth_1).
+*    OutMsbFirst_1=0:  first byte least significant, right justified at bit 0.
+* call:
+*    self.pack_word( nb )
+*    nb  = number of bytes in the word {1..4}
+* return:
+*    ()  = Fifo word, TxCnt advanced by nb
+*/
+uint32_t
+rgUniSpi::pack_word( size_t  nb )
+{
+    uint32_t		vv = 0;
+    uint32_t		nbits = nb << 3;
+
+    for ( size_t ii = 0;  ii < nb;  ii++ ) {
+	uint32_t	bb = XferTx.get( FillByte );
+	TxCnt++;
+
+	if ( OutMsb ) {
+	    vv = (vv << 8) | bb;
+	}
+	else {
+	    vv |= bb << (ii << 3);
+	}
+    }
+
+    if ( VarWidth ) {
+	if ( OutMsb ) {
+	    vv <<= (24 - nbits);
+	}
+	vv |= (nbits << 24) | CsBits;
+    }
+    else if ( OutMsb && (nbits < 32) ) {
+	vv <<= (32 - nbits);
+    }
+
+    return  vv;
+}
+
+
+/*
+* Unpack one Rx Fifo word into the next Rx bytes.
+*    InMsbFirst_1=1:  data shifted left into bit 0;  mask the low nbits.
+*    InMsbFirst_1=0:  data shifted right into bit 31;  take the high nbits.
+*    Either way, bits left over from earlier words with KeepInput_1=1 are
+*    discarded by the same mask/shift.
+* call:
+*    self.unpack_word( vv, nb )
+*    vv  = Rx Fifo word
+*    nb  = number of bytes in the word {1..4}
+*    RxCnt is advanced by nb
+*/
+void
+rgUniSpi::unpack_word(
+    uint32_t		vv,
+    size_t		nb
+)
+{
+    uint32_t		nbits = nb << 3;
+
+    if ( nbits < 32 ) {
+	if ( InMsb ) {
+	    vv &= (0x1u << nbits) - 1;
+	}
+	else {
+	    vv >>= (32 - nbits);
+	}
+    }
+
+    for ( size_t ii = 0;  ii < nb;  ii++ ) {
+	if ( InMsb ) {
+	    XferRx.put( vv >> ((nb - 1 - ii) << 3) );
+	}
+	else {
+	    XferRx.put( vv >> (ii << 3) );
+	}
+	RxCnt++;
+    }
+}
+
+
+/*
+* Transfer whole Fifo words, blocking until all are received.
+*    Words are written as given, e.g. packed by rgUniSpiPack with
+*    VariableWidth_1 and VariableCs_1 fields.  Same polling as
+*    service_xfer():  one Stat read per pass, up to FifoDepth in flight.
+*    get_PollCnt() gives the Stat reads.
+* call:
+*    self.xfer_words( tx, rx, n, hold )
+*    tx   = Tx words
+*    rx   = Rx words, NULL= discard
+*    n    = number of words
+*    hold = 1: FifoH for all but the last word (one CS frame)
+*           0: Fifo for every word (one CS frame per word)
+* return:
+*    ()  = number of words transferred, n
+*/
+size_t
+rgUniSpi::xfer_words(
+    const uint32_t	*tx,
+    uint32_t		*rx,
+    size_t		n,
+    bool		hold
+)
+{
+    size_t		nt = 0;		// words written
+    size_t		nr = 0;		// words read
+
+    PollCnt = 0;
+
+    while ( nr < n ) {
+	uint32_t	st = Stat.read();		// one status read
+	PollCnt++;
+
+	uint32_t	rxlev = (st >> USpi_RxLevel_pos) & USpi_Level_mask;
+
+	if ( (rxlev == 0) && !(st & USpi_RxEmpty) ) {
+	    rxlev = 1;
+	}
+
+	while ( rxlev && (nr < nt) ) {
+	    uint32_t	vv = Fifo.read();
+	    if ( rx ) { rx[nr] = vv; }
+	    nr++;
+	    rxlev--;
+	}
+
+	while ( ((nt - nr) < FifoDepth) && (nt < n) ) {
+	    if ( hold && (nt + 1 < n) ) {
+		FifoH.write( tx[nt] );		// hold CS
+	    }
+	    else {
+		Fifo.write( tx[nt] );
+	    }
+	    nt++;
+	}
+    }
+
+    return  nr;
+}
+
+
+/*
+* Service started transfers on two units until both are done.
+*    Alternates one service_xfer() pass on each, so both Fifos are kept
+*    full from one thread.  Start each with start_xfer() first.
+* call:
+*    rgUniSpi::service_pair( &spa, &spb )
+*    spa, spb = objects for different SPI units
+* exceptions:
+*    range_error  both objects are the same SPI unit
+*/
+void
+rgUniSpi::service_pair(
+    rgUniSpi		*spa,
+    rgUniSpi		*spb
+)
+{
+    if ( spa->SpiNum == spb->SpiNum ) {
+	std::ostringstream	css;
+	css << "rgUniSpi::service_pair():  require different spi units:  "
+	    << spa->SpiNum;
+	throw std::range_error ( css.str() );
+    }
+
+    bool		da = spa->is_xfer_done();
+    bool		db = spb->is_xfer_done();
+
+    while ( ! (da && db) ) {
+	if ( ! da ) { da = spa->service_xfer(); }
+	if ( ! db ) { db = spb->service_xfer(); }
     }
 }
 
@@ -4,6 +4,7 @@
 #define rgUniSpi_P
 
 #include "rgRegister.h"
+#include "rgIoVec.h"
 
 //--------------------------------------------------------------------------
 // rGPIO Universal SPI Master class.  Spi1, Spi2
@@ -146,6 +147,25 @@ class rgUniSpi {
 
     uint32_t		SpiNum;		// SPI number {1,2}
 
+				// Transfer engine state
+    rgIoVec		XferTx;		// Tx data cursor
+    rgIoVec		XferRx;		// Rx data cursor
+    struct iovec	TxOne;		// Tx segment of start_xfer()
+    struct iovec	RxOne;		// Rx segment of start_xfer()
+    size_t		XferLen;	// bytes in transfer
+    size_t		TxCnt;		// bytes written to Fifo/FifoH
+    size_t		RxCnt;		// bytes read from Fifo
+    uint32_t		InFlight;	// words written, not yet read
+    uint32_t		PollCnt;	// Stat reads in transfer
+    uint8_t		FillByte;	// Tx byte for NULL or short Tx data
+
+				// Word format, from Cntl0/Cntl1 in start_xfer()
+    uint32_t		WordBytes;	// bytes per full word {1..4}
+    bool		VarWidth;	// VariableWidth_1
+    bool		OutMsb;		// OutMsbFirst_1
+    bool		InMsb;		// InMsbFirst_1
+    uint32_t		CsBits;		// ChipSelects_3 in [31:29], VariableCs_1
+
   public:
 				// Registers
     rgUniSpi_AuxIrq	AuxIrq;		// AUXIRQ  Auxiliary Interrupt Req (RO)
@@ -175,6 +195,9 @@ class rgUniSpi {
     const uint32_t	Fifo_offset      = 0xA0 /4;
     const uint32_t	FifoH_offset     = 0xB0 /4;
 
+  public:
+    static const uint32_t	FifoDepth        = 4;	// words, each of Tx, Rx
+
   public:
     rgUniSpi(			// constructor
 	rgAddrMap	*xx,
@@ -190,6 +213,68 @@ class rgUniSpi {
     uint32_t		read_SpiEnable_1();
     void		write_SpiEnable_1( uint32_t val );
 
+    void		write_AuxEn_mask(
+			    uint32_t	mask,
+			    uint32_t	val
+			);
+
+		// Streaming transfer engine
+    size_t		transfer(
+			    const uint8_t	*tx,
+			    uint8_t		*rx,
+			    size_t		n
+			);
+
+    void		start_xfer(
+			    const uint8_t	*tx,
+			    uint8_t		*rx,
+			    size_t		n
+			);
+
+    size_t		transferv(
+			    const struct iovec	*txv,
+			    uint32_t		ntx,
+			    const struct iovec	*rxv,
+			    uint32_t		nrx
+			);
+
+    void		start_xferv(
+			    const struct iovec	*txv,
+			    uint32_t		ntx,
+			    const struct iovec	*rxv,
+			    uint32_t		nrx
+			);
+
+    bool		service_xfer();
+
+    size_t		xfer_words(
+			    const uint32_t	*tx,
+			    uint32_t		*rx,
+			    size_t		n,
+			    bool		hold
+			);
+
+    static void		service_pair(
+			    rgUniSpi	*spa,
+			    rgUniSpi	*spb
+			);
+
+    inline bool		is_xfer_done()    { return  (RxCnt >= XferLen); }
+    inline size_t	get_XferTxCnt()   { return  TxCnt; }
+    inline size_t	get_XferRxCnt()   { return  RxCnt; }
+    inline uint32_t	get_PollCnt()     { return  PollCnt; }
+    inline uint32_t	get_WordBytes()   { return  WordBytes; }
+
+    inline void		config_FillByte( uint8_t v )  { FillByte = v; }
+    inline uint8_t	config_FillByte()             { return  FillByte; }
+
+  private:
+    void		begin_xfer( const char  *fn,  size_t  n );
+    uint32_t		pack_word(   size_t  nb );
+    void		unpack_word( uint32_t  vv,  size_t  nb );
+
+  public:
+
 		// Object state operations
     void		init_put_reset();
 
@@ -0,0 +1,234 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgUniSpiAdc - Continuous ADC acquisition on rgUniSpi
+//
+// See:  doc/uspi_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+#include "rgSysTimer.h"
+
+#include "rgUniSpiAdc.h"
+
+					// Stat fields
+static const uint32_t	USpi_RxLevel_pos  = 20;
+static const uint32_t	USpi_Level_mask   = 0x7;
+static const uint32_t	USpi_RxEmpty      = 1 << 7;
+
+
+//--------------------------------------------------------------------------
+// rgUniSpiAdc_Ring
+//--------------------------------------------------------------------------
+
+/*
+* Constructor.
+* call:
+*    rgUniSpiAdc_Ring	ring  ( buf, size );
+*    buf  = sample storage, size entries
+*    size = number of entries, power of 2 {2..2^31}
+* exceptions:
+*    range_error  size not a power of 2
+*/
+rgUniSpiAdc_Ring::rgUniSpiAdc_Ring(
+    rgUniSpiAdc_Sample	*buf,
+    uint32_t		size
+)
+{
+    if ( (size < 2) || (size & (size - 1)) ) {
+	std::ostringstream	css;
+	css << "rgUniSpiAdc_Ring:  size requires power of 2:  " << size;
+	throw std::range_error ( css.str() );
+    }
+
+    Buf  = buf;
+    Size = size;
+    Mask = size - 1;
+
+    Head.store( 0 );
+    Tail.store( 0 );
+}
+
+
+/*
+* Discard all entries.
+*    Not safe while a producer or consumer is active.
+*/
+void
+rgUniSpiAdc_Ring::clear()
+{
+    Head.store( 0 );
+    Tail.store( 0 );
+}
+
+
+//--------------------------------------------------------------------------
+// rgUniSpiAdc
+//--------------------------------------------------------------------------
+
+/*
+* Constructor.
+*    Configuration of the SPI unit (speed, width, chip select) is left to
+*    the caller, and is not modified.
+* call:
+*    rgUniSpiAdc	adc  ( &spx, &stx, &ring );
+*    spx  = SPI unit object
+*    stx  = System Timer object
+*    ring = output ring
+*/
+rgUniSpiAdc::rgUniSpiAdc(
+    rgUniSpi		*spx,
+    rgSysTimer		*stx,
+    rgUniSpiAdc_Ring	*ring
+)
+{
+    Spi       = spx;
+    Tmr       = stx;
+    Ring      = ring;
+
+    Cmd       = 0;
+    Bits      = 0;
+
+    StopReq.store( 0 );
+
+    SampleCnt = 0;
+    DropCnt   = 0;
+    PollCnt   = 0;
+}
+
+
+/*
+* Configure result width.
+*    Value is extracted from the Rx word according to Cntl1.InMsbFirst_1,
+*    which also drops older bits kept by KeepInput_1.
+* call:
+*    self.config_Bits( v )
+*    v  = result bits {1..32}, 0= raw Rx word
+* exceptions:
+*    range_error  v exceeds 32
+*/
+void
+rgUniSpiAdc::config_Bits(
+    uint32_t		v
+)
+{
+    if ( v > 32 ) {
+	std::ostringstream	css;
+	css << "rgUniSpiAdc::config_Bits():  requires {0..32}:  " << v;
+	throw std::range_error ( css.str() );
+    }
+
+    Bits = v;
+}
+
+
+/*
+* Run continuous acquisition.
+*    Send Cmd through Fifo (one chip select frame per sample), keeping up to
+*    FifoDepth words in flight.  Each pass reads Stat once;  when Rx words
+*    are available the System Timer low word is read once and extended to
+*    64 bits, and each word is pushed to the ring with that time.
+*    A full ring does not stall acquisition;  the sample is counted in
+*    DropCnt and discarded.
+*    Stops after nsample commands are sent, or at stop(), then drains the
+*    words in flight.
+* call:
+*    self.run( nsample )
+*    nsample = number of samples, 0= until stop()
+* return:
+*    ()  = number of samples pushed to the ring
+*/
+uint64_t
+rgUniSpiAdc::run(
+    uint64_t		nsample
+)
+{
+    uint32_t		mask  = 0xffffffff;
+    uint32_t		shift = 0;
+
+    SampleCnt = 0;
+    DropCnt   = 0;
+    PollCnt   = 0;
+
+    Spi->Cntl1.grab();
+
+    if ( Bits && (Bits < 32) ) {
+	if ( Spi->Cntl1.get_InMsbFirst_1() ) {
+	    mask  = (0x1u << Bits) - 1;		// shifted in at [0]
+	}
+	else {
+	    shift = 32 - Bits;			// shifted in at [31]
+	}
+    }
+
+    uint64_t		t64  = Tmr->TimeDw.grab64();
+    uint64_t		hi   = t64 & 0xffffffff00000000ull;
+    uint32_t		last = t64;
+
+    uint64_t		nt = 0;			// commands sent
+    uint32_t		inflight = 0;
+
+    rgUniSpiAdc_Sample	ss;
+
+    while ( 1 ) {
+	bool		more = ( ! StopReq.load( std::memory_order_relaxed ) )
+			       && ( (nsample == 0) || (nt < nsample) );
+
+	if ( ! more && (inflight == 0) ) {
+	    break;
+	}
+
+	uint32_t	st = Spi->Stat.read();		// one status read
+	PollCnt++;
+
+	uint32_t	rxlev = (st >> USpi_RxLevel_pos) & USpi_Level_mask;
+
+	if ( (rxlev == 0) && !(st & USpi_RxEmpty) ) {
+	    rxlev = 1;
+	}
+
+	if ( rxlev && inflight ) {
+	    uint32_t	w0 = Tmr->TimeW0.read();
+	    if ( w0 < last ) {
+		hi += 0x100000000ull;		// low word wrapped
+	    }
+	    last    = w0;
+	    ss.Time = hi | w0;
+
+	    while ( rxlev && inflight ) {
+		ss.Value = (Spi->Fifo.read() >> shift) & mask;
+
+		if ( Ring->push( ss ) ) {
+		    SampleCnt++;
+		}
+		else {
+		    DropCnt++;
+		}
+		rxlev--;
+		inflight--;
+	    }
+	}
+
+	while ( more && (inflight < rgUniSpi::FifoDepth) &&
+		( (nsample == 0) || (nt < nsample) )
+	) {
+	    Spi->Fifo.write( Cmd );
+	    nt++;
+	    inflight++;
+	}
+    }
+
+    StopReq.store( 0 );
+
+    return  SampleCnt;
+}
@@ -0,0 +1,131 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgUniSpiAdc_P
+#define rgUniSpiAdc_P
+
+#include <atomic>
+
+#include "rgUniSpi.h"
+#include "rgSysTimer.h"
+
+//--------------------------------------------------------------------------
+// rgUniSpiAdc - Continuous ADC acquisition on rgUniSpi
+//--------------------------------------------------------------------------
+// One fixed conversion command word is sent per sample, each in its own
+// chip select frame (Fifo), keeping up to FifoDepth words in flight.
+// Each result is timestamped from the System Timer and pushed as a
+// (Time, Value) pair into a lock-free single-producer/single-consumer ring.
+// run() is the producer, intended to be on an isolated core;  a consumer
+// thread pops samples concurrently.
+//
+// e.g.
+//    rgUniSpiAdc_Sample	buf[4096];
+//    rgUniSpiAdc_Ring		ring  ( buf, 4096 );
+//    rgUniSpiAdc		adc   ( &spx, &stx, &ring );
+//    adc.config_Cmd(  0x00c00000 );	// conversion command
+//    adc.config_Bits( 12 );		// result width
+//    adc.run( 0 );			// until stop() from another thread
+
+struct rgUniSpiAdc_Sample {
+    uint64_t		Time;		// System Timer, microseconds
+    uint32_t		Value;		// result
+};
+
+
+//--------------------------------------------------------------------------
+// Single-producer/single-consumer ring of samples.
+//    Storage is supplied by the caller, size a power of 2.
+//    Head and Tail are free-running indexes;  each is written by only one
+//    side, and published with release/acquire ordering.
+
+class rgUniSpiAdc_Ring {
+  private:
+    rgUniSpiAdc_Sample		*Buf;		// storage
+    uint32_t			Size;		// number of entries
+    uint32_t			Mask;		// Size - 1
+
+    std::atomic<uint32_t>	Head;		// next write, producer
+    std::atomic<uint32_t>	Tail;		// next read, consumer
+
+  public:
+    rgUniSpiAdc_Ring(		// constructor
+	rgUniSpiAdc_Sample	*buf,
+	uint32_t		size
+    );
+
+		// Producer side
+    inline bool		push( const rgUniSpiAdc_Sample&  ss )
+			{
+			    uint32_t	hh = Head.load( std::memory_order_relaxed );
+			    if ( (hh - Tail.load( std::memory_order_acquire ))
+				 >= Size ) {
+				return  0;		// full
+			    }
+			    Buf[hh & Mask] = ss;
+			    Head.store( hh + 1, std::memory_order_release );
+			    return  1;
+			}
+
+		// Consumer side
+    inline bool		pop( rgUniSpiAdc_Sample&  ss )
+			{
+			    uint32_t	tt = Tail.load( std::memory_order_relaxed );
+			    if ( tt == Head.load( std::memory_order_acquire ) ) {
+				return  0;		// empty
+			    }
+			    ss = Buf[tt & Mask];
+			    Tail.store( tt + 1, std::memory_order_release );
+			    return  1;
+			}
+
+    inline uint32_t	count()
+			{
+			    return  Head.load( std::memory_order_acquire ) -
+				    Tail.load( std::memory_order_acquire );
+			}
+
+    inline uint32_t	get_Size()  { return  Size; }
+
+    void		clear();	// not concurrent with push(), pop()
+};
+
+
+//--------------------------------------------------------------------------
+
+class rgUniSpiAdc {
+  private:
+    rgUniSpi		*Spi;		// SPI unit
+    rgSysTimer		*Tmr;		// timestamp source
+    rgUniSpiAdc_Ring	*Ring;		// output
+
+    uint32_t		Cmd;		// Tx conversion command word
+    uint32_t		Bits;		// result width {1..32}, 0= raw word
+
+    std::atomic<bool>	StopReq;	// set by stop()
+
+    uint64_t		SampleCnt;	// samples pushed, last run()
+    uint64_t		DropCnt;	// samples lost to a full ring
+    uint64_t		PollCnt;	// Stat reads
+
+  public:
+    rgUniSpiAdc(		// constructor
+	rgUniSpi		*spx,
+	rgSysTimer		*stx,
+	rgUniSpiAdc_Ring	*ring
+    );
+
+    inline void		config_Cmd( uint32_t v )  { Cmd = v; }
+    inline uint32_t	config_Cmd()              { return  Cmd; }
+
+    void		config_Bits( uint32_t v );
+    inline uint32_t	config_Bits()             { return  Bits; }
+
+    uint64_t		run( uint64_t  nsample );
+    inline void		stop()    { StopReq.store( 1 ); }
+
+    inline uint64_t	get_SampleCnt()  { return  SampleCnt; }
+    inline uint64_t	get_DropCnt()    { return  DropCnt; }
+    inline uint64_t	get_PollCnt()    { return  PollCnt; }
+};
+
+#endif
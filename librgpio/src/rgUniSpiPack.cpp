@@ -0,0 +1,203 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgUniSpiPack - Variable width Fifo word packer for rgUniSpi
+//
+// See:  doc/uspi_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+
+#include "rgUniSpiPack.h"
+
+
+/*
+* Constructor.
+*    Bit order defaults to MSB first both ways.
+* call:
+*    rgUniSpiPack	pk;
+*/
+rgUniSpiPack::rgUniSpiPack()
+{
+    init_order( 1, 1 );
+}
+
+
+/*
+* Initialize shift tables for a bit order.
+* call:
+*    self.init_order( out_msb, in_msb )
+*    out_msb = Cntl0.OutMsbFirst_1 value
+*    in_msb  = Cntl1.InMsbFirst_1 value
+*/
+void
+rgUniSpiPack::init_order(
+    bool		out_msb,
+    bool		in_msb
+)
+{
+    OutMsb = out_msb;
+    InMsb  = in_msb;
+
+    Mask[0]    = 0;
+    TxShift[0] = 0;
+    RxShift[0] = 0;
+
+    for ( uint32_t bits = 1;  bits <= MaxBits;  bits++ ) {
+	Mask[bits]    = (0x1u << bits) - 1;
+	TxShift[bits] = OutMsb ? (MaxBits - bits) : 0;	// MSB at bit [23]
+	RxShift[bits] = InMsb  ? 0 : (32 - bits);	// shifted into [31]
+    }
+}
+
+
+/*
+* Initialize shift tables from an rgUniSpi object.
+*    Uses the object Cntl0, Cntl1 values (not the hardware registers),
+*    so call after grab_regs() or the put_*() configuration.
+* call:
+*    self.init_from( &spx )
+*/
+void
+rgUniSpiPack::init_from(
+    rgUniSpi		*spx
+)
+{
+    init_order( spx->Cntl0.get_OutMsbFirst_1(),
+		spx->Cntl1.get_InMsbFirst_1() );
+}
+
+
+/*
+* Check segment list.
+* call:
+*    self.check_segs( fn, sv, nseg )
+*    fn   = caller function name, for error message
+* exceptions:
+*    range_error  Bits not in {1..24}, Cs exceeds 7
+*/
+void
+rgUniSpiPack::check_segs(
+    const char		*fn,
+    const rgUniSpi_Seg	*sv,
+    size_t		nseg
+)
+{
+    for ( size_t ii = 0;  ii < nseg;  ii++ ) {
+	if ( (sv[ii].Bits == 0) || (sv[ii].Bits > MaxBits) ) {
+	    std::ostringstream	css;
+	    css << "rgUniSpiPack::" << fn << "():  Bits requires {1..24} in sv["
+		<< ii << "]:  " << sv[ii].Bits;
+	    throw std::range_error ( css.str() );
+	}
+
+	if ( sv[ii].Cs > 0x7 ) {
+	    std::ostringstream	css;
+	    css << "rgUniSpiPack::" << fn << "():  Cs exceeds 7 in sv["
+		<< ii << "]:  " << sv[ii].Cs;
+	    throw std::range_error ( css.str() );
+	}
+    }
+}
+
+
+/*
+* Pack a byte stream into Tx Fifo words, one word per segment.
+*    Each segment takes seg_bytes(Bits) bytes, big-endian.
+*    Value bits above Bits are dropped.
+* call:
+*    self.pack( src, nsrc, sv, nseg, wv )
+*    src  = byte stream
+*    nsrc = number of bytes in src
+*    sv   = segment list, nseg entries
+*    wv   = Fifo word output, nseg entries
+* return:
+*    ()  = number of words written, nseg
+* exceptions:
+*    range_error  from check_segs()
+*    range_error  src shorter than the segments require
+*/
+size_t
+rgUniSpiPack::pack(
+    const uint8_t	*src,
+    size_t		nsrc,
+    const rgUniSpi_Seg	*sv,
+    size_t		nseg,
+    uint32_t		*wv
+)
+{
+    check_segs( "pack", sv, nseg );
+
+    size_t		need = 0;
+    for ( size_t ii = 0;  ii < nseg;  ii++ ) {
+	need += seg_bytes( sv[ii].Bits );
+    }
+
+    if ( nsrc < need ) {
+	std::ostringstream	css;
+	css << "rgUniSpiPack::pack():  src requires " << need << " bytes:  "
+	    << nsrc;
+	throw std::range_error ( css.str() );
+    }
+
+    for ( size_t ii = 0;  ii < nseg;  ii++ ) {
+	uint32_t	bits = sv[ii].Bits;
+	uint32_t	val  = *src++;
+
+	if ( bits >  8 ) { val = (val << 8) | *src++; }
+	if ( bits > 16 ) { val = (val << 8) | *src++; }
+
+	wv[ii] = pack_value( val, bits, sv[ii].Cs );
+    }
+
+    return  nseg;
+}
+
+
+/*
+* Unpack Rx Fifo words into a byte stream, one word per segment.
+*    Each segment gives seg_bytes(Bits) bytes, big-endian.
+*    Bits outside the segment width (e.g. kept by KeepInput_1) are dropped.
+* call:
+*    self.unpack( wv, sv, nseg, dst )
+*    wv   = Rx Fifo words, nseg entries
+*    sv   = segment list, nseg entries
+*    dst  = byte stream output
+* return:
+*    ()  = number of bytes written
+* exceptions:
+*    range_error  from check_segs()
+*/
+size_t
+rgUniSpiPack::unpack(
+    const uint32_t	*wv,
+    const rgUniSpi_Seg	*sv,
+    size_t		nseg,
+    uint8_t		*dst
+)
+{
+    check_segs( "unpack", sv, nseg );
+
+    uint8_t		*dp = dst;
+
+    for ( size_t ii = 0;  ii < nseg;  ii++ ) {
+	uint32_t	bits = sv[ii].Bits;
+	uint32_t	val  = unpack_value( wv[ii], bits );
+
+	if ( bits > 16 ) { *dp++ = val >> 16; }
+	if ( bits >  8 ) { *dp++ = val >>  8; }
+	*dp++ = val;
+    }
+
+    return  (dp - dst);
+}
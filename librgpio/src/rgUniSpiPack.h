@@ -0,0 +1,105 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgUniSpiPack_P
+#define rgUniSpiPack_P
+
+#include "rgUniSpi.h"
+
+//--------------------------------------------------------------------------
+// rgUniSpiPack - Variable width Fifo word packer for rgUniSpi
+//--------------------------------------------------------------------------
+// With Cntl0.VariableWidth_1=1 each Tx Fifo word carries its own bit width
+// in [28:24], and with Cntl0.VariableCs_1=1 its chip select pattern in
+// [31:29], leaving 24 data bits.  This packs a byte stream, split into
+// segments of {1..24} bits, into those Fifo words, and unpacks Rx words back
+// into bytes.  Each segment value is ceil(Bits/8) bytes, big-endian, right
+// justified (e.g. a 12-bit value 0xabc is bytes {0x0a, 0xbc}).
+// Shift and mask for each width are precomputed for the bit order.
+//
+// e.g.
+//    rgUniSpi_Seg	sv[] = {
+//	// Bits  Cs
+//	{  12,   6 },		// 12-bit ADC on CS0
+//	{  24,   5 },		// 24-bit ADC on CS1
+//    };
+//    rgUniSpiPack	pk;
+//    pk.init_from( &spx );
+//    nw = pk.pack( src, nsrc, sv, 2, wv );
+//    spx.xfer_words( wv, rv, nw, 0 );
+//    nb = pk.unpack( rv, sv, 2, dst );
+
+struct rgUniSpi_Seg {
+    uint32_t		Bits;		// data width {1..24}
+    uint32_t		Cs;		// chip select pattern {0..7},
+					//    used with VariableCs_1=1
+};
+
+
+class rgUniSpiPack {
+  public:
+    static const uint32_t	MaxBits = 24;	// data bits in a Fifo word
+
+  private:
+    bool		OutMsb;		// OutMsbFirst_1
+    bool		InMsb;		// InMsbFirst_1
+
+					// Tables indexed by width {0..24}
+    uint32_t		TxShift[MaxBits+1];	// value shift left into word
+    uint32_t		RxShift[MaxBits+1];	// word shift right to value
+    uint32_t		Mask[MaxBits+1];	// value mask
+
+  public:
+    rgUniSpiPack();			// constructor
+
+    void		init_order(
+			    bool	out_msb,
+			    bool	in_msb
+			);
+    void		init_from( rgUniSpi  *spx );
+
+    inline bool		get_OutMsb()  { return  OutMsb; }
+    inline bool		get_InMsb()   { return  InMsb; }
+
+		// Single word, no range checks
+    inline uint32_t	pack_value( uint32_t  val,  uint32_t  bits,
+				    uint32_t  cs )
+			{
+			    return  (cs << 29) | (bits << 24) |
+				    ((val & Mask[bits]) << TxShift[bits]);
+			}
+
+    inline uint32_t	unpack_value( uint32_t  word,  uint32_t  bits )
+			{
+			    return  (word >> RxShift[bits]) & Mask[bits];
+			}
+
+    static inline uint32_t	seg_bytes( uint32_t  bits )
+			{
+			    return  (bits + 7) >> 3;
+			}
+
+		// Byte stream
+    size_t		pack(
+			    const uint8_t	*src,
+			    size_t		nsrc,
+			    const rgUniSpi_Seg	*sv,
+			    size_t		nseg,
+			    uint32_t		*wv
+			);
+
+    size_t		unpack(
+			    const uint32_t	*wv,
+			    const rgUniSpi_Seg	*sv,
+			    size_t		nseg,
+			    uint8_t		*dst
+			);
+
+  private:
+    void		check_segs(
+			    const char		*fn,
+			    const rgUniSpi_Seg	*sv,
+			    size_t		nseg
+			);
+};
+
+#endif
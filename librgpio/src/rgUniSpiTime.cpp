@@ -0,0 +1,243 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgUniSpiTime - Transfer time model for rgUniSpi
+//
+// See:  doc/uspi_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+#include "rgSysTimer.h"
+
+#include "rgUniSpiTime.h"
+
+
+/*
+* Constructor.
+*    CoreHz defaults to the nominal core clock:  500 MHz on RPi4,
+*    250 MHz on earlier.  Override with config_CoreHz() if the firmware
+*    core_freq is different.
+* call:
+*    rgUniSpiTime	tm  ( &spx );
+*    spx = SPI unit object
+*/
+rgUniSpiTime::rgUniSpiTime(
+    rgUniSpi		*spx
+)
+{
+    Spi            = spx;
+    WordOverheadNs = 0;
+    MeasureNs      = 0;
+
+    CoreHz = ( rgRpiRev::Global.SocEnum.find() == rgRpiRev::soc_BCM2711 )
+	     ? 500000000 : 250000000;
+}
+
+
+/*
+* Configure core clock frequency.
+* call:
+*    self.config_CoreHz( v )
+*    v  = frequency in Hz, nonzero
+* exceptions:
+*    range_error  v is zero
+*/
+void
+rgUniSpiTime::config_CoreHz(
+    uint32_t		v
+)
+{
+    if ( v == 0 ) {
+	throw std::range_error ( "rgUniSpiTime::config_CoreHz():  require nonzero" );
+    }
+
+    CoreHz = v;
+}
+
+
+/*
+* SCLK period from object Cntl0.Speed_12.
+* return:
+*    ()  = period in picoseconds
+*/
+uint64_t
+rgUniSpiTime::sclk_ps()
+{
+    uint64_t		div = 2 * ((uint64_t) Spi->Cntl0.get_Speed_12() + 1);
+
+    return  ( div * 1000000000000ull ) / CoreHz;
+}
+
+
+/*
+* Fixed and per-word cost in picoseconds.
+* call:
+*    self.word_cost( fn, hold, &fixed_ps, &word_ps )
+*    fn   = caller function name, for error message
+*    hold = 1: one FifoH frame, 0: one Fifo frame per word
+* exceptions:
+*    range_error  ShiftLength_6 not in {1..32}
+*/
+void
+rgUniSpiTime::word_cost(
+    const char		*fn,
+    bool		hold,
+    uint64_t		*fixed_ps,
+    uint64_t		*word_ps
+)
+{
+    uint32_t		bits = Spi->Cntl0.get_ShiftLength_6();
+
+    if ( (bits == 0) || (bits > 32) ) {
+	std::ostringstream	css;
+	css << "rgUniSpiTime::" << fn << "():  ShiftLength_6 requires {1..32}:  "
+	    << bits;
+	throw std::range_error ( css.str() );
+    }
+
+    uint64_t		sclk  = sclk_ps();
+    uint64_t		cs_ps = (Spi->Cntl1.get_CsHighTime_3() + 1) * sclk;
+
+    *word_ps  = bits * sclk + (uint64_t) WordOverheadNs * 1000;
+    *fixed_ps = 0;
+
+    if ( hold ) {
+	*fixed_ps = cs_ps;
+    }
+    else {
+	*word_ps += cs_ps;
+    }
+}
+
+
+/*
+* Predict transfer duration.
+* call:
+*    self.predict_ns( nword, hold )
+*    nword = number of Fifo words
+*    hold  = 1: one FifoH frame, 0: one Fifo frame per word
+* return:
+*    ()  = duration in nanoseconds, rounded up
+* exceptions:
+*    range_error  from word_cost()
+*/
+uint64_t
+rgUniSpiTime::predict_ns(
+    uint32_t		nword,
+    bool		hold
+)
+{
+    uint64_t		fixed_ps;
+    uint64_t		word_ps;
+
+    word_cost( "predict_ns", hold, &fixed_ps, &word_ps );
+
+    if ( nword == 0 ) {
+	return  0;
+    }
+
+    return  ( fixed_ps + nword * word_ps + 999 ) / 1000;
+}
+
+
+/*
+* Maximum words that fit in a time budget.
+*    Largest n with predict_ns( n, hold ) <= budget_ns.
+* call:
+*    self.max_words( budget_ns, hold )
+*    budget_ns = time available in nanoseconds
+*    hold      = 1: one FifoH frame, 0: one Fifo frame per word
+* exceptions:
+*    range_error  from word_cost()
+*/
+uint32_t
+rgUniSpiTime::max_words(
+    uint64_t		budget_ns,
+    bool		hold
+)
+{
+    uint64_t		fixed_ps;
+    uint64_t		word_ps;
+
+    word_cost( "max_words", hold, &fixed_ps, &word_ps );
+
+    uint64_t		budget_ps = budget_ns * 1000;
+
+    if ( budget_ps < fixed_ps + word_ps ) {
+	return  0;
+    }
+
+    uint64_t		nn = (budget_ps - fixed_ps) / word_ps;
+
+    return  ( nn > 0xffffffff ) ? 0xffffffff : nn;
+}
+
+
+/*
+* Calibrate per-word software overhead.
+*    Transfer nword zero words, one Fifo frame each, with xfer_words() and
+*    time it with the System Timer (1 us resolution, so use nword large
+*    enough for a few milliseconds).  The excess over the model with zero
+*    overhead, divided by nword, is stored in WordOverheadNs.
+*    The SPI unit must be configured and enabled;  Rx data is discarded.
+* call:
+*    self.calibrate( &stx, nword )
+*    stx   = System Timer object
+*    nword = number of words {1..}
+* return:
+*    ()  = overhead in nanoseconds per word
+* exceptions:
+*    range_error  nword is zero
+*    range_error  from word_cost()
+*/
+uint32_t
+rgUniSpiTime::calibrate(
+    rgSysTimer		*stx,
+    uint32_t		nword
+)
+{
+    if ( nword == 0 ) {
+	throw std::range_error ( "rgUniSpiTime::calibrate():  require nword > 0" );
+    }
+
+    uint64_t		fixed_ps;
+    uint64_t		word_ps;
+
+    WordOverheadNs = 0;
+    word_cost( "calibrate", 0, &fixed_ps, &word_ps );
+
+    uint32_t		tx[64];
+    for ( uint32_t ii = 0;  ii < 64;  ii++ ) {
+	tx[ii] = 0;
+    }
+
+    uint64_t		t0 = stx->TimeDw.grab64();
+
+    for ( uint32_t left = nword;  left;  ) {
+	uint32_t	nn = ( left > 64 ) ? 64 : left;
+	Spi->xfer_words( tx, NULL, nn, 0 );
+	left -= nn;
+    }
+
+    uint64_t		t1 = stx->TimeDw.grab64();
+
+    MeasureNs = (t1 - t0) * 1000;
+
+    uint64_t		model_ns = ( nword * word_ps ) / 1000;
+
+    if ( MeasureNs > model_ns ) {
+	WordOverheadNs = (MeasureNs - model_ns) / nword;
+    }
+
+    return  WordOverheadNs;
+}
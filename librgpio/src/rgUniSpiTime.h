@@ -0,0 +1,74 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgUniSpiTime_P
+#define rgUniSpiTime_P
+
+#include "rgUniSpi.h"
+#include "rgSysTimer.h"
+
+//--------------------------------------------------------------------------
+// rgUniSpiTime - Transfer time model for rgUniSpi
+//--------------------------------------------------------------------------
+// Predict transfer duration from the object register values
+// Cntl0.Speed_12, Cntl0.ShiftLength_6, Cntl1.CsHighTime_3, and a per-word
+// software overhead measured by calibrate().  Intended for packing SPI work
+// into fixed control loop periods.
+//
+//    SCLK period   Tsclk = 2 * (Speed_12 + 1) / CoreHz
+//    word          ShiftLength_6 * Tsclk + WordOverheadNs
+//    CS high       (CsHighTime_3 + 1) * Tsclk,  per word (Fifo),
+//                  or once per frame (FifoH, hold=1)
+//
+// e.g.
+//    spx.grab_regs();
+//    rgUniSpiTime	tm  ( &spx );
+//    tm.calibrate( &stx, 1000 );
+//    n = tm.max_words( 200000, 0 );	// words that fit in 200 us
+
+class rgUniSpiTime {
+  private:
+    rgUniSpi		*Spi;		// SPI unit, object registers used
+
+    uint32_t		CoreHz;		// core (system) clock frequency
+    uint32_t		WordOverheadNs;	// software overhead per word
+    uint64_t		MeasureNs;	// measured duration, last calibrate()
+
+  public:
+    rgUniSpiTime( rgUniSpi  *spx );	// constructor
+
+    void		config_CoreHz( uint32_t  v );
+    inline uint32_t	config_CoreHz()           { return  CoreHz; }
+
+    inline void		config_WordOverheadNs( uint32_t  v )
+			    { WordOverheadNs = v; }
+    inline uint32_t	config_WordOverheadNs()   { return  WordOverheadNs; }
+
+    uint64_t		sclk_ps();
+
+    uint64_t		predict_ns(
+			    uint32_t	nword,
+			    bool	hold
+			);
+
+    uint32_t		max_words(
+			    uint64_t	budget_ns,
+			    bool	hold
+			);
+
+    uint32_t		calibrate(
+			    rgSysTimer	*stx,
+			    uint32_t	nword
+			);
+
+    inline uint64_t	get_MeasureNs()  { return  MeasureNs; }
+
+  private:
+    void		word_cost(
+			    const char	*fn,
+			    bool	hold,
+			    uint64_t	*fixed_ps,
+			    uint64_t	*word_ps
+			);
+};
+
+#endif
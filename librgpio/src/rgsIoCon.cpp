@@ -50,8 +50,15 @@ rgsIoCon::rgsIoCon(
     {
 	StatReg[ii].init_addr( GpioBase + (2*ii)     );
 	CntlReg[ii].init_addr( GpioBase + (2*ii) + 1 );
+	CntlShadow[ii] = 0;
     }
     // Interleaved word index, byte offsets *0x04
+
+    ShadowMode = 0;
+    StaleCount = 0;
+
+    FilterClkHz = 200000000;
+    ArmedMask   = 0;
 }
 
 
@@ -98,3 +105,450 @@ rgsIoCon::IoStat( int bit )
     return  StatReg[bit];
 }
 
+
+//--------------------------------------------------------------------------
+// Shadow cache
+//--------------------------------------------------------------------------
+// Only the Cntl registers are shadowed.  Stat registers reflect live pin
+// state and are always read from hardware.
+// Writes go through to hardware and update the shadow.  External changes
+// are seen only by refresh(), which counts them in StaleCount.
+
+/*
+* Configure shadow mode.
+*    Enabling loads the shadow from hardware without counting stale registers.
+* call:
+*    config_ShadowMode( 1 )	read_cntl() served from shadow copy
+*    config_ShadowMode( 0 )	read_cntl() goes to hardware (default)
+*/
+void
+rgsIoCon::config_ShadowMode( bool v )
+{
+    if ( v ) {
+	for ( int ii=0;  ii<=MaxBit;  ii++ )
+	{
+	    CntlShadow[ii] = CntlReg[ii].read();
+	}
+	update_armed();
+    }
+
+    ShadowMode = v;
+}
+
+
+/*
+* Refresh shadow copy of Cntl registers from hardware.
+*    Registers that differ from the shadow were changed outside this object,
+*    and are added to StaleCount.
+* call:
+*    refresh()
+* return:
+*    () = number of registers found changed
+*/
+uint32_t
+rgsIoCon::refresh()
+{
+    uint32_t		nstale = 0;
+    uint32_t		vv;
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	vv = CntlReg[ii].read();
+	if ( vv != CntlShadow[ii] ) {
+	    CntlShadow[ii] = vv;
+	    nstale++;
+	}
+    }
+
+    if ( nstale ) {
+	update_armed();
+    }
+
+    StaleCount += nstale;
+    return  nstale;
+}
+
+
+/*
+* Read Cntl register value.
+* call:
+*    read_cntl( bit )
+*    bit  = gpio bit index {0..27}
+* return:
+*    () = shadow copy in shadow mode, else hardware value
+*/
+uint32_t
+rgsIoCon::read_cntl( int bit )
+{
+    rgsIo_Cntl&		rx = IoCntl( bit );	// range check
+
+    if ( ShadowMode ) {
+	return  CntlShadow[bit];
+    }
+
+    return  rx.read();
+}
+
+
+/*
+* Write Cntl register value.
+*    Writes through to hardware and updates the shadow copy.
+* call:
+*    write_cntl( bit, vv )
+*    bit  = gpio bit index {0..27}
+*    vv   = full register value
+*/
+void
+rgsIoCon::write_cntl(
+    int			bit,
+    uint32_t		vv
+)
+{
+    IoCntl( bit ).write( vv );
+    CntlShadow[bit] = vv;
+}
+
+
+/*
+* Modify Cntl register bits.
+*    Uses atomic set/clr writes, no hardware read.
+* call:
+*    modify_cntl( bit, mask, vv )
+*    bit  = gpio bit index {0..27}
+*    mask = bits to modify
+*    vv   = new value of masked bits
+*/
+void
+rgsIoCon::modify_cntl(
+    int			bit,
+    uint32_t		mask,
+    uint32_t		vv
+)
+{
+    rgsIo_Cntl&		rx = IoCntl( bit );	// range check
+
+    rx.write_set(  mask &  vv );
+    rx.write_clr(  mask & ~vv );
+
+    CntlShadow[bit] = (CntlShadow[bit] & ~mask) | (vv & mask);
+}
+
+
+//--------------------------------------------------------------------------
+// Input filter/debounce
+//--------------------------------------------------------------------------
+// The RP1 doc gives only "Filter/debounce time constant M" for FilterM_7.
+// Model assumed here (unverified on hardware):
+//    The filter samples the pad input once per tick of FilterClkHz (clk_sys,
+//    200 MHz default) and changes its output only after the input has held
+//    the new level for M consecutive ticks.  M=0 is no filtering.
+// Thus a pulse passes only if it is at least M ticks wide.
+// Adjust config_FilterClk() if measurement shows a different tick.
+
+/*
+* Configure assumed filter tick frequency.
+* call:
+*    config_FilterClk( 200000000 )	Hz, default clk_sys
+*/
+void
+rgsIoCon::config_FilterClk( uint32_t hz )
+{
+    if ( hz == 0 ) {
+	throw std::range_error ( "rgsIoCon::config_FilterClk():  require hz > 0" );
+    }
+
+    FilterClkHz = hz;
+}
+
+
+/*
+* Calculate FilterM_7 to reject pulses shorter than a debounce time.
+*    Rounds up to a whole tick.
+* call:
+*    calc_FilterM_7( debounce_ns )
+* return:
+*    () = FilterM_7 value {0..127}
+* exceptions:
+*    range_error if more than 127 ticks are needed
+*/
+uint32_t
+rgsIoCon::calc_FilterM_7( uint32_t debounce_ns )
+{
+    uint64_t		mm;
+
+    mm = ( (uint64_t)debounce_ns * FilterClkHz + 999999999 ) / 1000000000;
+
+    if ( mm > 0x7f ) {
+	std::ostringstream      css;
+	css << "rgsIoCon::calc_FilterM_7():  debounce exceeds "
+	    << calc_filter_ns( 0x7f ) << " ns:  " << debounce_ns;
+	throw std::range_error ( css.str() );
+    }
+
+    return  mm;
+}
+
+
+/*
+* Calculate filter time of a FilterM_7 value.
+* call:
+*    calc_filter_ns( mm )
+*    mm   = FilterM_7 value
+* return:
+*    () = shortest pulse width in ns that passes the filter
+*/
+uint32_t
+rgsIoCon::calc_filter_ns( uint32_t mm )
+{
+    return  ( (uint64_t)mm * 1000000000 ) / FilterClkHz;
+}
+
+
+/*
+* Predict if a pulse passes the filter model.
+* call:
+*    calc_filter_pass( mm, pulse_ns )
+*    mm       = FilterM_7 value
+*    pulse_ns = pulse width in ns
+* return:
+*    () = 1 if pulse passes, 0 if rejected
+*/
+bool
+rgsIoCon::calc_filter_pass(
+    uint32_t		mm,
+    uint32_t		pulse_ns
+)
+{
+    uint64_t		ticks;
+
+    ticks = ( (uint64_t)pulse_ns * FilterClkHz ) / 1000000000;
+
+    return  ( ticks >= mm );
+}
+
+
+/*
+* Apply filter debounce time to a set of pins.
+*    Modifies only the FilterM_7 field with atomic set/clr, no read.
+* call:
+*    apply_filter( mask, debounce_ns )
+*    mask        = gpio bit mask, bit N is pin N {0..27}
+*    debounce_ns = minimum pulse width to pass
+* return:
+*    () = FilterM_7 value applied
+* exceptions:
+*    range_error if mask has bits above MaxBit, or debounce too long
+*/
+uint32_t
+rgsIoCon::apply_filter(
+    uint32_t		mask,
+    uint32_t		debounce_ns
+)
+{
+    uint32_t		mm;
+
+    check_mask( "apply_filter", mask );
+
+    mm = calc_FilterM_7( debounce_ns );
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( mask & (1u << ii) ) {
+	    modify_cntl( ii, (0x7f << 5), (mm << 5) );
+	}
+    }
+
+    return  mm;
+}
+
+
+/*
+* Predict if a pulse passes the filter configured on a pin.
+*    Uses FilterM_7 from read_cntl(), i.e. the shadow copy in shadow mode.
+* call:
+*    predict_filter_pass( bit, pulse_ns )
+*    bit      = gpio bit index {0..27}
+*    pulse_ns = pulse width in ns
+* return:
+*    () = 1 if pulse passes, 0 if rejected
+*/
+bool
+rgsIoCon::predict_filter_pass(
+    int			bit,
+    uint32_t		pulse_ns
+)
+{
+    uint32_t		mm = ( read_cntl( bit ) >> 5 ) & 0x7f;
+
+    return  calc_filter_pass( mm, pulse_ns );
+}
+
+
+//--------------------------------------------------------------------------
+// Interrupt mask and status
+//--------------------------------------------------------------------------
+// Arm, scan, and acknowledge interrupts across a set of pins.
+// Pin sets are a bit mask, bit N is pin N {0..27}.
+// The per-bank INTR/PROCn_INTS summary registers are not modeled in this
+// class, so the scan reads IoStat() of only the requested pins.
+
+/*
+* Check pin mask in range.
+* call:
+*    check_mask( "func_name", mask )
+* exceptions:
+*    range_error if mask has bits above MaxBit
+*/
+void
+rgsIoCon::check_mask(
+    const char*		fn,
+    uint32_t		mask
+)
+{
+    if ( mask >> (MaxBit + 1) ) {
+	std::ostringstream      css;
+	css << "rgsIoCon::" << fn << "():  mask exceeds MaxBit:  0x"
+	    <<hex << mask;
+	throw std::range_error ( css.str() );
+    }
+}
+
+
+/*
+* Update ArmedMask from shadow copy.
+*/
+void
+rgsIoCon::update_armed()
+{
+    ArmedMask = 0;
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( CntlShadow[ii] & (0xff << 20) ) {
+	    ArmedMask |= (1u << ii);
+	}
+    }
+}
+
+
+/*
+* Apply interrupt mask to a set of pins.
+*    Writes only pins whose Imask field differs from read_cntl(), so with
+*    shadow mode there are no hardware reads.
+*    Each pin gets one full-word Cntl write.  A set then clr pair would
+*    briefly arm the union of old and new Imask (0x01 -> 0x02 via 0x03).
+* call:
+*    apply_imask( mask, imask_8 )
+*    mask    = gpio bit mask
+*    imask_8 = Imask fields [27:20] as 8-bit value:
+*		0x80 ImaskFiltHigh_1	0x08 ImaskHigh_1
+*		0x40 ImaskFiltLow_1	0x04 ImaskLow_1
+*		0x20 ImaskFiltRise_1	0x02 ImaskRise_1
+*		0x10 ImaskFiltFall_1	0x01 ImaskFall_1
+* return:
+*    () = number of Cntl registers written
+* exceptions:
+*    range_error if mask has bits above MaxBit, or imask_8 exceeds 8 bits
+*/
+uint32_t
+rgsIoCon::apply_imask(
+    uint32_t		mask,
+    uint32_t		imask_8
+)
+{
+    uint32_t		nw = 0;
+    uint32_t		fmask = (0xff << 20);
+    uint32_t		fval;
+
+    check_mask( "apply_imask", mask );
+
+    if ( imask_8 > 0xff ) {
+	std::ostringstream      css;
+	css << "rgsIoCon::apply_imask():  imask exceeds 0xff:  0x"
+	    <<hex << imask_8;
+	throw std::range_error ( css.str() );
+    }
+
+    fval = imask_8 << 20;
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( !(mask & (1u << ii)) ) {
+	    continue;
+	}
+
+	uint32_t	vv = read_cntl( ii );
+
+	if ( (vv & fmask) != fval ) {
+	    write_cntl( ii, (vv & ~fmask) | fval );	// one write, no glitch
+	    nw++;
+	}
+    }
+
+    if ( imask_8 ) {
+	ArmedMask |=  mask;
+    }
+    else {
+	ArmedMask &= ~mask;
+    }
+
+    return  nw;
+}
+
+
+/*
+* Read pending interrupts.
+*    Reads IoStat().IrqToProc_1 of only the pins in mask.
+* call:
+*    read_irq_pending( mask )	pins in mask
+*    read_irq_pending()		pins armed by apply_imask() or shadow load
+* return:
+*    () = gpio bit mask of pins with interrupt to processor
+*/
+uint32_t
+rgsIoCon::read_irq_pending( uint32_t mask )
+{
+    uint32_t		pend = 0;
+
+    check_mask( "read_irq_pending", mask );
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( (mask & (1u << ii)) &&
+	     (StatReg[ii].read() & (1u << 29))
+	) {
+	    pend |= (1u << ii);
+	}
+    }
+
+    return  pend;
+}
+
+
+/*
+* Acknowledge edge-detected interrupts.
+*    Pulses EdgeReset_1 on all pins in mask:  first all the atomic set
+*    writes, then all the atomic clr writes.  No reads, shadow unchanged.
+* call:
+*    ack_edge( mask )
+*    mask = gpio bit mask, e.g. from read_irq_pending()
+*/
+void
+rgsIoCon::ack_edge( uint32_t mask )
+{
+    check_mask( "ack_edge", mask );
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( mask & (1u << ii) ) {
+	    CntlReg[ii].write_set( 1u << 28 );
+	}
+    }
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( mask & (1u << ii) ) {
+	    CntlReg[ii].write_clr( 1u << 28 );
+	}
+    }
+}
@@ -132,6 +132,20 @@ class rgsIoCon : public rgsIoBank {
     rgsIo_Cntl		CntlReg[MaxBit+1];
     rgsIo_Stat		StatReg[MaxBit+1];
 
+  private:	// shadow copy of Cntl registers
+    bool		ShadowMode;	// 1= read from shadow, 0= hardware
+    uint32_t		StaleCount;	// registers found changed by refresh()
+    uint32_t		CntlShadow[MaxBit+1];
+
+  private:	// input filter model
+    uint32_t		FilterClkHz;	// assumed filter tick frequency
+
+  private:	// interrupt
+    uint32_t		ArmedMask;	// pins with any Imask bit set
+
+    void		check_mask( const char* fn,  uint32_t mask );
+    void		update_armed();
+
   public:
     rgsIo_Cntl&		IoCntl( int bit );	// Register accessor
     rgsIo_Stat&		IoStat( int bit );	// Register accessor
@@ -145,6 +159,38 @@ class rgsIoCon : public rgsIoBank {
     uint32_t		get_bcm_address()	{ return  FeatureAddr; }
     uint32_t		get_MaxBit()		{ return  MaxBit; }
 
+	// shadow cache, Cntl registers only
+    void		config_ShadowMode( bool v );
+    bool		config_ShadowMode()	{ return  ShadowMode; }
+
+    uint32_t		refresh();
+    uint32_t		get_StaleCount()	{ return  StaleCount; }
+    void		clear_StaleCount()	{ StaleCount = 0; }
+
+    uint32_t		read_cntl(   int bit );
+    void		write_cntl(  int bit,  uint32_t vv );
+    void		modify_cntl( int bit,  uint32_t mask,  uint32_t vv );
+
+	// input filter/debounce, FilterM_7
+    void		config_FilterClk( uint32_t hz );
+    uint32_t		config_FilterClk()	{ return  FilterClkHz; }
+
+    uint32_t		calc_FilterM_7(  uint32_t debounce_ns );
+    uint32_t		calc_filter_ns(  uint32_t mm );
+    bool		calc_filter_pass( uint32_t mm,  uint32_t pulse_ns );
+
+    uint32_t		apply_filter( uint32_t mask,  uint32_t debounce_ns );
+    bool		predict_filter_pass( int bit,  uint32_t pulse_ns );
+
+	// interrupt mask and status, Imask 8-bit field [27:20]
+    uint32_t		apply_imask( uint32_t mask,  uint32_t imask_8 );
+    uint32_t		get_ArmedMask()		{ return  ArmedMask; }
+
+    uint32_t		read_irq_pending( uint32_t mask );
+    uint32_t		read_irq_pending()  { return read_irq_pending( ArmedMask ); }
+
+    void		ack_edge( uint32_t mask );
+
 	// base class
 //  uint32_t		get_bank_num()		{ return  BankNum; }
 //  volatile uint32_t*	get_base_addr()		{ return  GpioBase; }
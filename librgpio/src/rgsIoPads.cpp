@@ -9,6 +9,7 @@
 #include <sstream>	// std::ostringstream
 #include <string>
 #include <stdexcept>
+#include <string.h>	// strcmp()
 
 using namespace std;
 
@@ -46,11 +47,18 @@ rgsIoPads::rgsIoPads(
 
     GpioBase   = xx->get_mem_block( DocAddress );
 
+    IoVoltage.init_addr( GpioBase );
+
     for ( int ii=0;  ii<=MaxBit;  ii++ )
     {
 	PadReg[ii].init_addr( GpioBase + ((ii+1) * 0x04 /4) );
+	PadShadow[ii] = 0;
     }
     // First pad control register is at offset 0x04
+
+    VoltShadow = 0;
+    ShadowMode = 0;
+    StaleCount = 0;
 }
 
 
@@ -77,3 +85,338 @@ rgsIoPads::IoPad( int bit )
     return  PadReg[bit];
 }
 
+
+
+//--------------------------------------------------------------------------
+// Shadow cache
+//--------------------------------------------------------------------------
+// Pad registers are on the far side of PCIe, so each hardware read is a
+// slow round trip.  The shadow is a plain memory copy of every pad register
+// in the bank, loaded by refresh().  Writes always go through to hardware
+// and update the shadow.  Changes made by another program are not seen
+// until the next refresh(), which counts them in StaleCount.
+
+/*
+* Configure shadow mode.
+*    Enabling loads the shadow from hardware without counting stale registers.
+* call:
+*    config_ShadowMode( 1 )	reads served from shadow copy
+*    config_ShadowMode( 0 )	reads go to hardware (default)
+*/
+void
+rgsIoPads::config_ShadowMode( bool v )
+{
+    if ( v ) {
+	VoltShadow = IoVoltage.read();
+	for ( int ii=0;  ii<=MaxBit;  ii++ )
+	{
+	    PadShadow[ii] = PadReg[ii].read();
+	}
+    }
+
+    ShadowMode = v;
+}
+
+
+/*
+* Refresh shadow copy from hardware.
+*    Registers that differ from the shadow were changed outside this object,
+*    and are added to StaleCount.
+*    Valid in either mode, but only meaningful in shadow mode.
+* call:
+*    refresh()
+* return:
+*    () = number of registers found changed
+*/
+uint32_t
+rgsIoPads::refresh()
+{
+    uint32_t		nstale = 0;
+    uint32_t		vv;
+
+    vv = IoVoltage.read();
+    if ( vv != VoltShadow ) {
+	VoltShadow = vv;
+	nstale++;
+    }
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	vv = PadReg[ii].read();
+	if ( vv != PadShadow[ii] ) {
+	    PadShadow[ii] = vv;
+	    nstale++;
+	}
+    }
+
+    StaleCount += nstale;
+    return  nstale;
+}
+
+
+/*
+* Read pad register value.
+* call:
+*    read_pad( bit )
+*    bit  = pad index {0..27}
+* return:
+*    () = shadow copy in shadow mode, else hardware value
+*/
+uint32_t
+rgsIoPads::read_pad( int bit )
+{
+    rgsIo_Pad&		rx = IoPad( bit );	// range check
+
+    if ( ShadowMode ) {
+	return  PadShadow[bit];
+    }
+
+    return  rx.read();
+}
+
+
+/*
+* Write pad register value.
+*    Writes through to hardware and updates the shadow copy.
+* call:
+*    write_pad( bit, vv )
+*    bit  = pad index {0..27}
+*    vv   = full register value
+*/
+void
+rgsIoPads::write_pad(
+    int			bit,
+    uint32_t		vv
+)
+{
+    IoPad( bit ).write( vv );
+    PadShadow[bit] = vv;
+}
+
+
+/*
+* Modify pad register bits.
+*    Uses atomic set/clr writes, no hardware read.
+* call:
+*    modify_pad( bit, mask, vv )
+*    bit  = pad index {0..27}
+*    mask = bits to modify
+*    vv   = new value of masked bits
+*/
+void
+rgsIoPads::modify_pad(
+    int			bit,
+    uint32_t		mask,
+    uint32_t		vv
+)
+{
+    rgsIo_Pad&		rx = IoPad( bit );	// range check
+
+    rx.write_set(  mask &  vv );
+    rx.write_clr(  mask & ~vv );
+
+    PadShadow[bit] = (PadShadow[bit] & ~mask) | (vv & mask);
+}
+
+
+/*
+* Read IO voltage register value.
+* return:
+*    () = shadow copy in shadow mode, else hardware value
+*/
+uint32_t
+rgsIoPads::read_volt()
+{
+    if ( ShadowMode ) {
+	return  VoltShadow;
+    }
+
+    return  IoVoltage.read();
+}
+
+
+/*
+* Write IO voltage register value.
+*    Writes through to hardware and updates the shadow copy.
+*/
+void
+rgsIoPads::write_volt( uint32_t vv )
+{
+    IoVoltage.write( vv );
+    VoltShadow = vv;
+}
+
+
+//--------------------------------------------------------------------------
+// Pad profile batch
+//--------------------------------------------------------------------------
+// A profile is a full IoPad() register value [7:0], i.e. all fields.
+// Applying it uses posted atomic set/clr writes, no reads.  In shadow mode
+// only bits that differ from the shadow are written, and pins that already
+// match cost nothing.
+// The return value is the number of register accesses issued, so the cost
+// can be checked.
+
+/*
+* Profile name table, parallel to rgsPad_enum.
+*/
+static const struct {
+    rgsIoPads::rgsPad_enum	prof;
+    const char*			name;
+} ProfileTab[] = {
+    { rgsIoPads::pad_Reset,	"Reset"   },
+    { rgsIoPads::pad_FastSpi,	"FastSpi" },
+    { rgsIoPads::pad_SlowIic,	"SlowIic" },
+    { rgsIoPads::pad_InHyst,	"InHyst"  },
+    { rgsIoPads::pad_Off,	"Off"     }
+};
+
+
+/*
+* Apply pad profile to a set of pins.
+* call:
+*    apply_profile( mask, rgsIoPads::pad_FastSpi )
+*    apply_profile( mask, 0x56 )	any pad word
+*    mask     = gpio bit mask, bit N is pad N {0..27}
+*    pad_word = IoPad() register value [7:0]
+* return:
+*    () = number of register accesses (writes)
+* exceptions:
+*    range_error if mask has bits above MaxBit, or pad_word exceeds 0xff
+*/
+uint32_t
+rgsIoPads::apply_profile(
+    uint32_t		mask,
+    uint32_t		pad_word
+)
+{
+    uint32_t		nacc = 0;
+
+    if ( mask >> (MaxBit + 1) ) {
+	std::ostringstream      css;
+	css << "rgsIoPads::apply_profile():  mask exceeds MaxBit:  0x"
+	    <<hex << mask;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( pad_word > 0xff ) {
+	std::ostringstream      css;
+	css << "rgsIoPads::apply_profile():  pad_word exceeds 0xff:  0x"
+	    <<hex << pad_word;
+	throw std::range_error ( css.str() );
+    }
+
+    for ( int ii=0;  ii<=MaxBit;  ii++ )
+    {
+	if ( !(mask & (1u << ii)) ) {
+	    continue;
+	}
+
+	uint32_t	setb =  pad_word & 0xff;
+	uint32_t	clrb = ~pad_word & 0xff;
+
+	if ( ShadowMode ) {
+	    setb &= ~PadShadow[ii];
+	    clrb &=  PadShadow[ii];
+	}
+
+	if ( setb ) { PadReg[ii].write_set( setb );  nacc++; }
+	if ( clrb ) { PadReg[ii].write_clr( clrb );  nacc++; }
+
+	PadShadow[ii] = (PadShadow[ii] & ~0xff) | pad_word;
+    }
+
+    return  nacc;
+}
+
+
+/*
+* Apply IO voltage selection of the bank.
+*    Caution:  Selecting 1.8 V with 3.3 V signals on the pins may damage
+*    the pads.
+* call:
+*    apply_volt( 1 )	1.8 V
+*    apply_volt( 0 )	3.3 V
+* return:
+*    () = number of register accesses, 0 if unchanged in shadow mode
+*/
+uint32_t
+rgsIoPads::apply_volt( uint32_t low_1 )
+{
+    if ( low_1 > 1 ) {
+	std::ostringstream      css;
+	css << "rgsIoPads::apply_volt():  require {0,1}:  " << low_1;
+	throw std::range_error ( css.str() );
+    }
+
+    if ( ShadowMode && ((VoltShadow & 0x1) == low_1) ) {
+	return  0;
+    }
+
+    if ( low_1 ) { IoVoltage.write_set( 0x1 ); }
+    else         { IoVoltage.write_clr( 0x1 ); }
+
+    VoltShadow = (VoltShadow & ~0x1) | low_1;
+
+    return  1;
+}
+
+
+/*
+* Get string name of a pad profile.
+* call:
+*    rgsIoPads::rgsPad_enum2cstr( rgsIoPads::pad_FastSpi )
+* return:
+*    () = char string
+* exception:
+*    Throw range_error if enum is invalid.
+*/
+const char*
+rgsIoPads::rgsPad_enum2cstr( rgsPad_enum prof )
+{
+    int			max = (sizeof( ProfileTab ) / sizeof( ProfileTab[0] ));
+
+    for ( int ii=0;  ii<max;  ii++ )
+    {
+	if ( ProfileTab[ii].prof == prof ) {
+	    return  ProfileTab[ii].name;
+	}
+    }
+
+    std::ostringstream	css;
+    css << "rgsIoPads::rgsPad_enum2cstr():  bad enum= 0x" <<hex << prof;
+    throw std::range_error ( css.str() );
+}
+
+
+/*
+* Find pad profile for the corresponding string name.
+*    Linear search, good enough for the typical single lookup.
+* call:
+*    rgsIoPads::find_rgsPad_enum( "FastSpi" )
+* return:
+*    () = rgsPad_enum
+* exception:
+*    Throw range_error if string is not found.
+*    Throw logic_error if string pointer is NULL.
+*/
+rgsIoPads::rgsPad_enum
+rgsIoPads::find_rgsPad_enum( const char *name )
+{
+    if ( name == NULL ) {
+	throw std::logic_error ( "rgsIoPads::find_rgsPad_enum():  NULL string pointer" );
+    }
+
+    int			max = (sizeof( ProfileTab ) / sizeof( ProfileTab[0] ));
+
+    for ( int ii=0;  ii<max;  ii++ )
+    {
+	if ( strcmp( ProfileTab[ii].name, name ) == 0 ) {
+	    return  ProfileTab[ii].prof;
+	}
+    }
+
+    std::ostringstream	css;
+    css << "rgsIoPads::find_rgsPad_enum() no enum for string:  " << name;
+    throw std::range_error ( css.str() );
+}
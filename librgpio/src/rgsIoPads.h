@@ -52,9 +52,24 @@ class rgsIoPads : public rgsIoBank {
 
     static const int	MaxBit = 27;	// Max register array index in any bank
 
+  public:
+    enum rgsPad_enum {		// pad profile, IoPad() register value [7:0]
+	pad_Reset   = 0x56,	// input, 4 mA, pull down, hysteresis
+	pad_FastSpi = 0x71,	// input, 12 mA, no pull, fast slew
+	pad_SlowIic = 0x5a,	// input, 4 mA, pull up, hysteresis
+	pad_InHyst  = 0xc2,	// output disabled, no pull, hysteresis
+	pad_Off     = 0x80	// output and input disabled
+    };
+
   private:	// register per pin
     rgsIo_Pad		PadReg[28];
 
+  private:	// shadow copy of hardware registers
+    bool		ShadowMode;	// 1= read from shadow, 0= hardware
+    uint32_t		StaleCount;	// registers found changed by refresh()
+    uint32_t		PadShadow[MaxBit+1];
+    uint32_t		VoltShadow;
+
   public:
     rgsIo_Pad&		IoPad( int bit );	// Register accessor
 
@@ -69,6 +84,28 @@ class rgsIoPads : public rgsIoBank {
     uint32_t		get_bcm_address()	{ return  FeatureAddr; }
     uint32_t		get_MaxBit()		{ return  MaxBit; }
 
+	// shadow cache
+    void		config_ShadowMode( bool v );
+    bool		config_ShadowMode()	{ return  ShadowMode; }
+
+    uint32_t		refresh();
+    uint32_t		get_StaleCount()	{ return  StaleCount; }
+    void		clear_StaleCount()	{ StaleCount = 0; }
+
+    uint32_t		read_pad(   int bit );
+    void		write_pad(  int bit,  uint32_t vv );
+    void		modify_pad( int bit,  uint32_t mask,  uint32_t vv );
+
+    uint32_t		read_volt();
+    void		write_volt( uint32_t vv );
+
+	// pad profile batch, return register access count
+    uint32_t		apply_profile( uint32_t mask,  uint32_t pad_word );
+    uint32_t		apply_volt( uint32_t low_1 );
+
+    static const char*	rgsPad_enum2cstr( rgsPad_enum prof );
+    static rgsPad_enum	find_rgsPad_enum( const char *name );
+
 	// base class
 //  uint32_t		get_bank_num()		{ return  BankNum; }
 //  volatile uint32_t*	get_base_addr()		{ return  GpioBase; }
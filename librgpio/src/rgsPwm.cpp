@@ -0,0 +1,271 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgsPwm - Pulse Width Modulator class for RPi5 (RP1)
+//
+// See:  doc/pwm_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+
+#include "rgsPwm.h"
+
+static const uint32_t	Pwm_SetUpdate = 1 << 31;	// GlobalCtrl
+
+
+/*
+* Constructor.
+* Require address map initialization.
+*    rgAddrMap	amx;		// address map object
+*    amx.open_dev_mem();	// select and open device file
+* call:
+*    rgsPwm	pwx  ( &amx );		// constructor with address map
+*    &amx  = pointer to address map object with open device file
+*    unit_num = PWM unit {0,1}, default 0
+*/
+rgsPwm::rgsPwm(
+    rgAddrMap		*xx,
+    uint32_t		unit_num
+)
+{
+    if ( !(rgRpiRev::Global.SocEnum.find() == rgRpiRev::soc_BCM2712) ) {
+	throw std::domain_error ( "rgsPwm::  require RPi5 (soc_BCM2712)" );
+    }
+
+    if ( unit_num > 1 ) {
+	throw std::range_error ( "rgsPwm::  require unit in {0,1}" );
+    }
+
+    UnitNum    = unit_num;
+
+    DocAddress = FeatureAddr + (UnitNum * 0x00004000);
+
+    GpioBase   = xx->get_mem_block( DocAddress );
+
+    GlobalCtrl.init_addr(  GpioBase + (0x00 /4) );
+    FifoCtrl.init_addr(    GpioBase + (0x04 /4) );
+    CommonRange.init_addr( GpioBase + (0x08 /4) );
+    CommonDuty.init_addr(  GpioBase + (0x0c /4) );
+    DutyFifo.init_addr(    GpioBase + (0x10 /4) );
+
+    for ( uint32_t ii=0;  ii<=MaxChan;  ii++ )
+    {
+	volatile uint32_t	*cb = GpioBase + ((0x14 + (ii * 0x10)) /4);
+
+	ChanCtrl[ii].init_addr(  cb + 0 );
+	ChanRange[ii].init_addr( cb + 1 );
+	ChanPhase[ii].init_addr( cb + 2 );
+	ChanDuty[ii].init_addr(  cb + 3 );
+    }
+
+    Intr.init_addr(        GpioBase + (0x54 /4) );
+    Inte.init_addr(        GpioBase + (0x58 /4) );
+    Intf.init_addr(        GpioBase + (0x5c /4) );
+    Ints.init_addr(        GpioBase + (0x60 /4) );
+}
+
+
+//--------------------------------------------------------------------------
+// Object state operations
+//--------------------------------------------------------------------------
+
+/*
+* Grab all readable registers into the objects.
+*    DutyFifo is write-only.
+*/
+void
+rgsPwm::grab_regs()
+{
+    GlobalCtrl.grab();
+    FifoCtrl.grab();
+    CommonRange.grab();
+    CommonDuty.grab();
+
+    for ( uint32_t ii=0;  ii<=MaxChan;  ii++ )
+    {
+	ChanCtrl[ii].grab();
+	ChanRange[ii].grab();
+	ChanPhase[ii].grab();
+	ChanDuty[ii].grab();
+    }
+
+    Inte.grab();
+    Intf.grab();
+}
+
+
+/*
+* Push configuration registers from the objects, then latch them.
+*    Channel registers first, GlobalCtrl last with SetUpdate_1=1.
+*    FifoCtrl, interrupt registers are not pushed.
+*/
+void
+rgsPwm::push_regs()
+{
+    CommonRange.push();
+    CommonDuty.push();
+
+    for ( uint32_t ii=0;  ii<=MaxChan;  ii++ )
+    {
+	ChanCtrl[ii].push();
+	ChanRange[ii].push();
+	ChanPhase[ii].push();
+	ChanDuty[ii].push();
+    }
+
+    GlobalCtrl.put_SetUpdate_1( 1 );
+    GlobalCtrl.push();
+}
+
+
+//--------------------------------------------------------------------------
+// Posted writes, no read
+//--------------------------------------------------------------------------
+// None of these read a register, so a control loop never waits on the
+// PCIe round trip to RP1.  Writes are posted and complete in order.
+
+/*
+* Set channel duty, effective at end of the current period.
+* call:
+*    self.set_duty( ch, duty )
+*    ch   = channel {0..3}
+*    duty = ChanDuty value, high count of Range
+* exceptions:
+*    range_error  ch out of range
+*/
+void
+rgsPwm::set_duty(
+    uint32_t		ch,
+    uint32_t		duty
+)
+{
+    check_chan( "set_duty", ch );
+
+    ChanDuty[ch].write( duty );
+    GlobalCtrl.write_set( Pwm_SetUpdate );
+}
+
+
+/*
+* Set duty of two channels, both effective at end of the same period.
+*    One SetUpdate_1 latch after both duty writes.
+* call:
+*    self.set_duty2( cha, duty_a, chb, duty_b )
+*    cha, chb = channels {0..3}
+* exceptions:
+*    range_error  ch out of range
+*/
+void
+rgsPwm::set_duty2(
+    uint32_t		cha,
+    uint32_t		duty_a,
+    uint32_t		chb,
+    uint32_t		duty_b
+)
+{
+    check_chan( "set_duty2", cha );
+    check_chan( "set_duty2", chb );
+
+    ChanDuty[cha].write( duty_a );
+    ChanDuty[chb].write( duty_b );
+    GlobalCtrl.write_set( Pwm_SetUpdate );
+}
+
+
+/*
+* Set channel range, effective at end of the current period.
+*    Duty and Range are latched together, so no ordering is needed.
+* call:
+*    self.set_range( ch, range )
+* exceptions:
+*    range_error  ch out of range
+*/
+void
+rgsPwm::set_range(
+    uint32_t		ch,
+    uint32_t		range
+)
+{
+    check_chan( "set_range", ch );
+
+    ChanRange[ch].write( range );
+    GlobalCtrl.write_set( Pwm_SetUpdate );
+}
+
+
+/*
+* Enable channels by atomic set of ChanEn_4, with update latch.
+* call:
+*    self.enable_chan( mask )
+*    mask = channel bit mask {0x0..0xf}
+* exceptions:
+*    range_error  mask above 0xf
+*/
+void
+rgsPwm::enable_chan(
+    uint32_t		mask
+)
+{
+    if ( mask > 0xf ) {
+	std::ostringstream	css;
+	css << "rgsPwm::enable_chan():  mask exceeds 0xf:  0x" <<hex << mask;
+	throw std::range_error ( css.str() );
+    }
+
+    GlobalCtrl.write_set( Pwm_SetUpdate | mask );
+}
+
+
+/*
+* Disable channels by atomic clear of ChanEn_4, with update latch.
+* call:
+*    self.disable_chan( mask )
+*    mask = channel bit mask {0x0..0xf}
+* exceptions:
+*    range_error  mask above 0xf
+*/
+void
+rgsPwm::disable_chan(
+    uint32_t		mask
+)
+{
+    if ( mask > 0xf ) {
+	std::ostringstream	css;
+	css << "rgsPwm::disable_chan():  mask exceeds 0xf:  0x" <<hex << mask;
+	throw std::range_error ( css.str() );
+    }
+
+    GlobalCtrl.write_clr( mask );
+    GlobalCtrl.write_set( Pwm_SetUpdate );
+}
+
+
+/*
+* Check channel number.
+* call:
+*    check_chan( "func_name", ch )
+* exceptions:
+*    range_error  ch above MaxChan
+*/
+void
+rgsPwm::check_chan(
+    const char*		fn,
+    uint32_t		ch
+)
+{
+    if ( ch > MaxChan ) {
+	std::ostringstream	css;
+	css << "rgsPwm::" << fn << "():  ch requires {0..3}:  " << ch;
+	throw std::range_error ( css.str() );
+    }
+}
+
@@ -0,0 +1,172 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgsPwm_P
+#define rgsPwm_P
+
+#include "rgsRegAtom.h"
+
+//--------------------------------------------------------------------------
+// rgsPwm - Pulse Width Modulator class for RPi5 (RP1)
+//--------------------------------------------------------------------------
+// Four channels per unit, PWM0 and PWM1, with a shared duty Fifo.
+// All registers have the atomic flip/set/clr aliases.
+// Channel Range, Phase, Duty and Ctrl writes take effect when SetUpdate_1
+// is written, at the end of the current period, so several channels can
+// be changed together.
+
+class rgsPwm_GlobalCtrl : public rgsRegAtom {
+  public:
+
+    inline
+    uint32_t	get_SetUpdate_1()        { return  get_field( 31, 0x1    ); }
+    void	put_SetUpdate_1( uint32_t v )    { put_field( 31, 0x1, v ); }
+
+    inline
+    uint32_t	get_ChanEn_4()           { return  get_field(  0, 0xf    ); }
+    void	put_ChanEn_4( uint32_t v )       { put_field(  0, 0xf, v ); }
+};
+
+class rgsPwm_FifoCtrl : public rgsRegAtom {
+  public:
+
+    inline
+    uint32_t	get_DreqEn_1()           { return  get_field( 31, 0x1    ); }
+    void	put_DreqEn_1( uint32_t v )       { put_field( 31, 0x1, v ); }
+
+    inline
+    uint32_t	get_FlushDone_1()        { return  get_field( 16, 0x1    ); }
+    void	put_FlushDone_1( uint32_t v )    { put_field( 16, 0x1, v ); }
+
+    inline
+    uint32_t	get_Flush_1()            { return  get_field( 15, 0x1    ); }
+    void	put_Flush_1( uint32_t v )        { put_field( 15, 0x1, v ); }
+
+    inline
+    uint32_t	get_DwellTime_5()        { return  get_field( 10, 0x1f   ); }
+    void	put_DwellTime_5( uint32_t v )    { put_field( 10, 0x1f, v ); }
+
+    inline
+    uint32_t	get_Threshold_5()        { return  get_field(  5, 0x1f   ); }
+    void	put_Threshold_5( uint32_t v )    { put_field(  5, 0x1f, v ); }
+
+    inline
+    uint32_t	get_Level_5()            { return  get_field(  0, 0x1f   ); }
+    void	put_Level_5( uint32_t v )        { put_field(  0, 0x1f, v ); }
+};
+
+class rgsPwm_ChanCtrl : public rgsRegAtom {
+  public:
+
+    inline
+    uint32_t	get_FifoPopMask_1()      { return  get_field(  8, 0x1    ); }
+    void	put_FifoPopMask_1( uint32_t v )  { put_field(  8, 0x1, v ); }
+
+    inline
+    uint32_t	get_UseFifo_1()          { return  get_field(  7, 0x1    ); }
+    void	put_UseFifo_1( uint32_t v )      { put_field(  7, 0x1, v ); }
+
+    inline
+    uint32_t	get_Bind_1()             { return  get_field(  4, 0x1    ); }
+    void	put_Bind_1( uint32_t v )         { put_field(  4, 0x1, v ); }
+
+    inline
+    uint32_t	get_Invert_1()           { return  get_field(  3, 0x1    ); }
+    void	put_Invert_1( uint32_t v )       { put_field(  3, 0x1, v ); }
+
+    inline
+    uint32_t	get_Mode_3()             { return  get_field(  0, 0x7    ); }
+    void	put_Mode_3( uint32_t v )         { put_field(  0, 0x7, v ); }
+};
+
+
+class rgsPwm {
+  public:
+    static const uint32_t	MaxChan   = 3;		// channels {0..3}
+    static const uint32_t	FifoDepth = 16;		// words
+
+					// Mode_3 values
+    enum rgsPwm_mode {
+	md_Zero = 0,		// output 0
+	md_TrailMs,		// trailing-edge mark/space
+	md_PhaseMs,		// phase-correct mark/space
+	md_Pdm,			// pulse density
+	md_SerMsb,		// serializer, MSB first
+	md_Ppm,			// pulse position
+	md_LeadMs,		// leading-edge mark/space
+	md_SerLsb		// serializer, LSB first
+    };
+
+  private:
+    uint32_t		UnitNum;	// PWM unit {0,1}
+    volatile uint32_t	*GpioBase;	// IO base address of unit
+    uint32_t		DocAddress;	// documentation base address
+
+    static const uint32_t  FeatureAddr = 0x40098000;
+			// PWM0, delta= 0x00004000, RP1 doc
+
+  public:
+				// Register data
+    rgsPwm_GlobalCtrl	GlobalCtrl;	// channel enable, update latch
+    rgsPwm_FifoCtrl	FifoCtrl;	// Fifo level, flush, DREQ
+    rgsRegAtom		CommonRange;	// range for bound channels
+    rgsRegAtom		CommonDuty;	// duty  for bound channels
+    rgsRegAtom		DutyFifo;	// Fifo input (WO)
+
+    rgsPwm_ChanCtrl	ChanCtrl[MaxChan+1];
+    rgsRegAtom		ChanRange[MaxChan+1];
+    rgsRegAtom		ChanPhase[MaxChan+1];
+    rgsRegAtom		ChanDuty[MaxChan+1];
+
+    rgsRegAtom		Intr;		// raw interrupts
+    rgsRegAtom		Inte;		// interrupt enable
+    rgsRegAtom		Intf;		// interrupt force
+    rgsRegAtom		Ints;		// interrupt status
+
+  public:
+    rgsPwm(			// constructor
+	rgAddrMap	*xx,
+	uint32_t	unit_num = 0	// PWM unit {0,1}
+    );
+
+    inline uint32_t	get_unit_num()		{ return  UnitNum; }
+    inline
+    volatile uint32_t*	get_base_addr()		{ return  GpioBase; }
+    inline uint32_t	get_bcm_address()	{ return  FeatureAddr; }
+    inline uint32_t	get_doc_address()	{ return  DocAddress; }
+    inline uint32_t	get_doc_offset( volatile uint32_t *a ) {
+				return  ((a - GpioBase) * 4);
+			    }
+
+		// Object state operations
+    void		grab_regs();
+    void		push_regs();
+
+		// Posted writes, no read
+
+    void		set_duty( uint32_t  ch,  uint32_t  duty );
+
+    void		set_duty2(
+			    uint32_t		cha,
+			    uint32_t		duty_a,
+			    uint32_t		chb,
+			    uint32_t		duty_b
+			);
+
+    void		set_range( uint32_t  ch,  uint32_t  range );
+
+    inline void		latch_update()	{ GlobalCtrl.write_set( 1 << 31 ); }
+
+    void		enable_chan(  uint32_t  mask );
+    void		disable_chan( uint32_t  mask );
+
+		// Fifo
+
+    inline uint32_t	fifo_level()	{ return  FifoCtrl.read() & 0x1f; }
+    inline void		fifo_flush()	{ FifoCtrl.write_set( 1 << 15 ); }
+
+  private:
+    void		check_chan( const char  *fn,  uint32_t  ch );
+};
+
+#endif
+
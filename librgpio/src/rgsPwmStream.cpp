@@ -0,0 +1,133 @@
+// 2026-10-19  William A. Hudson
+
+// rGPIO  rgsPwmStream - PWM Fifo sample streaming on rgsPwm (RPi5), no DMA
+//
+// See:  doc/pwm_design.text
+//
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>	// std::ostringstream
+#include <string>
+#include <stdexcept>
+
+using namespace std;
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgsPwm.h"
+#include "rgPwmStream.h"
+
+#include "rgsPwmStream.h"
+
+static const uint32_t	Pwm_FifoUnderflow = 1 << 0;	// Intr (W1C)
+
+
+/*
+* Constructor.
+*    No sample source;  use config_Ring() or config_Source().
+* call:
+*    rgsPwmStream	pst  ( &pwx, ch );
+*    &pwx  = PWM object
+*    ch    = channel whose ChanRange scales samples {0..3}
+* exceptions:
+*    range_error  ch out of range
+*/
+rgsPwmStream::rgsPwmStream(
+    rgsPwm		*pwx,
+    uint32_t		ch
+)
+{
+    if ( ch > rgsPwm::MaxChan ) {
+	std::ostringstream	css;
+	css << "rgsPwmStream::  ch requires {0..3}:  " << ch;
+	throw std::range_error ( css.str() );
+    }
+
+    Pwm       = pwx;
+    Chan      = ch;
+    GapCnt    = 0;
+    PollCnt   = 0;
+}
+
+
+//--------------------------------------------------------------------------
+// Streaming
+//--------------------------------------------------------------------------
+
+/*
+* Start a stream.
+*    Read ChanRange of the channel for the scale, clear counts and any
+*    converted words.  ChanCtrl (UseFifo_1), ChanEn_4 and fifo_flush() are
+*    left to the caller.
+* exceptions:
+*    range_error  no sample source configured
+*/
+void
+rgsPwmStream::start()
+{
+    if ( ! Feed.has_source() ) {
+	throw std::range_error ( "rgsPwmStream::start():  no sample source" );
+    }
+
+    Feed.start( Pwm->ChanRange[Chan].read() );
+
+    GapCnt    = 0;
+    PollCnt   = 0;
+}
+
+
+/*
+* Service the Fifo, one pass.
+*    Non-blocking;  call often enough that the Fifo does not run dry
+*    (FifoDepth words at the sample rate).
+*    Read FifoCtrl once and write the free room.  When the level is zero,
+*    read Intr and count FifoUnderflow in GapCnt, cleared by writing it.
+*    No samples available with Fifo room is counted in StarveCnt.
+* call:
+*    self.service()
+* return:
+*    ()  = number of words written
+*/
+uint32_t
+rgsPwmStream::service()
+{
+    uint32_t		lev  = Pwm->fifo_level();	// one status read
+    PollCnt++;
+
+    if ( lev == 0 ) {
+	if ( Pwm->Intr.read() & Pwm_FifoUnderflow ) {
+	    GapCnt++;
+	    Pwm->Intr.write( Pwm_FifoUnderflow );	// clear
+	}
+    }
+
+    uint32_t		room = ( lev < rgsPwm::FifoDepth )
+				? rgsPwm::FifoDepth - lev : 0;
+
+    return  Feed.write_fifo( &Pwm->DutyFifo, room );
+}
+
+
+/*
+* Stream until nword words are written, or stop().
+*    The last pass may exceed nword by up to FifoDepth - 1 words.
+* call:
+*    self.run( nword )
+*    nword = number of words, 0= until stop()
+* return:
+*    ()  = words written, get_WordCnt()
+*/
+uint64_t
+rgsPwmStream::run(
+    uint64_t		nword
+)
+{
+    while ( Feed.running( nword ) ) {
+	service();
+    }
+
+    return  Feed.get_WordCnt();
+}
+
@@ -0,0 +1,59 @@
+// 2026-10-19  William A. Hudson
+
+#ifndef rgsPwmStream_P
+#define rgsPwmStream_P
+
+#include "rgsPwm.h"
+#include "rgPwmStream.h"	// rgPwmStream_Feed
+
+//--------------------------------------------------------------------------
+// rgsPwmStream - PWM Fifo sample streaming on rgsPwm (RPi5), no DMA
+//--------------------------------------------------------------------------
+// Same sample feed as rgPwmStream on the BCM PWM (rgPwmStream_Feed):
+// rgPwmStream_Ring or rgPwmStream_Source, scaled by rgPwmStream::convert().
+// The RP1 Fifo shows its fill level, so each service() pass reads FifoCtrl
+// once and writes exactly the free room, up to FifoDepth words.  Duty
+// writes are posted (DutyFifo is write-only).  Only when the Fifo reads
+// empty is Intr read for FifoUnderflow, which is counted as an underrun.
+//
+// e.g.
+//    rgsPwmStream	pst   ( &pwx, 0 );	// channel 0 range
+//    pst.config_Ring( &ring );
+//    pst.start();			// after ChanCtrl UseFifo_1, ChanEn
+//    pst.run( 0 );			// until stop() from another thread
+
+class rgsPwmStream {
+  private:
+    rgsPwm		*Pwm;		// PWM unit
+    uint32_t		Chan;		// channel for Range {0..3}
+    rgPwmStream_Feed	Feed;		// samples, Range from ChanRange
+
+    uint64_t		GapCnt;		// FifoUnderflow seen, underruns
+    uint64_t		PollCnt;	// FifoCtrl reads
+
+  public:
+    rgsPwmStream(		// constructor
+	rgsPwm		*pwx,
+	uint32_t	ch = 0		// channel for Range {0..3}
+    );
+
+    inline void		config_Ring( rgPwmStream_Ring  *ring )
+			    { Feed.config_Ring( ring ); }
+    inline void		config_Source( rgPwmStream_Source  fn,  void  *ctx )
+			    { Feed.config_Source( fn, ctx ); }
+
+    void		start();
+    uint32_t		service();
+    uint64_t		run( uint64_t  nword );
+    inline void		stop()    { Feed.stop(); }
+
+    inline uint32_t	get_Chan()       { return  Chan; }
+    inline uint32_t	get_Range()      { return  Feed.get_Range(); }
+    inline uint64_t	get_WordCnt()    { return  Feed.get_WordCnt(); }
+    inline uint64_t	get_GapCnt()     { return  GapCnt; }
+    inline uint64_t	get_StarveCnt()  { return  Feed.get_StarveCnt(); }
+    inline uint64_t	get_PollCnt()    { return  PollCnt; }
+};
+
+#endif
+
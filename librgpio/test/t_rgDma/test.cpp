@@ -0,0 +1,642 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgDma  DMA Controller channel class.
+//    10-19  Constructor, get_bcm_address()
+//    20-29  Address of registers  addr()
+//    30-39  Channel allocation  alloc_channel(), free_channel()
+//    40-49  Direct control  start(), poll_done(), clear_end(), reset()
+//    50-59  Field accessors  get_(), put_()
+//    60-69  rgDma_Chain  constructor, add_cb(), close_loop()
+//    70-79  rgDma_Chain  streaming helpers
+//    80-89  rgDma_Chain  Lite channel limits
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgDma.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgDma			Tx   ( &Bx, 5 );		// test object
+
+//--------------------------------------------------------------------------
+//## Constructor, get_bcm_address()
+//--------------------------------------------------------------------------
+
+  CASE( "10a", "constructor channel 0" );
+    try {
+	rgDma		tx  ( &Bx, 0 );
+	CHECKX( 0x7e007000, tx.get_bcm_address() );
+	CHECK(  0,          tx.get_chan_num() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "10b", "constructor channel 14" );
+    try {
+	rgDma		tx  ( &Bx, 14 );
+	CHECKX( 0x7e007e00, tx.get_bcm_address() );
+	CHECK(  14,         tx.get_chan_num() );
+	CHECK(  14,         rgDma::max_chan() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "10c", "constructor bad channel" );
+    try {
+	rgDma		tx  ( &Bx, 15 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma:  constructor requires channel {0..14}:  15",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11a", "RPi4 constructor DMA4 channel" );
+    try {
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );
+	CHECK(  10,         rgDma::max_chan() );
+	rgDma		tx  ( &Bx, 11 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma:  constructor requires channel {0..10}:  11",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11b", "rgDma domain_error RPi5" );
+    try {
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );
+	rgDma		tx  ( &Bx, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( std::domain_error& e ) {
+	CHECK( "rgDma:  require RPi4 (soc_BCM2711) or earlier", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+  CASE( "12", "is_lite()" );
+    try {
+	rgDma		t6  ( &Bx, 6 );
+	rgDma		t7  ( &Bx, 7 );
+	rgDma		t14 ( &Bx, 14 );
+	CHECK(  0,          t6.is_lite() );
+	CHECK(  1,          t7.is_lite() );
+	CHECK(  1,          t14.is_lite() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Address of registers  addr()
+//--------------------------------------------------------------------------
+
+  CASE( "21", "register offsets" );
+    try {
+	volatile uint32_t*	base = Tx.get_base_addr();
+	CHECK(  0,          Tx.CntlStat.addr() - base );
+	CHECK(  1,          Tx.CbAddr.addr()   - base );
+	CHECK(  2,          Tx.TxInfo.addr()   - base );
+	CHECK(  3,          Tx.SrcAddr.addr()  - base );
+	CHECK(  4,          Tx.DestAddr.addr() - base );
+	CHECK(  5,          Tx.TxLen.addr()    - base );
+	CHECK(  6,          Tx.Stride.addr()   - base );
+	CHECK(  7,          Tx.NextCb.addr()   - base );
+	CHECK(  8,          Tx.Debug.addr()    - base );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "channel spacing" );
+    try {
+	rgDma		t4  ( &Bx, 4 );
+	CHECK(  0x40,       Tx.get_base_addr() - t4.get_base_addr() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Channel allocation  alloc_channel(), free_channel()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "alloc_channel() lowest usable" );
+    try {
+	CHECKX( 0x0000,     rgDma::get_AllocMask() );
+	CHECK(  2,          rgDma::alloc_channel( 0x7f34 ) );
+	CHECK(  4,          rgDma::alloc_channel( 0x7f34 ) );
+	CHECK(  5,          rgDma::alloc_channel( 0x7f34 ) );
+	CHECKX( 0x0034,     rgDma::get_AllocMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "free_channel()" );
+    try {
+	rgDma::free_channel( 4 );
+	CHECKX( 0x0024,     rgDma::get_AllocMask() );
+	CHECK(  4,          rgDma::alloc_channel( 0x7f34 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "alloc_channel() none free" );
+    try {
+	rgDma::alloc_channel( 0x0034 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma::alloc_channel():  no free channel in mask:  0x00000034",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "alloc_channel() ignores channel 15 and above" );
+    try {
+	rgDma::alloc_channel( 0xffff8000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma::alloc_channel():  no free channel in mask:  0xffff8000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "34", "free_channel() not allocated" );
+    try {
+	rgDma::free_channel( 3 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma::free_channel():  channel not allocated:  3",
+	    e.what()
+	);
+	rgDma::free_channel( 2 );
+	rgDma::free_channel( 4 );
+	rgDma::free_channel( 5 );
+	CHECKX( 0x0000,     rgDma::get_AllocMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Direct control  start(), poll_done(), clear_end(), reset()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "start()" );
+    try {
+	Tx.CntlStat.put( 0xffffffff );
+	Tx.start( 0xc0001000 );
+	CHECKX( 0xc0001000, Tx.CbAddr.read() );
+	CHECKX( 0x30ff0007, Tx.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "start() not aligned" );
+    try {
+	Tx.start( 0xc0001010 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma::start():  require 32-byte aligned cb_bus:  0xc0001010",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "poll_done()" );
+    try {
+	Tx.CntlStat.write( 0x00000001 );
+	CHECK(  0,          Tx.poll_done() );
+	Tx.CntlStat.write( 0x00000102 );	// End, Error
+	CHECK(  1,          Tx.poll_done() );
+	CHECK(  1,          Tx.CntlStat.get_Error_1() );
+	CHECK(  1,          Tx.CntlStat.get_End_1() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "clear_end(), reset()" );
+    try {
+	Tx.clear_end();
+	CHECKX( 0x00000006, Tx.CntlStat.read() );
+	Tx.reset();
+	CHECKX( 0x80000000, Tx.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "44", "init_put_reset(), grab_regs()" );
+    try {
+	Tx.CntlStat.write( 0x11111111 );
+	Tx.NextCb.write(   0x22222222 );
+	Tx.init_put_reset();
+	CHECKX( 0x00000000, Tx.CntlStat.get() );
+	CHECKX( 0x00000000, Tx.NextCb.get() );
+	Tx.grab_regs();
+	CHECKX( 0x11111111, Tx.CntlStat.get() );
+	CHECKX( 0x22222222, Tx.NextCb.get() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Field accessors  get_(), put_()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "CntlStat fields" );
+    try {
+	Tx.CntlStat.put( 0x00000000 );
+	Tx.CntlStat.put_WaitWrites_1( 1 );
+	Tx.CntlStat.put_PanicPrio_4(  0xf );
+	Tx.CntlStat.put_Priority_4(   0x8 );
+	CHECKX( 0x10f80000, Tx.CntlStat.get() );
+	CHECK(  0x8,        Tx.CntlStat.get_Priority_4() );
+	Tx.CntlStat.put( 0xffffffff );
+	Tx.CntlStat.put_Active_1(     0 );
+	Tx.CntlStat.put_Reset_1(      0 );
+	CHECKX( 0x7ffffffe, Tx.CntlStat.get() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "TxInfo fields" );
+    try {
+	Tx.TxInfo.put( 0x00000000 );
+	Tx.TxInfo.put_PerMap_5(    0x1f );
+	Tx.TxInfo.put_Waits_5(     0x01 );
+	Tx.TxInfo.put_BurstLen_4(  0x2 );
+	Tx.TxInfo.put_IntEnable_1( 1 );
+	CHECKX( 0x003f2001, Tx.TxInfo.get() );
+	CHECK(  0x1f,       Tx.TxInfo.get_PerMap_5() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "TxInfo.put_PerMap_5() range" );
+    try {
+	Tx.TxInfo.put_PerMap_5( 0x20 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgRegister::put_field():  value exceeds 0x1f:  0x20",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgDma_Chain  constructor, add_cb(), close_loop()
+//--------------------------------------------------------------------------
+
+uint32_t		mem[33];	// 4 Control Blocks, plus guard
+const uint32_t		Bus  = 0xc0001000;
+
+  CASE( "60", "constructor" );
+    try {
+	rgDma_Chain	cx  ( mem, Bus, 4 * 32 );
+	CHECK(  4,          cx.get_MaxCb() );
+	CHECK(  0,          cx.get_NumCb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "61", "constructor not aligned" );
+    try {
+	rgDma_Chain	cx  ( mem, Bus + 4, 4 * 32 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain:  require 32-byte aligned bus address:  0xc0001004",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "62", "constructor too small" );
+    try {
+	rgDma_Chain	cx  ( mem, Bus, 31 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain:  memory smaller than one Control Block:  31",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgDma_Chain		Cx   ( mem, Bus, 4 * 32 );
+
+  CASE( "63", "add_cb() first block" );
+    try {
+	for ( int i=0;  i<33;  i++ ) { mem[i] = 0xdeadbeef; }
+	CHECK(  0,          Cx.add_cb( 0x11, 0x22, 0x33, 0x44, 0x55 ) );
+	CHECKX( 0x00000011, mem[0] );
+	CHECKX( 0x00000022, mem[1] );
+	CHECKX( 0x00000033, mem[2] );
+	CHECKX( 0x00000044, mem[3] );
+	CHECKX( 0x00000055, mem[4] );
+	CHECKX( 0x00000000, mem[5] );
+	CHECKX( 0x00000000, mem[6] );
+	CHECKX( 0x00000000, mem[7] );
+	CHECKX( 0xdeadbeef, mem[8] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "64", "add_cb() links previous" );
+    try {
+	CHECK(  1,          Cx.add_cb( 0x66, 0x77, 0x88, 0x99 ) );
+	CHECKX( 0xc0001020, mem[5] );
+	CHECKX( 0x00000066, mem[8] );
+	CHECKX( 0x00000000, mem[12] );		// default stride
+	CHECKX( 0x00000000, mem[13] );
+	CHECK(  2,          Cx.get_NumCb() );
+	CHECKX( 0xc0001020, Cx.cb_bus( 1 ) );
+	CHECK(  8,          Cx.cb_addr( 1 ) - Cx.cb_addr( 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "65", "close_loop()" );
+    try {
+	Cx.close_loop();
+	CHECKX( 0xc0001000, mem[13] );
+	CHECKX( 0xc0001020, mem[5] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "66", "add_cb() len zero" );
+    try {
+	Cx.add_cb( 0x66, 0x77, 0x88, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::add_cb():  require len {1..0x3fffffff}:  0x0",
+	    e.what()
+	);
+	CHECK(  2,          Cx.get_NumCb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "67", "add_cb() exceeds MaxCb" );
+    try {
+	Cx.add_cb( 1, 2, 3, 4 );
+	Cx.add_cb( 1, 2, 3, 4 );
+	CHECKX( 0xc0001060, mem[21] );
+	Cx.add_cb( 1, 2, 3, 4 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::add_cb():  exceeds MaxCb:  4",
+	    e.what()
+	);
+	CHECKX( 0xdeadbeef, mem[32] );		// guard
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "68", "cb_bus() bad index" );
+    try {
+	Cx.cb_bus( 4 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::cb_bus():  index exceeds NumCb:  4",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "69", "clear(), close_loop() empty" );
+    try {
+	Cx.clear();
+	CHECK(  0,          Cx.get_NumCb() );
+	Cx.close_loop();
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::close_loop():  empty chain",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgDma_Chain  streaming helpers
+//--------------------------------------------------------------------------
+
+  CASE( "70", "ti_mem2per(), ti_per2mem()" );
+    try {
+	CHECKX( 0x04060148, rgDma_Chain::ti_mem2per( 6 ) );
+	CHECKX( 0x04070418, rgDma_Chain::ti_per2mem( 7 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "71", "add_spi0_tx(), add_spi0_rx()" );
+    try {
+	Cx.clear();
+	CHECK(  0,          Cx.add_spi0_tx( 0xc0002000, 260 ) );
+	CHECK(  1,          Cx.add_spi0_rx( 0xc0003000, 256 ) );
+	CHECKX( 0x04060148, mem[0] );
+	CHECKX( 0xc0002000, mem[1] );
+	CHECKX( 0x7e204004, mem[2] );
+	CHECK(  260,        mem[3] );
+	CHECKX( 0x04070418, mem[8] );
+	CHECKX( 0x7e204004, mem[9] );
+	CHECKX( 0xc0003000, mem[10] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "72", "add_pwm_tx(), add_pcm_tx(), add_pcm_rx()" );
+    try {
+	Cx.clear();
+	Cx.add_pwm_tx( 0xc0002000, 64 );
+	Cx.add_pcm_tx( 0xc0002000, 64 );
+	Cx.add_pcm_rx( 0xc0003000, 64 );
+	CHECKX( 0x04050148, mem[0] );
+	CHECKX( 0x7e20c018, mem[2] );
+	CHECKX( 0x04020148, mem[8] );
+	CHECKX( 0x7e203004, mem[10] );
+	CHECKX( 0x04030418, mem[16] );
+	CHECKX( 0x7e203004, mem[17] );
+	CHECKX( 0xc0001040, mem[13] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgDma_Chain  Lite channel limits
+//--------------------------------------------------------------------------
+
+  CASE( "80", "config_Lite() default, full channel len" );
+    try {
+	Cx.clear();
+	CHECK(  0,          Cx.config_Lite() );
+	CHECK(  0,          Cx.add_pwm_tx( 0xc0002000, 0x10000 ) );
+	CHECK(  0x10000,    mem[3] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "81", "config_Lite() len 0xffff ok" );
+    try {
+	rgDma		dx  ( &Bx, 8 );
+	Cx.clear();
+	Cx.config_Lite( dx.is_lite() );
+	CHECK(  1,          Cx.config_Lite() );
+	CHECK(  0,          Cx.add_cb( 0x11, 0x22, 0x33, 0xffff ) );
+	CHECK(  0xffff,     mem[3] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "82", "config_Lite() len exceeds 16 bits" );
+    try {
+	Cx.add_cb( 0x11, 0x22, 0x33, 0x10000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::add_cb():  require len {1..0xffff}:  0x10000",
+	    e.what()
+	);
+	CHECK(  1,          Cx.get_NumCb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "83", "config_Lite() streaming helper len" );
+    try {
+	Cx.add_spi0_rx( 0xc0003000, 0x20000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::add_cb():  require len {1..0xffff}:  0x20000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "84", "config_Lite() stride" );
+    try {
+	Cx.add_cb( 0x11, 0x22, 0x33, 0x44, 0x55 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::add_cb():  Lite channel has no 2D mode",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "85", "config_Lite() TdMode_1" );
+    try {
+	Cx.add_cb( 0x02, 0x22, 0x33, 0x44 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgDma_Chain::add_cb():  Lite channel has no 2D mode",
+	    e.what()
+	);
+	CHECK(  1,          Cx.get_NumCb() );
+	Cx.config_Lite( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
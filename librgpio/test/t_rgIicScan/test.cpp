@@ -0,0 +1,286 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgIicScan  I2C bus scan on several rgIic units.
+//    10-19  Constructor
+//    20-29  add_unit(), config_Range()
+//    30-39  run() results by Stat
+//    40-49  Probe mode, get_result()
+//
+// Units 3,4 are used since they do not overlap in the fake memory page.
+// Presetting Stat gives every probe the same result:  TransDone_1 found,
+// AckErr_1 absent, ClkTimeout_1, or zero never completes.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+#include "rgIicScan.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );	// RPi4
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgIic			Ic3  ( &Bx, 3 );
+rgIic			Ic4  ( &Bx, 4 );
+
+rgIicScan		Tx;			// test object
+
+//--------------------------------------------------------------------------
+//## Constructor
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults" );
+    try {
+	rgIicScan	tx;
+	CHECK(  0,          tx.get_NumUnit() );
+	CHECK(  0,          tx.get_PollCnt() );
+	CHECK(  rgIicScan::sm_Auto,  tx.config_Mode() );
+	CHECKX( 0x08,       tx.config_First() );
+	CHECKX( 0x77,       tx.config_Last() );
+	CHECK(  1000000,    tx.config_PollLimit() );
+	CHECK(  0,          tx.run() );		// no units
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## add_unit(), config_Range()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "add_unit()" );
+    try {
+	CHECK(  0,          Tx.add_unit( &Ic3 ) );
+	CHECK(  1,          Tx.add_unit( &Ic4 ) );
+	CHECK(  2,          Tx.get_NumUnit() );
+	CHECK(  rgIicScan::sr_None,  Tx.get_result( 1, 0x68 ) );
+	CHECK(  0,          Tx.get_FoundCnt( 1 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "add_unit() duplicate" );
+    try {
+	rgIic		ic4b  ( &Bx, 4 );
+	Tx.add_unit( &ic4b );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicScan::add_unit():  duplicate iic unit:  4", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "config_Range()" );
+    try {
+	rgIicScan	tx;
+	tx.config_Range( 0x00, 0x7f );
+	CHECKX( 0x00,       tx.config_First() );
+	CHECKX( 0x7f,       tx.config_Last() );
+	tx.config_Range( 0x50, 0x50 );
+	CHECKX( 0x50,       tx.config_First() );
+	CHECKX( 0x50,       tx.config_Last() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23a", "config_Range() first > last" );
+    try {
+	Tx.config_Range( 0x51, 0x50 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicScan::config_Range():  require first <= last <= 0x7f:  0x51 0x50",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23b", "config_Range() last > 0x7f" );
+    try {
+	Tx.config_Range( 0x08, 0x80 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicScan::config_Range():  require first <= last <= 0x7f:  0x8 0x80",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run() results by Stat
+//--------------------------------------------------------------------------
+
+  CASE( "30", "run() all found, one pass per address" );
+    try {
+	Ic3.Stat.write( 0x00000002 );		// TransDone
+	Ic4.Stat.write( 0x00000002 );
+	CHECK(  224,        Tx.run() );
+	CHECK(  112,        Tx.get_FoundCnt( 0 ) );
+	CHECK(  112,        Tx.get_FoundCnt( 1 ) );
+	CHECK(  224,        Tx.get_PollCnt() );
+	CHECK(  1,          Tx.is_found( 0, 0x08 ) );
+	CHECK(  1,          Tx.is_found( 1, 0x77 ) );
+	CHECK(  rgIicScan::sr_None,  Tx.get_result( 0, 0x07 ) );
+	CHECK(  rgIicScan::sr_None,  Tx.get_result( 1, 0x78 ) );
+	CHECKX( 0x00000077, Ic3.Addr.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "run() AckErr_1 absent on one unit" );
+    try {
+	Ic3.Stat.write( 0x00000100 );		// AckErr
+	CHECK(  112,        Tx.run() );
+	CHECK(  0,          Tx.get_FoundCnt( 0 ) );
+	CHECK(  112,        Tx.get_FoundCnt( 1 ) );
+	CHECK(  rgIicScan::sr_Absent,  Tx.get_result( 0, 0x68 ) );
+	CHECK(  rgIicScan::sr_Found,   Tx.get_result( 1, 0x68 ) );
+	CHECKX( 0x00008010, Ic3.Cntl.read() );	// Fifo cleared
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "run() ClkTimeout_1" );
+    try {
+	Ic3.Stat.write( 0x00000200 );		// ClkTimeout
+	Tx.run();
+	CHECK(  rgIicScan::sr_ClkTimeout,  Tx.get_result( 0, 0x20 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "run() PollLimit abandons probe" );
+    try {
+	Ic3.Stat.write( 0x00000000 );		// never completes
+	Tx.config_Range( 0x10, 0x11 );
+	Tx.config_PollLimit( 3 );
+	CHECK(  2,          Tx.run() );		// unit 4 only
+	CHECK(  rgIicScan::sr_PollLimit,  Tx.get_result( 0, 0x10 ) );
+	CHECK(  rgIicScan::sr_PollLimit,  Tx.get_result( 0, 0x11 ) );
+	CHECK(  8,          Tx.get_PollCnt() );	// 2*3 + 2*1
+	CHECKX( 0x00008010, Ic3.Cntl.read() );
+	Tx.config_PollLimit( 1000000 );
+	Ic3.Stat.write( 0x00000002 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Probe mode, get_result()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "sm_Quick zero-length write" );
+    try {
+	Tx.config_Mode( rgIicScan::sm_Quick );
+	Tx.config_Range( 0x50, 0x50 );
+	CHECK(  2,          Tx.run() );
+	CHECKX( 0x00008080, Ic3.Cntl.read() );
+	CHECKX( 0x00000000, Ic3.DatLen.read() );
+	CHECKX( 0x00000050, Ic3.Addr.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "sm_Read one byte read" );
+    try {
+	Tx.config_Mode( rgIicScan::sm_Read );
+	Tx.config_Range( 0x20, 0x20 );
+	CHECK(  2,          Tx.run() );
+	CHECKX( 0x00008081, Ic3.Cntl.read() );
+	CHECKX( 0x00000001, Ic3.DatLen.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42a", "sm_Auto reads EEPROM range" );
+    try {
+	Tx.config_Mode( rgIicScan::sm_Auto );
+	Tx.config_Range( 0x5f, 0x5f );
+	CHECK(  2,          Tx.run() );
+	CHECKX( 0x00008081, Ic3.Cntl.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42b", "sm_Auto quick write elsewhere" );
+    try {
+	Tx.config_Range( 0x60, 0x60 );
+	CHECK(  2,          Tx.run() );
+	CHECKX( 0x00008080, Ic3.Cntl.read() );
+	CHECK(  rgIicScan::sr_None,  Tx.get_result( 0, 0x5f ) );	// reset
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43a", "get_result() index error" );
+    try {
+	Tx.get_result( 2, 0x50 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicScan::get_result():  index exceeds NumUnit:  2",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43b", "get_result() addr error" );
+    try {
+	Tx.is_found( 0, 0x80 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicScan::get_result():  addr exceeds 0x7f:  0x80", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+  CASE( "99", "Done" );
+}
+
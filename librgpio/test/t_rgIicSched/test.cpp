@@ -0,0 +1,381 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgIicSched  Periodic I2C register polling over several units.
+//    10-19  Constructor
+//    20-29  add_job(), clear()
+//    30-39  service_all() interleaving and due times
+//    40-49  get_result(), get_LateCnt()
+//    50-59  run(), stop()
+//
+// Units 3,4,5 are used since they do not overlap in the fake memory page.
+// Fake memory has a single Fifo word per unit, so every Rx byte read is
+// the register byte written.  Stat TransActive_1, TransDone_1 are preset,
+// so each job takes a start pass and two service passes.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+#include "rgSysTimer.h"
+#include "rgIicSched.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );	// RPi4
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgIic			Ic3  ( &Bx, 3 );
+rgIic			Ic4  ( &Bx, 4 );
+rgIic			Ic5  ( &Bx, 5 );
+rgSysTimer		Stx  ( &Bx );
+
+rgIicSched		Tx   ( &Stx );		// test object
+
+rgIicSched_Result	rr;
+
+Ic3.Stat.write( 0x00000003 );		// TransActive, TransDone
+Ic4.Stat.write( 0x00000003 );
+Ic5.Stat.write( 0x00000003 );
+
+//--------------------------------------------------------------------------
+//## Constructor
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor" );
+    try {
+	rgIicSched	tx  ( &Stx );
+	CHECK(  0,          tx.get_NumJob() );
+	CHECK(  0,          tx.get_NumUnit() );
+	CHECK(  0,          tx.get_PassCnt() );
+	CHECK(  0,          tx.get_XferCnt() );
+	CHECK(  0,          tx.get_ErrCnt() );
+	CHECK(  0,          tx.service_all( 100 ) );	// no jobs
+	CHECK(  1,          tx.get_PassCnt() );
+	CHECK(  32,         rgIicSched::MaxJob );
+	CHECK(  16,         rgIicSched::MaxLen );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## add_job(), clear()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "add_job() units by object" );
+    try {
+	CHECK(  0,          Tx.add_job( &Ic3, 0x68, 0x10, 2, 1000 ) );
+	CHECK(  1,          Tx.add_job( &Ic3, 0x69, 0x20, 1, 1000 ) );
+	CHECK(  2,          Tx.add_job( &Ic4, 0x48, 0x30, 3,  500 ) );
+	CHECK(  3,          Tx.add_job( &Ic5, 0x40, 0x40, 16, 10000 ) );
+	CHECK(  4,          Tx.get_NumJob() );
+	CHECK(  3,          Tx.get_NumUnit() );
+	CHECK(  0,          Tx.get_result( 0, rr ) );	// none yet
+	CHECK(  0,          rr.Seq );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "add_job() addr error" );
+    try {
+	Tx.add_job( &Ic3, 0x80, 0x10, 2, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicSched::add_job():  addr exceeds 0x7f:  0x80", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "add_job() reg error" );
+    try {
+	Tx.add_job( &Ic3, 0x68, 0x100, 2, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicSched::add_job():  reg exceeds 0xff:  0x100", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23a", "add_job() len zero" );
+    try {
+	Tx.add_job( &Ic3, 0x68, 0x10, 0, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicSched::add_job():  len requires {1..16}:  0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23b", "add_job() len exceeds MaxLen" );
+    try {
+	Tx.add_job( &Ic3, 0x68, 0x10, 17, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicSched::add_job():  len requires {1..16}:  17", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "add_job() exceeds MaxJob" );
+    try {
+	rgIicSched	tx  ( &Stx );
+	for ( uint32_t i=0;  i < rgIicSched::MaxJob;  i++ ) {
+	    tx.add_job( &Ic3, 0x68, i, 1, 1000 );
+	}
+	CHECK(  32,         tx.get_NumJob() );
+	tx.add_job( &Ic3, 0x68, 0x10, 1, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicSched::add_job():  exceeds MaxJob:  32", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "clear()" );
+    try {
+	rgIicSched	tx  ( &Stx );
+	tx.add_job( &Ic3, 0x68, 0x10, 1, 1000 );
+	tx.service_all( 100 );
+	tx.clear();
+	CHECK(  0,          tx.get_NumJob() );
+	CHECK(  0,          tx.get_NumUnit() );
+	CHECK(  0,          tx.get_PassCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## service_all() interleaving and due times
+//--------------------------------------------------------------------------
+
+  CASE( "30", "first pass starts one job per unit" );
+    try {
+	CHECK(  3,          Tx.service_all( 5000 ) );
+	CHECKX( 0x00000068, Ic3.Addr.read() );		// job 0
+	CHECKX( 0x00000010, Ic3.Fifo.read() );
+	CHECKX( 0x00000048, Ic4.Addr.read() );		// job 2
+	CHECKX( 0x00000040, Ic5.Addr.read() );		// job 3
+	CHECKX( 0x00008080, Ic4.Cntl.read() );		// write started
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "second pass queues reads" );
+    try {
+	CHECK(  3,          Tx.service_all( 5001 ) );
+	CHECKX( 0x00008081, Ic3.Cntl.read() );
+	CHECKX( 0x00000003, Ic4.DatLen.read() );
+	CHECKX( 0x00000010, Ic5.DatLen.read() );
+	CHECK(  0,          Tx.get_XferCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "third pass completes, starts next due" );
+    try {
+	CHECK(  1,          Tx.service_all( 5002 ) );	// job 1
+	CHECK(  3,          Tx.get_XferCnt() );
+	CHECKX( 0x00000069, Ic3.Addr.read() );
+	CHECKX( 0x00000020, Ic3.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "job 1 completes, nothing due" );
+    try {
+	CHECK(  1,          Tx.service_all( 5003 ) );
+	CHECK(  0,          Tx.service_all( 5004 ) );
+	CHECK(  4,          Tx.get_XferCnt() );
+	CHECK(  0,          Tx.get_ErrCnt() );
+	CHECK(  5,          Tx.get_PassCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "34", "due times advance by period" );
+    try {
+	CHECK(  1,          Tx.service_all( 5999 ) );	// only job 2 due
+	CHECKX( 0x00000048, Ic4.Addr.read() );
+	CHECK(  2,          Tx.service_all( 6000 ) );	// job 0 due
+	CHECKX( 0x00000068, Ic3.Addr.read() );
+	CHECK(  2,          Tx.service_all( 6001 ) );	// job 2 again
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "35", "period 0 restarts on completion pass" );
+    try {
+	rgIicSched	tx  ( &Stx );
+	tx.add_job( &Ic5, 0x40, 0x40, 1, 0 );
+	CHECK(  1,          tx.service_all( 1 ) );
+	CHECK(  1,          tx.service_all( 1 ) );
+	CHECK(  1,          tx.service_all( 1 ) );
+	CHECK(  1,          tx.get_XferCnt() );
+	CHECK(  0,          tx.get_LateCnt( 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## get_result(), get_LateCnt()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "get_result() job 0" );
+    try {
+	CHECK(  1,          Tx.get_result( 0, rr ) );
+	CHECK(  5002,       (uint32_t)rr.Time );
+	CHECK(  1,          rr.Seq );
+	CHECK(  0,          rr.Err );
+	CHECK(  2,          rr.Len );
+	CHECKX( 0x10,       rr.Data[0] );
+	CHECKX( 0x10,       rr.Data[1] );
+	CHECKX( 0x00,       rr.Data[2] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "get_result() job 2, newest of two" );
+    try {
+	CHECK(  1,          Tx.get_result( 2, rr ) );
+	CHECK(  6001,       (uint32_t)rr.Time );
+	CHECK(  2,          rr.Seq );
+	CHECK(  3,          rr.Len );
+	CHECKX( 0x30,       rr.Data[2] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "get_result() AckErr_1" );
+    try {
+	Ic4.Stat.write( 0x00000100 );		// AckErr
+	CHECK(  2,          Tx.service_all( 7000 ) );	// error, restart
+	CHECK(  1,          Tx.service_all( 7001 ) );	// error
+	CHECK(  2,          Tx.get_ErrCnt() );
+	CHECK(  1,          Tx.get_result( 2, rr ) );
+	CHECK(  4,          rr.Seq );
+	CHECKX( 0x00000100, rr.Err );
+	CHECK(  7001,       (uint32_t)rr.Time );
+	Ic4.Stat.write( 0x00000003 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "late job rescheduled from now" );
+    try {
+	CHECK(  0,          Tx.get_LateCnt( 0 ) );
+	CHECK(  0,          Tx.get_LateCnt( 1 ) );
+	CHECK(  1,          Tx.get_LateCnt( 2 ) );	// due 6500, at 7000
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "44", "get_result() index error" );
+    try {
+	Tx.get_result( 4, rr );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicSched::get_result():  index exceeds NumJob:  4",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run(), stop()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "run() after stop() completes transactions in flight" );
+    try {
+	Stx.TimeW1.write( 0x00000000 );
+	Stx.TimeW0.write( 0x00002000 );
+	uint64_t	x0 = Tx.get_XferCnt();
+	Tx.stop();
+	CHECK(  1,          Tx.run( 0 ) );		// job 1 in flight
+	CHECK(  x0 + 1,     Tx.get_XferCnt() );
+	CHECK(  0,          Tx.service_all( 0x1000 ) );	// none due
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "stop() request cleared by run()" );
+    try {
+	Tx.stop();
+	CHECK(  0,          Tx.run( 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "run() after stop(), stuck unit ends at PollLimit" );
+    try {
+	uint64_t	e0 = Tx.get_ErrCnt();
+	Ic5.config_PollLimit( 4 );
+	Ic5.Stat.write( 0x00000000 );		// never TransActive
+	CHECK(  3,          Tx.service_all( 0x100000 ) );	// all due
+	Tx.stop();
+	CHECK(  3,          Tx.run( 0 ) );
+	CHECK(  e0 + 1,     Tx.get_ErrCnt() );
+	CHECK(  1,          Tx.get_result( 3, rr ) );
+	CHECKX( 0x80000000, rr.Err );			// ErrPollLimit
+	CHECK(  0,          Ic5.is_busy() );
+	Ic5.config_PollLimit( 1000000 );
+	Ic5.Stat.write( 0x00000003 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+  CASE( "99", "Done" );
+}
+
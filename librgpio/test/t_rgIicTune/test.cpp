@@ -0,0 +1,327 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgIicTune  Per-device I2C clock tuning for rgIic.
+//    10-19  Constructor
+//    20-29  config_*()
+//    30-39  tune()
+//    40-49  calc_profile(), apply_profile(), grab_profile()
+//
+// Fake memory has a single Fifo word, so every Rx byte read is the
+// register byte written.  Stat TransActive_1, TransDone_1 are preset, so
+// every step passes unless an error is preset or expect differs.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+#include "rgIicTune.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgIic			Icx  ( &Bx, 1 );
+
+rgIicTune		Tx   ( &Icx );		// test object
+
+rgIicTune_Profile	pp;
+
+uint8_t			expect[16];
+
+for ( int i=0;  i<16;  i++ )
+{
+    expect[i] = 0x75;			// register byte read back
+}
+
+Icx.Stat.write(   0x00000003 );		// TransActive, TransDone
+Icx.ClkDiv.write( 0x000005dc );		// power-on reset values
+Icx.Delay.write(  0x00300030 );
+Icx.ClkStr.write( 0x00000040 );
+
+//--------------------------------------------------------------------------
+//## Constructor
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults" );
+    try {
+	rgIicTune	tx  ( &Icx );
+	CHECK(  0,          tx.config_DivStart() );
+	CHECK(  64,         tx.config_DivMin() );
+	CHECK(  10,         tx.config_StepPct() );
+	CHECK(  25,         tx.config_MarginPct() );
+	CHECK(  4,          tx.config_Trials() );
+	CHECK(  0,          tx.get_StepCnt() );
+	CHECK(  0,          tx.get_FastDiv() );
+	CHECKX( 0x80000000, rgIicTune::DataMismatch );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## config_*()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "config_*() set" );
+    try {
+	rgIicTune	tx  ( &Icx );
+	tx.config_DivStart(  1500 );
+	tx.config_DivMin(    100 );
+	tx.config_StepPct(   50 );
+	tx.config_MarginPct( 0 );
+	tx.config_Trials(    1 );
+	CHECK(  1500,       tx.config_DivStart() );
+	CHECK(  100,        tx.config_DivMin() );
+	CHECK(  50,         tx.config_StepPct() );
+	CHECK(  0,          tx.config_MarginPct() );
+	CHECK(  1,          tx.config_Trials() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "config_DivStart() error" );
+    try {
+	Tx.config_DivStart( 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::config_DivStart():  requires {0, 2..0xfffe}:  0x1",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "config_DivMin() error" );
+    try {
+	Tx.config_DivMin( 0xffff );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::config_DivMin():  requires {2..0xfffe}:  0xffff",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "config_StepPct() error" );
+    try {
+	Tx.config_StepPct( 51 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::config_StepPct():  requires {1..50}:  51", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "config_MarginPct() error" );
+    try {
+	Tx.config_MarginPct( 101 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::config_MarginPct():  requires {0..100}:  101",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "config_Trials() error" );
+    try {
+	Tx.config_Trials( 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::config_Trials():  require > 0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## tune()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "tune() from current divider down to DivMin" );
+    try {
+	CHECK(  0,          Tx.tune( 0x68, 0x75, expect, 2, pp ) );
+	CHECK(  64,         Tx.get_FastDiv() );
+	CHECK(  30,         Tx.get_StepCnt() );
+	CHECK(  80,         pp.ClkDiv );		// 64 + 25%
+	CHECK(  5,          pp.Fall2Out );
+	CHECK(  20,         pp.Rise2In );
+	CHECK(  1200,       pp.TimeOut );		// 0x40 * 1500 / 80
+	CHECKX( 0x000005dc, Icx.ClkDiv.read() );	// restored
+	CHECKX( 0x00300030, Icx.Delay.read() );
+	CHECKX( 0x00000040, Icx.ClkStr.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "tune() margin limited to DivStart" );
+    try {
+	rgIicTune	tx  ( &Icx );
+	tx.config_DivStart(  1000 );
+	tx.config_DivMin(    950 );
+	tx.config_MarginPct( 100 );
+	CHECK(  0,          tx.tune( 0x68, 0x75, expect, 1, pp ) );
+	CHECK(  950,        tx.get_FastDiv() );
+	CHECK(  2,          tx.get_StepCnt() );
+	CHECK(  1000,       pp.ClkDiv );
+	CHECK(  64,         pp.TimeOut );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "tune() odd result rounded up to even" );
+    try {
+	rgIicTune	tx  ( &Icx );
+	tx.config_DivStart(  1000 );
+	tx.config_DivMin(    101 );
+	tx.config_StepPct(   50 );
+	tx.config_MarginPct( 0 );
+	CHECK(  0,          tx.tune( 0x68, 0x75, expect, 1, pp ) );
+	CHECK(  101,        tx.get_FastDiv() );	// 1000, 500, 250, 124, 101
+	CHECK(  5,          tx.get_StepCnt() );
+	CHECK(  102,        pp.ClkDiv );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "tune() data mismatch at DivStart" );
+    try {
+	pp.ClkDiv = 7;
+	CHECKX( 0x80000000, Tx.tune( 0x68, 0x74, expect, 1, pp ) );
+	CHECK(  0,          Tx.get_FastDiv() );
+	CHECK(  1,          Tx.get_StepCnt() );
+	CHECK(  7,          pp.ClkDiv );		// unchanged
+	CHECKX( 0x000005dc, Icx.ClkDiv.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "34", "tune() AckErr_1 at DivStart" );
+    try {
+	Icx.Stat.write( 0x00000100 );		// AckErr
+	CHECKX( 0x00000100, Tx.tune( 0x68, 0x75, expect, 1, pp ) );
+	CHECK(  0,          Tx.get_FastDiv() );
+	CHECK(  1,          Tx.get_StepCnt() );
+	Icx.Stat.write( 0x00000003 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "35a", "tune() addr error" );
+    try {
+	Tx.tune( 0x80, 0x75, expect, 1, pp );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::tune():  addr exceeds 0x7f:  0x80", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "35b", "tune() len error" );
+    try {
+	Tx.tune( 0x68, 0x75, expect, 17, pp );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::tune():  len requires {1..16}:  17", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "35c", "tune() DivStart below DivMin" );
+    try {
+	rgIicTune	tx  ( &Icx );
+	tx.config_DivStart( 40 );
+	tx.tune( 0x68, 0x75, expect, 1, pp );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIicTune::tune():  DivStart below DivMin:  0x28", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## calc_profile(), apply_profile(), grab_profile()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "calc_profile() small divider, TimeOut limit" );
+    try {
+	Tx.calc_profile( 4, 0x8000, 0x1000, pp );
+	CHECK(  4,          pp.ClkDiv );
+	CHECK(  1,          pp.Fall2Out );
+	CHECK(  1,          pp.Rise2In );
+	CHECKX( 0xffff,     pp.TimeOut );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "apply_profile(), grab_profile()" );
+    try {
+	rgIicTune_Profile	qq;
+	Tx.calc_profile( 200, 1500, 0x40, pp );
+	Tx.apply_profile( pp );
+	CHECKX( 0x000000c8, Icx.ClkDiv.read() );
+	CHECKX( 0x000c0032, Icx.Delay.read() );
+	CHECKX( 0x000001e0, Icx.ClkStr.read() );
+	Tx.grab_profile( qq );
+	CHECK(  200,        qq.ClkDiv );
+	CHECK(  12,         qq.Fall2Out );
+	CHECK(  50,         qq.Rise2In );
+	CHECK(  480,        qq.TimeOut );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+  CASE( "99", "Done" );
+}
+
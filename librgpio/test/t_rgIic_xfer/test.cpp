@@ -0,0 +1,635 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgIic  I2C Master class - transaction engine.
+//    10-19  Constructor state
+//    20-29  write()
+//    30-39  read()
+//    40-49  write_read() repeated Start
+//    50-59  Chained packets over MaxPacket
+//    60-69  start_*() and service_xfer()
+//    70-79  Scatter/gather  writev(), readv(), write_readv()
+//    80-89  Poll limit, no progress
+//
+// Fake memory has a single Fifo word, so reading it returns the last byte
+// written.  Presetting Stat bits selects the polling path;  R/C flags are
+// cleared by writing back the value read, which leaves fake Stat unchanged.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIic.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgIic			Tx   ( &Bx, 1 );	// test object
+
+static uint8_t		txbuf[70000];
+static uint8_t		rxbuf[70000];
+
+for ( int i=0;  i<70000;  i++ )
+{
+    txbuf[i] = i ^ 0x5a;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor state
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor transaction state" );
+    try {
+	rgIic		tx  ( &Bx, 0 );
+	CHECK(  0,          tx.get_XferCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+	CHECK(  0,          tx.get_XferErr() );
+	CHECK(  0,          tx.is_busy() );
+	CHECK(  1,          tx.service_xfer() );	// nothing started
+	CHECK(  16,         rgIic::FifoDepth );
+	CHECKX( 0xffff,     rgIic::MaxPacket );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## write()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "write() fits in Fifo" );
+    try {
+	Tx.Stat.write( 0x00000042 );		// TxEmpty, TransDone
+	CHECK(  0,          Tx.write( 0x50, txbuf, 5 ) );
+	CHECK(  5,          Tx.get_XferCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECKX( 0x5e,       Tx.Fifo.read() );
+	CHECKX( 0x00000005, Tx.DatLen.read() );
+	CHECKX( 0x00000050, Tx.Addr.read() );
+	CHECKX( 0x00008080, Tx.Cntl.read() );	// IicEnable, StartTrans
+	CHECKX( 0x00000042, Tx.Stat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "write() refill on TxEmpty_1" );
+    try {
+	Tx.Stat.write( 0x00000042 );		// TxEmpty, TransDone
+	CHECK(  0,          Tx.write( 0x50, txbuf, 40 ) );
+	CHECK(  40,         Tx.get_XferCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+	CHECKX( 0x7d,       Tx.Fifo.read() );	// txbuf[39]
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "write() one byte per TxHasSpace_1" );
+    try {
+	Tx.Stat.write( 0x00000012 );		// TxHasSpace, TransDone
+	CHECK(  0,          Tx.write( 0x50, txbuf, 20 ) );
+	CHECK(  20,         Tx.get_XferCnt() );
+	CHECK(  5,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "write() address only probe" );
+    try {
+	Tx.Stat.write( 0x00000042 );
+	CHECK(  0,          Tx.write( 0x23, txbuf, 0 ) );
+	CHECK(  0,          Tx.get_XferCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECKX( 0x00000000, Tx.DatLen.read() );
+	CHECKX( 0x00000023, Tx.Addr.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "write() AckErr_1" );
+    try {
+	Tx.Stat.write( 0x00000142 );		// AckErr
+	CHECKX( 0x00000100, Tx.write( 0x50, txbuf, 5 ) );
+	CHECK(  5,          Tx.get_XferCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECKX( 0x00008010, Tx.Cntl.read() );	// IicEnable, ClearFifo
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "write() ClkTimeout_1" );
+    try {
+	Tx.Stat.write( 0x00000250 );		// ClkTimeout
+	CHECKX( 0x00000200, Tx.write( 0x50, txbuf, 20 ) );
+	CHECK(  16,         Tx.get_XferCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "26", "write() addr error" );
+    try {
+	Tx.write( 0x80, txbuf, 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::write():  addr exceeds 0x7f:  0x80", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## read()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "read() drain on TransDone_1" );
+    try {
+	Tx.Stat.write( 0x00000002 );		// TransDone
+	Tx.Fifo.write( 0xa5 );
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0; }
+	CHECK(  0,          Tx.read( 0x50, rxbuf, 5 ) );
+	CHECK(  5,          Tx.get_XferCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECKX( 0xa5,       rxbuf[0] );
+	CHECKX( 0xa5,       rxbuf[4] );
+	CHECKX( 0x00,       rxbuf[5] );
+	CHECKX( 0x00008081, Tx.Cntl.read() );	// IicEnable, Start, Read
+	CHECKX( 0x00000005, Tx.DatLen.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "read() RxFull_1 bursts" );
+    try {
+	Tx.Stat.write( 0x00000082 );		// RxFull, TransDone
+	CHECK(  0,          Tx.read( 0x50, rxbuf, 40 ) );
+	CHECK(  40,         Tx.get_XferCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "read() AckErr_1" );
+    try {
+	Tx.Stat.write( 0x00000100 );		// AckErr
+	CHECKX( 0x00000100, Tx.read( 0x50, rxbuf, 5 ) );
+	CHECK(  0,          Tx.get_XferCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "read() zero length" );
+    try {
+	Tx.read( 0x50, rxbuf, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::read():  require n > 0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## write_read() repeated Start
+//--------------------------------------------------------------------------
+
+  CASE( "40", "write_read() register read" );
+    try {
+	Tx.Stat.write( 0x00000003 );		// TransActive, TransDone
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0; }
+	CHECK(  0,          Tx.write_read( 0x68, txbuf, 2, rxbuf, 4 ) );
+	CHECK(  4,          Tx.get_XferCnt() );
+	CHECK(  2,          Tx.get_PollCnt() );
+	CHECKX( 0x5b,       rxbuf[0] );	// last Fifo write
+	CHECKX( 0x5b,       rxbuf[3] );
+	CHECKX( 0x00,       rxbuf[4] );
+	CHECKX( 0x00008081, Tx.Cntl.read() );
+	CHECKX( 0x00000004, Tx.DatLen.read() );
+	CHECKX( 0x00000068, Tx.Addr.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "write_read() AckErr_1 on address" );
+    try {
+	Tx.Stat.write( 0x00000101 );		// AckErr, TransActive
+	CHECKX( 0x00000100, Tx.write_read( 0x68, txbuf, 1, rxbuf, 4 ) );
+	CHECK(  0,          Tx.get_XferCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECKX( 0x00008010, Tx.Cntl.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42a", "write_read() nw zero" );
+    try {
+	Tx.write_read( 0x68, txbuf, 0, rxbuf, 4 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::write_read():  nw requires {1..16}:  0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42b", "write_read() nw exceeds Fifo" );
+    try {
+	Tx.write_read( 0x68, txbuf, 17, rxbuf, 4 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::write_read():  nw requires {1..16}:  17", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42c", "write_read() nr exceeds MaxPacket" );
+    try {
+	Tx.write_read( 0x68, txbuf, 1, rxbuf, 0x10000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::write_read():  nr requires {1..65535}:  65536",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42d", "write_read() addr error" );
+    try {
+	Tx.write_read( 0xff, txbuf, 1, rxbuf, 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::write_read():  addr exceeds 0x7f:  0xff", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Chained packets over MaxPacket
+//--------------------------------------------------------------------------
+
+  CASE( "50", "write() chained packets" );
+    try {
+	Tx.Stat.write( 0x00000042 );		// TxEmpty, TransDone
+	CHECK(  0,          Tx.write( 0x50, txbuf, 70000 ) );
+	CHECK(  70000,      Tx.get_XferCnt() );
+	CHECK(  4376,       Tx.get_PollCnt() );
+	CHECKX( 0x00001171, Tx.DatLen.read() );	// 70000 - 65535
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "read() chained packets" );
+    try {
+	Tx.Stat.write( 0x00000002 );		// TransDone
+	CHECK(  0,          Tx.read( 0x50, rxbuf, 70000 ) );
+	CHECK(  70000,      Tx.get_XferCnt() );
+	CHECK(  4376,       Tx.get_PollCnt() );
+	CHECKX( 0x00001171, Tx.DatLen.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## start_*() and service_xfer()
+//--------------------------------------------------------------------------
+
+  CASE( "60", "start_write_read() leaves read to service" );
+    try {
+	Tx.Stat.write( 0x00000001 );		// TransActive
+	Tx.start_write_read( 0x48, txbuf, 1, rxbuf, 2 );
+	CHECK(  1,          Tx.is_busy() );
+	CHECK(  0,          Tx.get_PollCnt() );
+	CHECKX( 0x00008080, Tx.Cntl.read() );	// write started
+	CHECKX( 0x00000001, Tx.DatLen.read() );
+	CHECK(  0,          Tx.service_xfer() );	// read queued
+	CHECKX( 0x00008081, Tx.Cntl.read() );
+	CHECKX( 0x00000002, Tx.DatLen.read() );
+	CHECK(  0,          Tx.service_xfer() );	// no Rx data
+	CHECK(  1,          Tx.is_busy() );
+	Tx.Stat.write( 0x00000002 );		// TransDone
+	CHECK(  1,          Tx.service_xfer() );
+	CHECK(  0,          Tx.is_busy() );
+	CHECK(  0,          Tx.get_XferErr() );
+	CHECK(  2,          Tx.get_XferCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "61", "service_xfer() ClkTimeout_1 while reading" );
+    try {
+	Tx.Stat.write( 0x00000001 );		// TransActive
+	Tx.start_write_read( 0x48, txbuf, 1, rxbuf, 2 );
+	CHECK(  0,          Tx.service_xfer() );
+	Tx.Stat.write( 0x00000200 );		// ClkTimeout
+	CHECK(  1,          Tx.service_xfer() );
+	CHECKX( 0x00000200, Tx.get_XferErr() );
+	CHECK(  0,          Tx.is_busy() );
+	CHECKX( 0x00008010, Tx.Cntl.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "62", "start_write_read() nw error" );
+    try {
+	Tx.start_write_read( 0x48, txbuf, 17, rxbuf, 2 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::start_write_read():  nw requires {1..16}:  17",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "63", "start_write() address only probe" );
+    try {
+	Tx.Stat.write( 0x00000000 );
+	Tx.start_write( 0x3c, txbuf, 0 );
+	CHECKX( 0x00000000, Tx.DatLen.read() );
+	CHECKX( 0x00008080, Tx.Cntl.read() );
+	CHECK(  0,          Tx.service_xfer() );	// not done
+	Tx.Stat.write( 0x00000002 );		// TransDone
+	CHECK(  1,          Tx.service_xfer() );
+	CHECK(  0,          Tx.get_XferErr() );
+	CHECK(  0,          Tx.get_XferCnt() );
+	CHECK(  2,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "64", "start_write() AckErr_1, start_read() n error" );
+    try {
+	Tx.Stat.write( 0x00000100 );		// AckErr
+	Tx.start_write( 0x3c, txbuf, 3 );
+	CHECK(  1,          Tx.service_xfer() );
+	CHECKX( 0x00000100, Tx.get_XferErr() );
+	Tx.start_read( 0x3c, rxbuf, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::start_read():  n requires {1..65535}:  0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "65", "start_write() n error" );
+    try {
+	Tx.start_write( 0x3c, txbuf, 17 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::start_write():  n requires {0..16}:  17", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "66", "start_read(), abort_xfer()" );
+    try {
+	Tx.Stat.write( 0x00000000 );
+	Tx.start_read( 0x3c, rxbuf, 1 );
+	CHECKX( 0x00008081, Tx.Cntl.read() );
+	CHECK(  0,          Tx.service_xfer() );
+	CHECK(  1,          Tx.is_busy() );
+	Tx.abort_xfer();
+	CHECK(  0,          Tx.is_busy() );
+	CHECKX( 0x00008010, Tx.Cntl.read() );
+	CHECK(  1,          Tx.service_xfer() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Scatter/gather  writev(), readv(), write_readv()
+//--------------------------------------------------------------------------
+
+  CASE( "70", "writev() header, payload, CRC" );
+    try {
+	uint8_t		hdr[1]  = { 0x11 };
+	uint8_t		crc[1]  = { 0x99 };
+	struct iovec	txv[3]  = { {hdr, 1}, {txbuf, 5}, {crc, 1} };
+	Tx.Stat.write( 0x00000042 );		// TxEmpty, TransDone
+	CHECK(  0,          Tx.writev( 0x3c, txv, 3 ) );
+	CHECK(  7,          Tx.get_XferCnt() );
+	CHECKX( 0x99,       Tx.Fifo.read() );	// last Fifo write
+	CHECKX( 0x00000007, Tx.DatLen.read() );
+	CHECKX( 0x00008080, Tx.Cntl.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "71", "readv() NULL segment discards" );
+    try {
+	struct iovec	rxv[2]  = { {NULL, 1}, {rxbuf, 3} };
+	Tx.Stat.write( 0x00000002 );		// TransDone
+	Tx.Fifo.write( 0xa5 );
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0; }
+	CHECK(  0,          Tx.readv( 0x50, rxv, 2 ) );
+	CHECK(  4,          Tx.get_XferCnt() );
+	CHECKX( 0x00000004, Tx.DatLen.read() );
+	CHECKX( 0xa5,       rxbuf[0] );
+	CHECKX( 0xa5,       rxbuf[2] );
+	CHECKX( 0x00,       rxbuf[3] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "72", "write_readv() register read into two buffers" );
+    try {
+	uint8_t		reg[2]  = { 0x20, 0x21 };
+	uint8_t		rhead[1];
+	struct iovec	txv[2]  = { {reg, 1}, {reg + 1, 1} };
+	struct iovec	rxv[2]  = { {rhead, 1}, {rxbuf, 2} };
+	Tx.Stat.write( 0x00000003 );		// TransActive, TransDone
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0; }
+	CHECK(  0,          Tx.write_readv( 0x68, txv, 2, rxv, 2 ) );
+	CHECK(  3,          Tx.get_XferCnt() );
+	CHECKX( 0x21,       rhead[0] );		// last Fifo write
+	CHECKX( 0x21,       rxbuf[0] );
+	CHECKX( 0x21,       rxbuf[1] );
+	CHECKX( 0x00,       rxbuf[2] );
+	CHECKX( 0x00000003, Tx.DatLen.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "73", "readv() zero length" );
+    try {
+	struct iovec	rxv[1]  = { {rxbuf, 0} };
+	Tx.readv( 0x50, rxv, 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::readv():  require n > 0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "74", "write_readv() nw exceeds Fifo" );
+    try {
+	struct iovec	txv[2]  = { {txbuf, 16}, {txbuf, 1} };
+	struct iovec	rxv[1]  = { {rxbuf, 1} };
+	Tx.write_readv( 0x68, txv, 2, rxv, 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::write_readv():  nw requires {1..16}:  17", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "75", "start_write_readv() nr zero" );
+    try {
+	struct iovec	txv[1]  = { {txbuf, 1} };
+	Tx.start_write_readv( 0x68, txv, 1, NULL, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgIic::start_write_readv():  nr requires {1..65535}:  0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Poll limit, no progress
+//--------------------------------------------------------------------------
+
+  CASE( "80", "config_PollLimit() default" );
+    try {
+	CHECK(  1000000,    Tx.config_PollLimit() );
+	CHECKX( 0x80000000, rgIic::ErrPollLimit );
+	Tx.config_PollLimit( 5 );
+	CHECK(  5,          Tx.config_PollLimit() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "81", "read() no data, abandoned" );
+    try {
+	Tx.Stat.write( 0x00000001 );		// TransActive
+	CHECKX( 0x80000000, Tx.read( 0x3c, rxbuf, 4 ) );
+	CHECKX( 0x80000000, Tx.get_XferErr() );
+	CHECK(  5,          Tx.get_PollCnt() );
+	CHECK(  0,          Tx.get_XferCnt() );
+	CHECK(  0,          Tx.is_busy() );
+	CHECKX( 0x00008010, Tx.Cntl.read() );	// ClearFifo
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "82", "write() no Fifo room, abandoned" );
+    try {
+	Tx.Stat.write( 0x00000001 );		// TransActive
+	CHECKX( 0x80000000, Tx.write( 0x50, txbuf, 20 ) );
+	CHECK(  5,          Tx.get_PollCnt() );
+	CHECK(  16,         Tx.get_XferCnt() );	// prefill only
+	CHECKX( 0x00008010, Tx.Cntl.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "83", "write_read() never TransActive, abandoned" );
+    try {
+	Tx.Stat.write( 0x00000000 );
+	CHECKX( 0x80000000, Tx.write_read( 0x68, txbuf, 1, rxbuf, 2 ) );
+	CHECK(  5,          Tx.get_PollCnt() );
+	CHECK(  0,          Tx.is_busy() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "84", "service_xfer() progress restarts count" );
+    try {
+	Tx.Stat.write( 0x00000001 );		// TransActive
+	Tx.start_read( 0x3c, rxbuf, 10 );
+	for ( int i=0;  i<4;  i++ ) {
+	    if ( Tx.service_xfer() ) {
+		FAIL( "finished early" );
+	    }
+	}
+	Tx.Stat.write( 0x00000021 );		// RxHasData, one byte
+	CHECK(  0,          Tx.service_xfer() );
+	Tx.Stat.write( 0x00000001 );
+	for ( int i=0;  i<4;  i++ ) {
+	    if ( Tx.service_xfer() ) {
+		FAIL( "finished early" );
+	    }
+	}
+	CHECK(  1,          Tx.service_xfer() );
+	CHECKX( 0x80000000, Tx.get_XferErr() );
+	CHECK(  1,          Tx.get_XferCnt() );
+	CHECK(  10,         Tx.get_PollCnt() );
+	Tx.config_PollLimit( 1000000 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
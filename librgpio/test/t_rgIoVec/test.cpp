@@ -0,0 +1,143 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgIoVec  Scatter/gather byte cursor over iovec segments.
+//    10-19  Constructor, empty list
+//    20-29  get()  Tx bytes
+//    30-39  put()  Rx bytes
+//    40-49  total()
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgIoVec.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+uint8_t			aa[3]  = { 0x11, 0x12, 0x13 };
+uint8_t			bb[2]  = { 0x21, 0x22 };
+uint8_t			rbuf[8];
+
+rgIoVec			Tx;			// test object
+
+//--------------------------------------------------------------------------
+//## Constructor, empty list
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor is empty list" );
+    try {
+	rgIoVec		tx;
+	CHECKX( 0xa5,       tx.get( 0xa5 ) );
+	CHECKX( 0xa5,       tx.get( 0xa5 ) );
+	tx.put( 0x33 );				// discarded
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "init() all segments empty" );
+    try {
+	struct iovec	vv[2]  = { {aa, 0}, {bb, 0} };
+	Tx.init( vv, 2 );
+	CHECKX( 0x00,       Tx.get( 0x00 ) );
+	CHECKX( 0x11,       aa[0] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## get()  Tx bytes
+//--------------------------------------------------------------------------
+
+  CASE( "20", "get() walks segments in order" );
+    try {
+	struct iovec	vv[2]  = { {aa, 3}, {bb, 2} };
+	Tx.init( vv, 2 );
+	CHECKX( 0x11,       Tx.get( 0xff ) );
+	CHECKX( 0x12,       Tx.get( 0xff ) );
+	CHECKX( 0x13,       Tx.get( 0xff ) );
+	CHECKX( 0x21,       Tx.get( 0xff ) );
+	CHECKX( 0x22,       Tx.get( 0xff ) );
+	CHECKX( 0xff,       Tx.get( 0xff ) );	// past the end
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "get() NULL segment is fill, empty skipped" );
+    try {
+	struct iovec	vv[4]  = { {aa, 0}, {NULL, 2}, {bb, 0}, {bb, 1} };
+	Tx.init( vv, 4 );
+	CHECKX( 0xc3,       Tx.get( 0xc3 ) );
+	CHECKX( 0xc3,       Tx.get( 0xc3 ) );
+	CHECKX( 0x21,       Tx.get( 0xc3 ) );
+	CHECKX( 0xc3,       Tx.get( 0xc3 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "init() restarts" );
+    try {
+	struct iovec	vv[1]  = { {bb, 2} };
+	Tx.init( vv, 1 );
+	CHECKX( 0x21,       Tx.get( 0x00 ) );
+	Tx.init( vv, 1 );
+	CHECKX( 0x21,       Tx.get( 0x00 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## put()  Rx bytes
+//--------------------------------------------------------------------------
+
+  CASE( "30", "put() scatter, NULL segment discards" );
+    try {
+	struct iovec	vv[3]  = { {rbuf, 1}, {NULL, 2}, {rbuf + 4, 2} };
+	for ( int i=0;  i<8;  i++ )  { rbuf[i] = 0xee; }
+	Tx.init( vv, 3 );
+	for ( int i=0;  i<7;  i++ )  { Tx.put( i ); }
+	CHECKX( 0x00,       rbuf[0] );
+	CHECKX( 0xee,       rbuf[1] );
+	CHECKX( 0xee,       rbuf[3] );
+	CHECKX( 0x03,       rbuf[4] );
+	CHECKX( 0x04,       rbuf[5] );
+	CHECKX( 0xee,       rbuf[6] );		// past the end
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## total()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "total()" );
+    try {
+	struct iovec	vv[3]  = { {aa, 3}, {NULL, 7}, {bb, 0} };
+	CHECK(  10,         rgIoVec::total( vv, 3 ) );
+	CHECK(  3,          rgIoVec::total( vv, 1 ) );
+	CHECK(  0,          rgIoVec::total( NULL, 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,285 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgPinMode  Pin mode backends, selected once by SocEnum
+//    10-19  rgPinMode_Bcm  RPi4
+//    20-29  rgPinMode_Rp1  RPi5
+//    30-39  rgPinMode_dispatch()
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgPinMode.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+// Functor applied to each backend.
+
+struct setup_pins {
+    bool		rp1;		// which backend was called
+    uint32_t		outs;		// read_output() result
+
+    template <class Pm>
+    void operator()( Pm& px )
+    {
+	rp1 = Pm::is_rp1;
+	px.mode_input(  0x00000003 );
+	px.mode_output( 0x00000010 );
+	px.mode_alt(    0x0000000c, (Pm::is_rp1 ? 3 : 0) );
+	outs = px.read_output();
+    }
+};
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## rgPinMode_Bcm  RPi4
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );    // RPi4
+
+rgAddrMap		Bx;
+
+  CASE( "10", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "mode_input(), mode_output(), mode_alt()" );
+    try {
+	rgPinMode_Bcm		px  ( &Bx );
+	px.Fsel.Fsel0.write(    0x3fffffff );
+	px.Fsel.Fsel1.write(    0x00000000 );
+	px.mode_input(          0x00000003 );
+	CHECKX(                 0x3fffffc0, px.Fsel.Fsel0.read() );
+	px.mode_output(         0x00000410 );
+	CHECKX(                 0x3fff9fc0, px.Fsel.Fsel0.read() );
+	CHECKX(                 0x00000001, px.Fsel.Fsel1.read() );
+	px.mode_alt(            0x0000000c, 0 );
+	CHECKX(                 0x3fff9900, px.Fsel.Fsel0.read() );
+	CHECKX(                 0x00000410, px.read_output() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "mode_alt() Alt5" );
+    try {
+	rgPinMode_Bcm		px  ( &Bx );
+	px.Fsel.Fsel0.write(    0x00000000 );
+	px.mode_alt(            0x00000001, 5 );
+	CHECKX(                 0x00000002, px.Fsel.Fsel0.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "mode_alt() bad alt" );
+    try {
+	rgPinMode_Bcm		px  ( &Bx );
+	px.mode_alt(            0x00000001, 6 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPinMode_Bcm::mode_alt():  require alt {0..5}:  6",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "14", "mask limited to Gpio[27:0]" );
+    try {
+	rgPinMode_Bcm		px  ( &Bx );
+	px.Fsel.Fsel2.write(    0x00000000 );
+	px.mode_output(         0xf0000000 );
+	CHECKX(                 0x00000000, px.Fsel.Fsel2.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "15", "rgPinMode_Rp1 constructor, fail RPi4" );
+    try {
+	rgPinMode_Rp1		px  ( &Bx );
+	FAIL( "no throw" );
+    }
+    catch ( domain_error& e ) {
+	CHECK( "rgsIoCon::  require RPi5 (soc_BCM2712)",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgPinMode_Rp1  RPi5
+//--------------------------------------------------------------------------
+// Fake memory does not apply set/clr to the normal address.
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
+
+rgAddrMap		Cx;
+
+  CASE( "20", "Address map object" );
+    try {
+	Cx.open_fake_mem();
+	CHECKX( 0x40000000, Cx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "mode_output() FuncSel and RioOutEn" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.IoCon.IoCntl(4).write(     0x00000000 );
+	px.Rio.RioOutEn.write_set(    0x00000000 );
+	px.mode_output(               0x00000010 );
+	CHECKX(                       0x00000005, px.IoCon.IoCntl(4).read() );
+	CHECKX(                       0x00000010, px.Rio.RioOutEn.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "mode_input() clears RioOutEn" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.Rio.RioOutEn.write_clr(    0x00000000 );
+	px.mode_input(                0x00000030 );
+	CHECKX(                       0x00000030, px.Rio.RioOutEn.read_clr() );
+	CHECKX(                       0x00000005, px.IoCon.IoCntl(5).read() );
+	// RioOutEn aliases IoCntl(0) in the shared fake memory block.
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "mode_alt()" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.IoCon.IoCntl(27).write(    0x00000000 );
+	px.mode_alt(                  0x08000000, 8 );
+	CHECKX(                       0x00000008, px.IoCon.IoCntl(27).read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "mode_alt() bad alt" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.mode_alt(            0x00000001, 9 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPinMode_Rp1::mode_alt():  require alt {0..8}:  9",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "read_output()" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.Rio.RioOutEn.write(        0xffffffff );
+	CHECKX(                       0x0fffffff, px.read_output() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "26", "rgPinMode_Bcm constructor, fail RPi5" );
+    try {
+	rgPinMode_Bcm		px  ( &Cx );
+	FAIL( "no throw" );
+    }
+    catch ( domain_error& e ) {
+	CHECK( "rgFselPin:  require RPi4 (soc_BCM2711) or earlier",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "27", "FuncSel 3 to 5, one write, no set/clr" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.IoCon.IoCntl(6).write(     0x30001003 );	// other fields kept
+	px.IoCon.IoCntl(6).write_set( 0xdeadbeef );
+	px.IoCon.IoCntl(6).write_clr( 0xdeadbeef );
+	px.mode_output(               0x00000040 );
+	CHECKX(                       0x30001005, px.IoCon.IoCntl(6).read() );
+	CHECKX(                       0xdeadbeef, px.IoCon.IoCntl(6).read_set() );
+	CHECKX(                       0xdeadbeef, px.IoCon.IoCntl(6).read_clr() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "28", "FuncSel from shadow copy, no read" );
+    try {
+	rgPinMode_Rp1		px  ( &Cx );
+	px.IoCon.IoCntl(6).write(     0x30001003 );
+	px.IoCon.refresh();
+	px.IoCon.config_ShadowMode( 1 );
+	px.IoCon.IoCntl(6).write(     0x00000000 );	// shadow is stale
+	px.mode_alt(                  0x00000040, 2 );
+	CHECKX(                       0x30001002, px.IoCon.IoCntl(6).read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgPinMode_dispatch()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "dispatch RPi5" );
+    try {
+	setup_pins		fn;
+	rgPinMode_dispatch( &Cx, fn );
+	CHECK(                  1, fn.rp1 );
+	CHECKX(                 0x00000003, ( rgsIoCon( &Cx ).IoCntl(2).read() & 0x1f ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );    // RPi4
+
+  CASE( "31", "dispatch RPi4" );
+    try {
+	setup_pins		fn;
+	rgFselPin		fx  ( &Bx );
+	fx.Fsel0.write(         0x00000000 );
+	rgPinMode_dispatch( &Bx, fn );
+	CHECK(                  0, fn.rp1 );
+	CHECKX(                 0x00001900, fx.Fsel0.read() );
+	CHECKX(                 0x00000010, fn.outs );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
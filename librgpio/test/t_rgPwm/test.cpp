@@ -5,7 +5,8 @@
 //    20-29  Address of registers  addr()
 //    30-39  Direct register access  read(), write()
 //    40-49  Full register get(), put(), grab(), push()
-//    50-59  Object State  init_put_reset(), grab_regs(), push_regs()
+//    50-54  Object State  init_put_reset(), grab_regs(), push_regs()
+//    55-59  Fifo writer pass  fifo_room()
 //    60-98  Field Accessors  get(), put()  #!! incomplete
 //--------------------------------------------------------------------------
 
@@ -577,6 +578,47 @@ rgPwm			Tx   ( &Bx );		// test object
 	FAIL( "unexpected exception" );
     }
 
+//--------------------------------------------------------------------------
+//## Fifo writer pass  fifo_room()
+//--------------------------------------------------------------------------
+// Fake Stat is unchanged by the write back that clears flags.
+
+  CASE( "55", "fifo_room() FifoEmpty_1, Ch1 GapErr_1" );
+    try {
+	bool		gap = 0;
+	Tx.Stat.put(       0xbbbbbbbb );
+	Tx.Stat.write(     0x00000012 );
+	CHECK(  8,         Tx.fifo_room( gap ) );
+	CHECK(  1,         gap );
+	CHECK(  8,         rgPwm::FifoDepth );
+	CHECKX( 0xbbbbbbbb, Tx.Stat.get() );	// cache not changed
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "56", "fifo_room() not full, FifoWriteErr_1 no gap" );
+    try {
+	bool		gap = 1;
+	Tx.Stat.write(     0x00000004 );
+	CHECK(  1,         Tx.fifo_room( gap ) );
+	CHECK(  0,         gap );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "57", "fifo_room() FifoFull_1, Ch2 GapErr_1" );
+    try {
+	bool		gap = 0;
+	Tx.Stat.write(     0x00000021 );
+	CHECK(  0,         Tx.fifo_room( gap ) );
+	CHECK(  1,         gap );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
 //--------------------------------------------------------------------------
 //## Field Accessors  get(), put()
 //--------------------------------------------------------------------------
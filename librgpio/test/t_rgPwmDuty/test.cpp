@@ -0,0 +1,193 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgPwmDuty  Coherent PWM duty update on rgPwm.
+//    10-19  Constructor, config
+//    20-29  update()
+//    30-39  update_range()
+//    40-49  Pin sync, latency measure
+//
+// Fake memory is a single page, so the PWM output pin level is constant
+// and every edge wait reaches MaxPoll.  Write order is not observable.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgIoPins.h"
+#include "rgPwm.h"
+#include "rgSysTimer.h"
+#include "rgPwmDuty.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgPwm			Px   ( &Bx );
+rgIoPins		Ix   ( &Bx );
+rgSysTimer		Sx   ( &Bx );
+
+rgPwmDuty		Tx   ( &Px );		// test object
+
+//--------------------------------------------------------------------------
+//## Constructor, config
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults" );
+    try {
+	rgPwmDuty	tx  ( &Px );
+	CHECK(  0,          tx.get_LastLatency_us() );
+	CHECK(  0,          tx.get_MaxLatency_us() );
+	CHECK(  0,          tx.get_UpdateCnt() );
+	CHECK(  0,          tx.get_WriteCnt() );
+	CHECK(  0,          tx.get_SyncMissCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_PinSync() pin range" );
+    try {
+	rgPwmDuty	tx  ( &Px );
+	tx.config_PinSync( &Ix, 40 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmDuty::config_PinSync():  pin requires {0..31}:  40",
+	    e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## update()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "update() writes changed only" );
+    try {
+	Px.Ch1Range.write( 100 );
+	Px.Ch1Data.write(   5 );
+	Px.Ch2Range.write( 200 );
+	Px.Ch2Data.write(   7 );
+	Tx.grab();
+	Tx.update( 5, 9 );
+	CHECK(  1,          Tx.get_UpdateCnt() );
+	CHECK(  1,          Tx.get_WriteCnt() );
+	CHECK(  5,          Px.Ch1Data.read() );
+	CHECK(  9,          Px.Ch2Data.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "update() both, then none" );
+    try {
+	Tx.update( 50, 60 );
+	CHECK(  3,          Tx.get_WriteCnt() );
+	CHECK(  50,         Px.Ch1Data.read() );
+	CHECK(  60,         Px.Ch2Data.read() );
+	Tx.update( 50, 60 );
+	CHECK(  3,          Tx.get_UpdateCnt() );
+	CHECK(  3,          Tx.get_WriteCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## update_range()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "update_range() shrink Ch1, grow Ch2" );
+    try {
+	Tx.update_range( 40, 20, 400, 300 );
+	CHECK(  7,          Tx.get_WriteCnt() );
+	CHECK(  40,         Px.Ch1Range.read() );
+	CHECK(  20,         Px.Ch1Data.read() );
+	CHECK(  400,        Px.Ch2Range.read() );
+	CHECK(  300,        Px.Ch2Data.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "update_range() same range, Data only" );
+    try {
+	Tx.update_range( 40, 10, 400, 300 );
+	CHECK(  8,          Tx.get_WriteCnt() );
+	CHECK(  10,         Px.Ch1Data.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Pin sync, latency measure
+//--------------------------------------------------------------------------
+
+  CASE( "40", "pin sync miss, still writes" );
+    try {
+	Ix.PinRead_w0.write( 0x00000000 );	// pin 18 low
+	Tx.config_PinSync( &Ix, 18 );
+	Tx.config_MaxPoll( 10 );
+	Tx.update( 11, 12 );
+	CHECK(  1,          Tx.get_SyncMissCnt() );
+	CHECK(  11,         Px.Ch1Data.read() );
+	CHECK(  12,         Px.Ch2Data.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "measure miss, no latency" );
+    try {
+	Ix.PinRead_w0.write( 0x00040000 );	// pin 18 high
+	Tx.config_Measure( &Sx );
+	Tx.update( 13, 14 );
+	CHECK(  3,          Tx.get_SyncMissCnt() );
+	CHECK(  0,          Tx.get_LastLatency_us() );
+	CHECK(  13,         Px.Ch1Data.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "config_NoSync() no wait" );
+    try {
+	Tx.config_NoSync();
+	Tx.update( 15, 16 );
+	CHECK(  3,          Tx.get_SyncMissCnt() );
+	CHECK(  16,         Px.Ch2Data.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
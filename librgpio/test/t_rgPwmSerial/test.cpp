@@ -0,0 +1,246 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgPwmSerial  PWM serializer bitstream encoder on rgPwm.
+//    10-19  Constructor, config_Symbols()
+//    20-29  encode()
+//    30-39  calc_clock()
+//    40-49  write(), send()
+//
+// Fake memory has a single Fifo word, so reading it returns the last word
+// written.  Stat is preset FifoEmpty so the blocking writer completes.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgPwm.h"
+#include "rgPwmSerial.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgPwm			Px   ( &Bx );
+
+rgPwmSerial		Tx   ( &Px );		// test object
+
+uint8_t			grb[3]  = { 0xff, 0x00, 0x80 };
+uint32_t		ww[8];
+
+//--------------------------------------------------------------------------
+//## Constructor, config_Symbols()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults WS2812" );
+    try {
+	rgPwmSerial	tx  ( &Px );
+	CHECK(  3,          tx.get_Nsym() );
+	CHECK(  0,          tx.get_DivI() );
+	CHECK(  0,          tx.get_DivF() );
+	CHECK(  32,         tx.get_Range() );
+	CHECK(  0,          tx.get_WordCnt() );
+	CHECK(  0,          tx.get_GapCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_Symbols() nsym range" );
+    try {
+	rgPwmSerial	tx  ( &Px );
+	tx.config_Symbols( 0x0, 0x1, 5 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSerial::config_Symbols():  nsym range {1..4}:  5",
+	    e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "config_Symbols() symbol too wide" );
+    try {
+	rgPwmSerial	tx  ( &Px );
+	tx.config_Symbols( 0x1, 0x4, 2 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSerial::config_Symbols():  symbol exceeds nsym bits:  0x4",
+	    e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## encode()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "words_needed()" );
+    try {
+	CHECK(  3,          rgPwmSerial::words_needed( 3, 3 ) );
+	CHECK(  1,          rgPwmSerial::words_needed( 4, 1 ) );
+	CHECK(  2,          rgPwmSerial::words_needed( 5, 1 ) );
+	CHECK(  0,          rgPwmSerial::words_needed( 0, 4 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "encode() WS2812, last word padded" );
+    try {
+	CHECK(  3,          Tx.encode( grb, 3, ww, 8 ) );
+	CHECKX( 0xdb6db692, ww[0] );
+	CHECKX( 0x4924d249, ww[1] );
+	CHECKX( 0x24000000, ww[2] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "encode() nsym=1 is plain bytes" );
+    try {
+	rgPwmSerial	tx  ( &Px );
+	tx.config_Symbols( 0x0, 0x1, 1 );
+	uint8_t		dd[5]  = { 0x12, 0x34, 0x56, 0x78, 0x9a };
+	CHECK(  2,          tx.encode( dd, 5, ww, 8 ) );
+	CHECKX( 0x12345678, ww[0] );
+	CHECKX( 0x9a000000, ww[1] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "encode() nsym=4 word per byte" );
+    try {
+	rgPwmSerial	tx  ( &Px );
+	tx.config_Symbols( 0x8, 0xe, 4 );
+	CHECK(  2,          tx.encode( grb + 1, 2, ww, 8 ) );
+	CHECKX( 0x88888888, ww[0] );
+	CHECKX( 0xe8888888, ww[1] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "encode() dst too small" );
+    try {
+	Tx.encode( grb, 3, ww, 2 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSerial::encode():  dst requires 3 words:  2", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## calc_clock()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "calc_clock() 19.2 MHz exact" );
+    try {
+	Tx.calc_clock( 19200000, 1250 );
+	CHECK(  8,          Tx.get_DivI() );
+	CHECK(  0,          Tx.get_DivF() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "calc_clock() 500 MHz fractional" );
+    try {
+	Tx.calc_clock( 500000000, 1250 );
+	CHECK(  208,        Tx.get_DivI() );
+	CHECK(  1365,       Tx.get_DivF() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "calc_clock() divisor too small" );
+    try {
+	Tx.calc_clock( 1000000, 1250 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSerial::calc_clock():  divisor out of range {2..4095}:  0",
+	    e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## write(), send()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "send() WS2812 pixel" );
+    try {
+	Px.Stat.write( 0x00000002 );		// FifoEmpty
+	Tx.send( grb, 3 );
+	CHECK(  3,          Tx.get_WordCnt() );
+	CHECK(  2,          Tx.get_PollCnt() );
+	CHECK(  0,          Tx.get_GapCnt() );
+	CHECKX( 0x24000000, Px.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "send() several blocks" );
+    try {
+	uint8_t		dd[40];
+	for ( int i=0;  i<40;  i++ )  { dd[i] = 0x00; }
+	dd[39] = 0xff;
+	Tx.send( dd, 40 );
+	CHECK(  33,         Tx.get_WordCnt() );	// 3 + 24 + 6
+	CHECK(  7,          Tx.get_PollCnt() );	// 2 + 1 + 3 + 1
+	CHECKX( 0x24db6db6, Px.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "write() GapErr_1 counted" );
+    try {
+	Px.Stat.write( 0x00000012 );		// Ch1_GapErr, FifoEmpty
+	Tx.write( ww, 2 );
+	CHECK(  1,          Tx.get_GapCnt() );
+	CHECK(  35,         Tx.get_WordCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,224 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgPwmSolve  PWM clock and Range solver.
+//    10-19  Constructor, add_Source()
+//    20-29  solve()
+//    30-39  apply()
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgClk.h"
+#include "rgPwm.h"
+#include "rgPwmSolve.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgPwm			Px   ( &Bx );
+rgClk			Cx   ( &Bx, rgClk::cm_ClkPwm );
+
+rgPwmSolve		Tx;			// test object
+
+//--------------------------------------------------------------------------
+//## Constructor, add_Source()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults" );
+    try {
+	rgPwmSolve	tx;
+	CHECK(  2,          tx.get_NumSrc() );
+	CHECK(  0,          tx.get_Source() );
+	CHECK(  0,          tx.get_DivI() );
+	CHECK(  0,          tx.get_DivF() );
+	CHECK(  0,          tx.get_Range() );
+	CHECK(  0,          tx.get_ErrPpb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "add_Source() src range" );
+    try {
+	rgPwmSolve	tx;
+	tx.add_Source( 16, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSolve::add_Source():  src requires {0..15}:  16",
+	    e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "add_Source() hz zero" );
+    try {
+	rgPwmSolve	tx;
+	tx.add_Source( 7, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSolve::add_Source():  hz is zero", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "add_Source() exceeds MaxSrc" );
+    try {
+	rgPwmSolve	tx;
+	tx.add_Source( 5, 1000000000 );
+	tx.add_Source( 7,  216000000 );
+	CHECK(  4,          tx.get_NumSrc() );
+	tx.add_Source( 2,  1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSolve::add_Source():  exceeds MaxSrc:  4", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## solve()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "solve() 25 kHz exact, largest Range" );
+    try {
+	CHECK(  1,          Tx.solve( 25000, 1000 ) );
+	CHECK(  6,          Tx.get_Source() );
+	CHECK(  4,          Tx.get_DivI() );
+	CHECK(  0,          Tx.get_DivF() );
+	CHECK(  0,          Tx.get_Mash() );
+	CHECK(  5000,       Tx.get_Range() );
+	CHECK(  0,          Tx.get_ErrPpb() );
+	CHECK(  1,          Tx.get_Freq() == 25000 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "solve() 50 Hz servo" );
+    try {
+	CHECK(  1,          Tx.solve( 50, 1000 ) );
+	CHECK(  6,          Tx.get_Source() );
+	CHECK(  4,          Tx.get_DivI() );
+	CHECK(  2500000,    Tx.get_Range() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "solve() not found, too fast for resolution" );
+    try {
+	CHECK(  0,          Tx.solve( 10000000, 1000 ) );
+	CHECK(  0,          Tx.get_Range() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "solve() fractional divisor" );
+    try {
+	Tx.clear_Sources();
+	Tx.add_Source( 1, 19200000 );
+	CHECK(  1,          Tx.solve( 440, 1000 ) );
+	CHECK(  1,          Tx.get_Source() );
+	CHECK(  27,         Tx.get_DivI() );
+	CHECK(  11,         Tx.get_DivF() );
+	CHECK(  1,          Tx.get_Mash() );
+	CHECK(  1616,       Tx.get_Range() );
+	CHECK(  545,        Tx.get_ErrPpb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "solve() integer only" );
+    try {
+	Tx.config_AllowFrac( 0 );
+	CHECK(  1,          Tx.solve( 440, 1000 ) );
+	CHECK(  2,          Tx.get_DivI() );
+	CHECK(  0,          Tx.get_DivF() );
+	CHECK(  21818,      Tx.get_Range() );
+	CHECK(  8333,       Tx.get_ErrPpb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "solve() freq_hz zero" );
+    try {
+	Tx.solve( 0, 100 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSolve::solve():  freq_hz is zero", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## apply()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "apply() no solution" );
+    try {
+	rgPwmSolve	tx;
+	tx.apply( &Cx, &Px );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmSolve::apply():  no solution", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "apply() clock and Range" );
+    try {
+	Tx.config_AllowFrac( 1 );
+	Tx.solve( 440, 1000 );
+	CHECK(  0,          Tx.apply( &Cx, &Px ) );
+	CHECKX( 0x5a000211, Cx.Cntl.read() );	// Mash=1, Enable, Source=1
+	CHECKX( 0x5a01b00b, Cx.Divr.read() );	// DivI=27, DivF=11
+	CHECK(  1616,       Px.Ch1Range.read() );
+	CHECK(  1616,       Px.Ch2Range.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,430 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgPwmStream  PWM Fifo sample streaming on rgPwm.
+//    10-19  Constructor, start()
+//    20-29  rgPwmStream_Ring
+//    30-39  convert(), convert2()
+//    40-49  service() by Stat
+//    50-59  Callback source, run()
+//    60-69  rgPwmStream_Feed, shared with rgsPwmStream
+//
+// Fake memory has a single Fifo word, so reading it returns the last word
+// written.  Presetting Stat selects the service path;  error flags are
+// cleared by writing back the value read, which leaves fake Stat unchanged.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgPwm.h"
+#include "rgPwmStream.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+/*
+* Test callback, ramp of samples from *ctx.
+*/
+static uint32_t
+ramp_source(
+    void		*ctx,
+    int16_t		*buf,
+    uint32_t		n
+)
+{
+    int16_t		*next = (int16_t*) ctx;
+
+    for ( uint32_t i=0;  i < n;  i++ ) {
+	buf[i] = (*next)++;
+    }
+
+    return  n;
+}
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgPwm			Px   ( &Bx );
+
+int16_t			rbuf[16];
+rgPwmStream_Ring	Ring ( rbuf, 16 );
+
+rgPwmStream		Tx   ( &Px );		// test object
+
+int16_t			samp[32];
+
+for ( int i=0;  i<32;  i++ )
+{
+    samp[i] = i * 1000;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor, start()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults" );
+    try {
+	rgPwmStream	tx  ( &Px );
+	CHECK(  0,          tx.get_Range() );
+	CHECK(  0,          tx.get_WordCnt() );
+	CHECK(  0,          tx.get_GapCnt() );
+	CHECK(  0,          tx.get_StarveCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+	CHECK(  8,          rgPwmStream::FifoDepth );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "start() no sample source" );
+    try {
+	rgPwmStream	tx  ( &Px );
+	tx.start();
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmStream::start():  no sample source", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "start() reads Ch1Range" );
+    try {
+	Px.Ch1Range.write( 1000 );
+	Tx.config_Ring( &Ring );
+	Tx.start();
+	CHECK(  1000,       Tx.get_Range() );
+	CHECK(  1000,       Tx.get_Range2() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "start() Range by Cntl UseFifo" );
+    try {
+	Px.Ch2Range.write( 3000 );
+	Px.Cntl.write( 0x00002020 );		// Ch1, Ch2 UseFifo
+	Tx.start();
+	CHECK(  1000,       Tx.get_Range() );
+	CHECK(  3000,       Tx.get_Range2() );
+	Px.Cntl.write( 0x00002000 );		// Ch2 UseFifo only
+	Tx.start();
+	CHECK(  3000,       Tx.get_Range() );
+	CHECK(  3000,       Tx.get_Range2() );
+	Px.Cntl.write( 0x00000020 );		// Ch1 UseFifo only
+	Tx.start();
+	CHECK(  1000,       Tx.get_Range() );
+	CHECK(  1000,       Tx.get_Range2() );
+	Px.Cntl.write( 0x00000000 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgPwmStream_Ring
+//--------------------------------------------------------------------------
+
+  CASE( "20", "ring size not power of 2" );
+    try {
+	rgPwmStream_Ring	rr  ( rbuf, 12 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgPwmStream_Ring:  size requires power of 2:  12", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "push_block() full, pop_block() wraps" );
+    try {
+	int16_t		out[20];
+	CHECK(  10,         Ring.push_block( samp, 10 ) );
+	CHECK(  10,         Ring.pop_block( out, 20 ) );
+	CHECK(  16,         Ring.push_block( samp, 20 ) );	// wraps
+	CHECK(  16,         Ring.count() );
+	CHECK(  0,          Ring.push_block( samp, 1 ) );
+	CHECK(  4,          Ring.pop_block( out, 4 ) );
+	CHECK(  0,          out[0] );
+	CHECK(  3000,       out[3] );
+	Ring.clear();
+	CHECK(  0,          Ring.count() );
+	CHECK(  0,          Ring.pop_block( out, 4 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## convert()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "convert() full scale" );
+    try {
+	int16_t		in[4]  = { -32768, 0, 32767, -16384 };
+	uint32_t	out[4];
+	rgPwmStream::convert( in, out, 4, 1000 );
+	CHECK(  0,          out[0] );
+	CHECK(  500,        out[1] );
+	CHECK(  999,        out[2] );
+	CHECK(  250,        out[3] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "convert() 32-bit range, no overflow" );
+    try {
+	int16_t		in[1]  = { 32767 };
+	uint32_t	out[1];
+	rgPwmStream::convert( in, out, 1, 0xffffffff );
+	CHECKX( 0xfffeffff, out[0] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "convert() block of 10, same as per sample" );
+    try {
+	int16_t		in[10] = { -32768, -1, 0, 1, 32767,
+				   -12345, 23456, 7, -7, 1000 };
+	uint32_t	out[11];
+	uint32_t	one[1];
+	out[10] = 0xdeadbeef;
+	rgPwmStream::convert( in, out, 10, 0xfffff001 );
+	for ( int i=0;  i<10;  i++ ) {
+	    rgPwmStream::convert( &in[i], one, 1, 0xfffff001 );
+	    if ( out[i] != one[0] ) {
+		FAIL( "sample differs" );
+	    }
+	}
+	CHECKX( 0x7ffff800, out[2] );
+	CHECKX( 0xdeadbeef, out[10] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "convert2() even by range, odd by range2" );
+    try {
+	int16_t		in[10] = { -32768, -1, 0, 1, 32767,
+				   -12345, 23456, 7, -7, 1000 };
+	uint32_t	out[10];
+	uint32_t	one[1];
+	rgPwmStream::convert2( in, out, 10, 1000, 0xfffff001 );
+	for ( int i=0;  i<10;  i++ ) {
+	    rgPwmStream::convert( &in[i], one, 1, (i & 1) ? 0xfffff001 : 1000 );
+	    if ( out[i] != one[0] ) {
+		FAIL( "sample differs" );
+	    }
+	}
+	CHECK(  500,        out[2] );
+	CHECKX( 0x8000f800, out[3] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## service() by Stat
+//--------------------------------------------------------------------------
+
+  CASE( "40", "service() FifoEmpty_1 burst" );
+    try {
+	Ring.push_block( samp, 10 );
+	Tx.start();
+	Px.Stat.write( 0x00000002 );		// FifoEmpty
+	CHECK(  8,          Tx.service() );
+	CHECK(  8,          Tx.get_WordCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECK(  606,        Px.Fifo.read() );	// sample 7000
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "service() not full, one word" );
+    try {
+	Px.Stat.write( 0x00000000 );
+	CHECK(  1,          Tx.service() );
+	CHECK(  9,          Tx.get_WordCnt() );
+	CHECK(  622,        Px.Fifo.read() );	// sample 8000
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "service() FifoFull_1, no room" );
+    try {
+	Px.Stat.write( 0x00000001 );		// FifoFull
+	CHECK(  0,          Tx.service() );
+	CHECK(  0,          Tx.get_StarveCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "service() ring runs dry" );
+    try {
+	Px.Stat.write( 0x00000002 );		// FifoEmpty
+	CHECK(  1,          Tx.service() );		// last sample
+	CHECK(  1,          Tx.get_StarveCnt() );
+	CHECK(  0,          Tx.service() );
+	CHECK(  2,          Tx.get_StarveCnt() );
+	CHECK(  10,         Tx.get_WordCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "44", "service() GapErr_1 counted" );
+    try {
+	Px.Stat.write( 0x00000020 );		// Ch2_GapErr
+	Tx.service();
+	CHECK(  1,          Tx.get_GapCnt() );
+	Px.Stat.write( 0x00000012 );		// Ch1_GapErr, FifoEmpty
+	Tx.service();
+	CHECK(  2,          Tx.get_GapCnt() );
+	Px.Stat.write( 0x00000004 );		// FifoWriteErr
+	Tx.service();
+	CHECK(  2,          Tx.get_GapCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Callback source, run()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "run() callback ramp" );
+    try {
+	int16_t		next = -32768;
+	Px.Ch1Range.write( 0x10000 );		// word = sample + 32768
+	Tx.config_Source( ramp_source, &next );
+	Tx.start();
+	Px.Stat.write( 0x00000002 );		// FifoEmpty
+	CHECK(  24,         Tx.run( 20 ) );
+	CHECK(  3,          Tx.get_PollCnt() );
+	CHECK(  -32768 + 64,  next );		// one block
+	CHECKX( 0x00000017, Px.Fifo.read() );	// sample 23
+	CHECK(  0,          Tx.get_StarveCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "run() stops at stop()" );
+    try {
+	Tx.stop();
+	Tx.run( 0 );
+	PASS( "no hang" );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## rgPwmStream_Feed, shared with rgsPwmStream
+//--------------------------------------------------------------------------
+
+rgPwmStream_Feed	Fx;
+
+  CASE( "60", "Feed constructor, has_source()" );
+    try {
+	int16_t		next = 0;
+	CHECK(  0,          Fx.has_source() );
+	CHECK(  0,          Fx.get_WordCnt() );
+	Fx.config_Source( ramp_source, &next );
+	CHECK(  1,          Fx.has_source() );
+	Fx.config_Ring( &Ring );
+	CHECK(  1,          Fx.has_source() );
+	CHECK(  64,         rgPwmStream_Feed::BlockSize );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "61", "Feed write_fifo() room, starve" );
+    try {
+	Ring.clear();
+	Ring.push_block( samp, 5 );
+	Fx.start( 0x10000 );
+	CHECK(  0x10000,    Fx.get_Range() );
+	CHECK(  3,          Fx.write_fifo( &Px.Fifo, 3 ) );
+	CHECKX( 0x8000 + 2000, Px.Fifo.read() );	// sample 2000
+	CHECK(  2,          Fx.write_fifo( &Px.Fifo, 4 ) );
+	CHECK(  1,          Fx.get_StarveCnt() );
+	CHECK(  5,          Fx.get_WordCnt() );
+	CHECK(  0,          Fx.write_fifo( &Px.Fifo, 0 ) );
+	CHECK(  1,          Fx.get_StarveCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "62", "Feed running(), stop(), start() clears" );
+    try {
+	CHECK(  1,          Fx.running( 0 ) );
+	CHECK(  1,          Fx.running( 6 ) );
+	CHECK(  0,          Fx.running( 5 ) );
+	Fx.stop();
+	CHECK(  0,          Fx.running( 0 ) );
+	Fx.start( 100 );
+	CHECK(  1,          Fx.running( 0 ) );
+	CHECK(  0,          Fx.get_WordCnt() );
+	CHECK(  0,          Fx.get_StarveCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "63", "Feed stereo phase kept across odd block" );
+    try {
+	Ring.clear();
+	Fx.start( 0x10000, 0x20000 );		// odd words doubled
+	CHECK(  0x20000,    Fx.get_Range2() );
+	Ring.push_block( samp, 3 );
+	CHECK(  3,          Fx.write_fifo( &Px.Fifo, 3 ) );
+	CHECKX( 0x8000 + 2000, Px.Fifo.read() );	// word 2, even
+	Ring.push_block( samp, 2 );
+	CHECK(  1,          Fx.write_fifo( &Px.Fifo, 1 ) );
+	CHECKX( 0x10000,    Px.Fifo.read() );		// word 3, odd, sample 0
+	CHECK(  1,          Fx.write_fifo( &Px.Fifo, 1 ) );
+	CHECKX( 0x8000 + 1000, Px.Fifo.read() );	// word 4, even
+	Ring.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
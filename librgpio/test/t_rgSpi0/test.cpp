@@ -4,6 +4,7 @@
 //    10-19  Constructor, get_bcm_address()
 //    20-29  Address of registers  addr()
 //    30-39  Direct register access  read(), write()
+//    40-49  DMA mode  dma_header()
 //    50-59  Object State registers  init_put_reset(), grab_regs(), push_regs()
 //    60-98  Object Field Accessors  get_(), put_()
 //--------------------------------------------------------------------------
@@ -351,6 +352,36 @@ rgRpiRev::Global.SocEnum.override( rgRpiRev::soc_BCM2711 );	// RPi4
 	FAIL( "unexpected exception" );
     }
 
+//--------------------------------------------------------------------------
+//## DMA mode  dma_header()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "dma_header()" );
+    try {
+	Tx.CntlStat.put( 0xffffff0e );
+	CHECKX( 0x0100008e, Tx.dma_header( 0x0100 ) );
+	CHECKX( 0xffff008e, Tx.dma_header( 0xffff ) );
+	Tx.CntlStat.put( 0x00000000 );
+	CHECKX( 0x00040080, Tx.dma_header( 4 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "dma_header() n exceeds 16 bits" );
+    try {
+	Tx.dma_header( 0x10000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0::dma_header():  require n <= 0xffff:  65536",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
 //--------------------------------------------------------------------------
 //## Object State  init_put_reset(), grab_regs(), push_regs()
 //--------------------------------------------------------------------------
@@ -0,0 +1,372 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgSpi0Lossi  LoSSI display panel streaming on SPI0.
+//    10-19  Constructor, config_PixFmt()
+//    20-29  Pixel row conversion  pack_rgb565(), pack_rgb666()
+//    30-39  clip_rect()
+//    40-49  send_cmd()
+//    50-59  push_rect(), push_dirty()
+//
+// Fake memory has a single Fifo word, so reading it returns the last word
+// written.  CntlStat is preset with TxHasSpace_1=1, TxEmpty_1=1 (done).
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+#include "rgSpi0Lossi.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgSpi0			Spx  ( &Bx, 0 );
+rgSpi0Lossi		Tx   ( &Spx, 8, 4 );	// test object
+
+uint32_t		fb[8*4];		// framebuffer 8 x 4
+
+for ( int i=0;  i<32;  i++ )
+{
+    fb[i] = 0x00010203 * i;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor, config_PixFmt()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor" );
+    try {
+	rgSpi0Lossi	tx  ( &Spx, 320, 240 );
+	CHECK(  320,        tx.get_Width() );
+	CHECK(  240,        tx.get_Height() );
+	CHECK(  rgSpi0Lossi::pix_RGB565, tx.config_PixFmt() );
+	CHECK(  0,          tx.get_WordCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "constructor bad width" );
+    try {
+	rgSpi0Lossi	tx  ( &Spx, 1025, 240 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Lossi:  require width {1..1024}:  1025",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "constructor bad height" );
+    try {
+	rgSpi0Lossi	tx  ( &Spx, 320, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Lossi:  require height {1..65535}:  0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "config_PixFmt()" );
+    try {
+	Tx.config_PixFmt( rgSpi0Lossi::pix_RGB666 );
+	CHECK(  rgSpi0Lossi::pix_RGB666, Tx.config_PixFmt() );
+	Tx.config_PixFmt( rgSpi0Lossi::pix_RGB565 );
+	CHECK(  rgSpi0Lossi::pix_RGB565, Tx.config_PixFmt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Pixel row conversion  pack_rgb565(), pack_rgb666()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "pack_rgb565()" );
+    try {
+	uint32_t	src[4] = { 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00123456 };
+	uint16_t	dst[9];
+	dst[8] = 0xdead;
+	CHECK(  8,          rgSpi0Lossi::pack_rgb565( src, dst, 4 ) );
+	CHECKX( 0x1f8,      dst[0] );
+	CHECKX( 0x100,      dst[1] );
+	CHECKX( 0x107,      dst[2] );
+	CHECKX( 0x1e0,      dst[3] );
+	CHECKX( 0x100,      dst[4] );
+	CHECKX( 0x11f,      dst[5] );
+	CHECKX( 0x111,      dst[6] );
+	CHECKX( 0x1aa,      dst[7] );
+	CHECKX( 0xdead,     dst[8] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "pack_rgb666()" );
+    try {
+	uint32_t	src[2] = { 0x00123456, 0xffffffff };
+	uint16_t	dst[7];
+	dst[6] = 0xdead;
+	CHECK(  6,          rgSpi0Lossi::pack_rgb666( src, dst, 2 ) );
+	CHECKX( 0x110,      dst[0] );
+	CHECKX( 0x134,      dst[1] );
+	CHECKX( 0x154,      dst[2] );
+	CHECKX( 0x1fc,      dst[3] );
+	CHECKX( 0x1fc,      dst[5] );
+	CHECKX( 0xdead,     dst[6] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "pack_rgb565() row of 10, same as per pixel" );
+    try {
+	uint16_t	dst[21];
+	uint16_t	wv[2];
+	dst[20] = 0xdead;
+	CHECK(  20,         rgSpi0Lossi::pack_rgb565( &fb[3], dst, 10 ) );
+	for ( int i=0;  i<10;  i++ ) {
+	    rgSpi0Lossi::pack_rgb565( &fb[3 + i], wv, 1 );
+	    if ( (dst[2*i] != wv[0]) || (dst[2*i + 1] != wv[1]) ) {
+		FAIL( "pixel differs" );
+	    }
+	}
+	CHECKX( 0xdead,     dst[20] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "pack_rgb666() row of 10, same as per pixel" );
+    try {
+	uint16_t	dst[31];
+	uint16_t	wv[3];
+	dst[30] = 0xdead;
+	CHECK(  30,         rgSpi0Lossi::pack_rgb666( &fb[3], dst, 10 ) );
+	for ( int i=0;  i<10;  i++ ) {
+	    rgSpi0Lossi::pack_rgb666( &fb[3 + i], wv, 1 );
+	    if ( (dst[3*i]     != wv[0]) || (dst[3*i + 1] != wv[1]) ||
+		 (dst[3*i + 2] != wv[2])
+	    ) {
+		FAIL( "pixel differs" );
+	    }
+	}
+	CHECKX( 0x100 | (fb[12] & 0xfc), dst[29] );
+	CHECKX( 0xdead,     dst[30] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## clip_rect()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "clip_rect() inside" );
+    try {
+	rgSpi0Lossi::Rect	rx = { 1, 1, 3, 2 };
+	CHECK(  1,          Tx.clip_rect( rx ) );
+	CHECK(  3,          rx.W );
+	CHECK(  2,          rx.H );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "clip_rect() overhang" );
+    try {
+	rgSpi0Lossi::Rect	rx = { 6, 3, 5, 5 };
+	CHECK(  1,          Tx.clip_rect( rx ) );
+	CHECK(  6,          rx.X );
+	CHECK(  3,          rx.Y );
+	CHECK(  2,          rx.W );
+	CHECK(  1,          rx.H );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "clip_rect() outside or empty" );
+    try {
+	rgSpi0Lossi::Rect	ra = { 8, 0, 1, 1 };
+	rgSpi0Lossi::Rect	rb = { 0, 4, 1, 1 };
+	rgSpi0Lossi::Rect	rc = { 0, 0, 0, 1 };
+	rgSpi0Lossi::Rect	rd = { 0, 0, 1, 0 };
+	CHECK(  0,          Tx.clip_rect( ra ) );
+	CHECK(  0,          Tx.clip_rect( rb ) );
+	CHECK(  0,          Tx.clip_rect( rc ) );
+	CHECK(  0,          Tx.clip_rect( rd ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## send_cmd()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "send_cmd() no parameters" );
+    try {
+	Spx.CntlStat.write( 0x00050000 );	// TxHasSpace, TxEmpty
+	Tx.send_cmd( 0x29 );
+	CHECKX( 0x029,      Spx.Fifo.read() );
+	CHECK(  1,          Tx.get_WordCnt() );
+	CHECK(  2,          Tx.get_PollCnt() );
+	CHECKX( 0x00052000, Spx.CntlStat.read() );	// LoSSI, not active
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "send_cmd() with parameters" );
+    try {
+	uint8_t		pv[3] = { 0x11, 0x22, 0x33 };
+	Tx.send_cmd( 0x3a, pv, 3 );
+	CHECKX( 0x133,      Spx.Fifo.read() );
+	CHECK(  4,          Tx.get_WordCnt() );
+	CHECK(  2,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "send_cmd() parameters exceed one burst" );
+    try {
+	uint8_t		pv[40];
+	for ( int i=0;  i<40;  i++ ) { pv[i] = i; }
+	Tx.send_cmd( 0x3a, pv, 40 );
+	CHECKX( 0x127,      Spx.Fifo.read() );
+	CHECK(  41,         Tx.get_WordCnt() );
+	CHECK(  4,          Tx.get_PollCnt() );		// 16+16+9, end
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "send_cmd() Rx full, end() returns" );
+    try {
+	uint8_t		pv[3] = { 0x11, 0x22, 0x33 };
+	Spx.CntlStat.write( 0x00100000 );	// RxFull only
+	Tx.send_cmd( 0x3a, pv, 3 );
+	CHECK(  4,          Tx.get_WordCnt() );
+	CHECK(  2,          Tx.get_PollCnt() );
+	CHECKX( 0x00102000, Spx.CntlStat.read() );	// LoSSI, not active
+	Spx.CntlStat.write( 0x00050000 );	// TxHasSpace, TxEmpty
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## push_rect(), push_dirty()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "push_rect() RGB565" );
+    try {
+	rgSpi0Lossi::Rect	rx = { 2, 1, 3, 2 };
+	CHECK(  6,          Tx.push_rect( fb, 8, rx ) );
+	CHECK(  23,         Tx.get_WordCnt() );	// 5 + 5 + 1 + 2*6
+	uint16_t	wv[2];
+	rgSpi0Lossi::pack_rgb565( &fb[2*8 + 4], wv, 1 );
+	CHECKX( wv[1],      Spx.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "push_rect() RGB666, full panel" );
+    try {
+	rgSpi0Lossi::Rect	rx = { 0, 0, 8, 4 };
+	Tx.config_PixFmt( rgSpi0Lossi::pix_RGB666 );
+	CHECK(  32,         Tx.push_rect( fb, 8, rx ) );
+	CHECK(  107,        Tx.get_WordCnt() );	// 11 + 32*3
+	CHECK(  12,         Tx.get_PollCnt() );	// 3 + 4 rows * 2 + end
+	CHECKX( 0x100 | (fb[31] & 0xfc), Spx.Fifo.read() );
+	Tx.config_PixFmt( rgSpi0Lossi::pix_RGB565 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "push_rect() clipped, empty" );
+    try {
+	rgSpi0Lossi::Rect	ra = { 6, 3, 5, 5 };
+	rgSpi0Lossi::Rect	rb = { 9, 0, 5, 5 };
+	CHECK(  2,          Tx.push_rect( fb, 8, ra ) );
+	CHECK(  15,         Tx.get_WordCnt() );
+	CHECK(  0,          Tx.push_rect( fb, 8, rb ) );
+	CHECK(  0,          Tx.get_WordCnt() );
+	CHECK(  0,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "53", "push_dirty() one frame" );
+    try {
+	rgSpi0Lossi::Rect	rv[3] = {
+	    { 0, 0, 2, 1 },
+	    { 9, 9, 1, 1 },		// outside, skipped
+	    { 7, 3, 1, 1 },
+	};
+	CHECK(  3,          Tx.push_dirty( fb, 8, rv, 3 ) );
+	CHECK(  28,         Tx.get_WordCnt() );	// 11 + 4,  11 + 2
+	uint16_t	wv[2];
+	rgSpi0Lossi::pack_rgb565( &fb[31], wv, 1 );
+	CHECKX( wv[1],      Spx.Fifo.read() );
+	CHECKX( 0x00052000, Spx.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "54", "push_dirty() nothing to send" );
+    try {
+	rgSpi0Lossi::Rect	rv[1] = {
+	    { 0, 0, 0, 0 },
+	};
+	Spx.CntlStat.write( 0x00050000 );
+	CHECK(  0,          Tx.push_dirty( fb, 8, rv, 1 ) );
+	CHECK(  0,          Tx.get_WordCnt() );
+	CHECKX( 0x00050000, Spx.CntlStat.read() );	// no access
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,275 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgSpi0Mux  Concurrent transfers on several SPI0 units.
+//    10-19  Constructor, add_xfer(), clear()
+//    20-29  run() several units in loopback
+//    30-39  service_all() stall statistics
+//    40-49  Statistics index check
+//
+// Fake memory has a single Fifo word per unit, so reading it returns the
+// last byte written.  CntlStat status bits select the service path.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+#include "rgSpi0Mux.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );	// RPi4
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgSpi0			S0   ( &Bx, 0 );
+rgSpi0			S3   ( &Bx, 3 );
+rgSpi0			S4   ( &Bx, 4 );
+rgSpi0			S5   ( &Bx, 5 );
+rgSpi0			S6   ( &Bx, 6 );
+
+rgSpi0Mux		Tx;			// test object
+
+uint8_t			txbuf[256];
+uint8_t			rx0[256];
+uint8_t			rx3[256];
+uint8_t			rx4[256];
+
+for ( int i=0;  i<256;  i++ )
+{
+    txbuf[i] = i ^ 0x3c;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor, add_xfer(), clear()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor" );
+    try {
+	rgSpi0Mux	tx;
+	CHECK(  0,          tx.get_NumUnit() );
+	CHECK(  0,          tx.get_TotalCnt() );
+	CHECK(  5,          rgSpi0Mux::MaxUnit );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "add_xfer() index" );
+    try {
+	CHECK(  0,          Tx.add_xfer( &S0, txbuf, rx0, 10 ) );
+	CHECK(  1,          Tx.add_xfer( &S3, txbuf, rx3, 10 ) );
+	CHECK(  2,          Tx.get_NumUnit() );
+	Tx.clear();
+	CHECK(  0,          Tx.get_NumUnit() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "add_xfer() duplicate unit" );
+    try {
+	rgSpi0		s3b  ( &Bx, 3 );
+	Tx.add_xfer( &S3, txbuf, rx3, 10 );
+	Tx.add_xfer( &s3b, txbuf, rx3, 10 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Mux::add_xfer():  duplicate spi unit:  3",
+	    e.what()
+	);
+	CHECK(  1,          Tx.get_NumUnit() );
+	Tx.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "add_xfer() exceeds MaxUnit" );
+    try {
+	rgSpi0		s0b  ( &Bx, 0 );
+	Tx.add_xfer( &S0, txbuf, rx0, 10 );
+	Tx.add_xfer( &S3, txbuf, rx3, 10 );
+	Tx.add_xfer( &S4, txbuf, rx4, 10 );
+	Tx.add_xfer( &S5, txbuf, NULL, 10 );
+	Tx.add_xfer( &S6, txbuf, NULL, 10 );
+	CHECK(  5,          Tx.get_NumUnit() );
+	Tx.add_xfer( &s0b, txbuf, rx0, 10 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Mux::add_xfer():  exceeds MaxUnit:  5",
+	    e.what()
+	);
+	Tx.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run() several units in loopback
+//--------------------------------------------------------------------------
+
+  CASE( "20", "run() three units, different lengths" );
+    try {
+	S0.CntlStat.write( 0x00060000 );	// TxHasSpace, RxHasData
+	S3.CntlStat.write( 0x00060000 );
+	S4.CntlStat.write( 0x00060000 );
+	for ( int i=0;  i<256;  i++ ) { rx0[i] = rx3[i] = rx4[i] = 0; }
+	Tx.add_xfer( &S0, txbuf,      rx0, 100 );
+	Tx.add_xfer( &S3, txbuf + 1,  rx3,  50 );
+	Tx.add_xfer( &S4, txbuf + 2,  rx4, 200 );
+	CHECK(  350,        Tx.run() );
+	int	bad = 0;
+	for ( int i=0;  i<100;  i++ ) { if ( rx0[i] != txbuf[i]   ) bad++; }
+	for ( int i=0;  i< 50;  i++ ) { if ( rx3[i] != txbuf[i+1] ) bad++; }
+	for ( int i=0;  i<200;  i++ ) { if ( rx4[i] != txbuf[i+2] ) bad++; }
+	CHECK(  0,          bad );
+	CHECK(  100,        Tx.get_ByteCnt( 0 ) );
+	CHECK(   50,        Tx.get_ByteCnt( 1 ) );
+	CHECK(  200,        Tx.get_ByteCnt( 2 ) );
+	CHECK(  101,        Tx.get_PollCnt( 0 ) );
+	CHECK(   51,        Tx.get_PollCnt( 1 ) );
+	CHECK(  201,        Tx.get_PollCnt( 2 ) );
+	CHECK(  0,          Tx.get_StallCnt( 0 ) );
+	CHECK(  0,          Tx.get_StallCnt( 2 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "run() released RunActive_1 on all units" );
+    try {
+	CHECKX( 0x00060000, S0.CntlStat.read() );
+	CHECKX( 0x00060000, S3.CntlStat.read() );
+	CHECKX( 0x00060000, S4.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "run() again, same units" );
+    try {
+	S3.CntlStat.write( 0x00050000 );	// TxHasSpace, TxEmpty burst
+	CHECK(  350,        Tx.run() );
+	CHECK(  2,          Tx.get_PollCnt( 1 ) );		// 50 bytes burst
+	Tx.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## service_all() stall statistics
+//--------------------------------------------------------------------------
+
+  CASE( "30", "service_all() one unit stalled" );
+    try {
+	S0.CntlStat.write( 0x00060000 );
+	S5.CntlStat.write( 0x00000000 );	// no status, never ready
+	Tx.add_xfer( &S0, txbuf, rx0, 4 );
+	Tx.add_xfer( &S5, txbuf, NULL, 4 );
+	Tx.start_all();
+	CHECK(  2,          Tx.service_all() );
+	CHECK(  2,          Tx.service_all() );
+	CHECK(  2,          Tx.service_all() );
+	CHECK(  2,          Tx.service_all() );
+	CHECK(  1,          Tx.service_all() );		// unit 0 done
+	CHECK(  1,          Tx.service_all() );
+	CHECK(  4,          Tx.get_ByteCnt( 0 ) );
+	CHECK(  0,          Tx.get_ByteCnt( 1 ) );
+	CHECK(  0,          Tx.get_StallCnt( 0 ) );
+	CHECK(  6,          Tx.get_StallCnt( 1 ) );
+	CHECKX( 0x000000b0, S5.CntlStat.read() );	// still active
+	CHECKX( 0x00060000, S0.CntlStat.read() );	// released
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "end_all() releases stalled unit" );
+    try {
+	Tx.end_all();
+	CHECKX( 0x00000000, S5.CntlStat.read() );
+	CHECK(  0,          Tx.service_all() );
+	Tx.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Statistics index check
+//--------------------------------------------------------------------------
+
+  CASE( "40", "get_ByteCnt() bad index" );
+    try {
+	Tx.add_xfer( &S0, txbuf, rx0, 4 );
+	Tx.get_ByteCnt( 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Mux::get_ByteCnt():  index exceeds NumUnit:  1",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "get_StallCnt() bad index" );
+    try {
+	Tx.get_StallCnt( 5 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Mux::get_StallCnt():  index exceeds NumUnit:  5",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "get_PollCnt() bad index" );
+    try {
+	Tx.clear();
+	Tx.get_PollCnt( 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Mux::get_PollCnt():  index exceeds NumUnit:  0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
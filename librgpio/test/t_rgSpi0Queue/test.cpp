@@ -0,0 +1,246 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgSpi0Queue  Batched small transactions on one SPI0 unit.
+//    10-19  Constructor, config_Reorder()
+//    20-29  run() frames, Merge, Reorder
+//    30-39  run() descriptor checks
+//
+// Fake memory has a single Fifo word, so reading it returns the last byte
+// written.  CntlStat is preset with TxEmpty_1=1 (done).
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+#include "rgSpi0Queue.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );	// RPi4
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgSpi0			Spx  ( &Bx, 0 );
+rgSpi0Queue		Tx   ( &Spx );		// test object
+
+uint8_t			cmd[4]  = { 0x0b, 0x12, 0x34, 0x56 };
+uint8_t			rxa[8];
+uint8_t			rxb[8];
+
+//--------------------------------------------------------------------------
+//## Constructor, config_Reorder()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor" );
+    try {
+	rgSpi0Queue	tx  ( &Spx );
+	CHECK(  0,          tx.config_Reorder() );
+	CHECK(  0,          tx.get_XactCnt() );
+	CHECK(  0,          tx.get_FrameCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_Reorder()" );
+    try {
+	Tx.config_Reorder( 1 );
+	CHECK(  1,          Tx.config_Reorder() );
+	Tx.config_Reorder( 0 );
+	CHECK(  0,          Tx.config_Reorder() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run() frames, Merge, Reorder
+//--------------------------------------------------------------------------
+
+  CASE( "20", "run() one frame per transaction" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 0,  cmd, 2,  rxa,  2,  0 },
+	    { 1,  cmd, 1,  rxb,  4,  0 },
+	    { 0,  cmd, 4,  NULL, 0,  0 },
+	};
+	Spx.CntlStat.write( 0x00050002 );	// done, ChipSelectN_2=2
+	CHECK(  3,          Tx.run( xv, 3 ) );
+	CHECK(  3,          Tx.get_XactCnt() );
+	CHECK(  3,          Tx.get_FrameCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+	CHECKX( 0x00050002, Spx.CntlStat.read() );	// restored
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "run() Rx data after Tx" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 0,  cmd, 2,  rxa,  3,  0 },
+	};
+	for ( int i=0;  i<8;  i++ ) { rxa[i] = 0; }
+	Spx.config_FillByte( 0x77 );
+	CHECK(  1,          Tx.run( xv, 1 ) );
+	CHECKX( 0x77,       rxa[0] );		// fake Fifo holds last byte
+	CHECKX( 0x77,       rxa[2] );
+	CHECKX( 0x00,       rxa[3] );
+	Spx.config_FillByte( 0x00 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "run() Merge same Cs" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 0,  cmd, 2,  rxa,  2,  0 },
+	    { 0,  cmd, 2,  rxa,  2,  1 },	// merge
+	    { 1,  cmd, 2,  rxa,  2,  1 },	// Cs differs, new frame
+	    { 1,  cmd, 2,  rxa,  2,  0 },	// no merge, new frame
+	};
+	CHECK(  4,          Tx.run( xv, 4 ) );
+	CHECK(  3,          Tx.get_FrameCnt() );
+	CHECK(  4,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23a", "run() interleaved Cs, no Reorder" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 1,  cmd, 2,  rxa,  2,  1 },
+	    { 0,  cmd, 2,  rxa,  2,  1 },
+	    { 1,  cmd, 2,  rxa,  2,  1 },
+	    { 0,  cmd, 2,  rxa,  2,  1 },
+	};
+	CHECK(  4,          Tx.run( xv, 4 ) );
+	CHECK(  4,          Tx.get_FrameCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23b", "run() interleaved Cs, Reorder" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 1,  cmd, 2,  rxa,  2,  1 },
+	    { 0,  cmd, 2,  rxa,  2,  1 },
+	    { 1,  cmd, 2,  rxa,  2,  1 },
+	    { 0,  cmd, 2,  rxa,  2,  1 },
+	};
+	Tx.config_Reorder( 1 );
+	CHECK(  4,          Tx.run( xv, 4 ) );
+	CHECK(  2,          Tx.get_FrameCnt() );
+	CHECK(  4,          Tx.get_XactCnt() );
+	Tx.config_Reorder( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "run() zero length transaction, no poll" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 2,  NULL, 0,  NULL,  0,  0 },
+	};
+	CHECK(  1,          Tx.run( xv, 1 ) );
+	CHECK(  1,          Tx.get_FrameCnt() );
+	CHECK(  0,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "run() empty queue" );
+    try {
+	CHECK(  0,          Tx.run( NULL, 0 ) );
+	CHECK(  0,          Tx.get_FrameCnt() );
+	CHECKX( 0x00050002, Spx.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run() descriptor checks
+//--------------------------------------------------------------------------
+
+  CASE( "30", "run() Cs exceeds 3" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 0,  cmd, 2,  rxa,  2,  0 },
+	    { 4,  cmd, 2,  rxa,  2,  0 },
+	};
+	Spx.CntlStat.write( 0x00050001 );
+	Tx.run( xv, 2 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Queue::run():  Cs exceeds 3 in xv[1]:  4",
+	    e.what()
+	);
+	CHECKX( 0x00050001, Spx.CntlStat.read() );	// no access
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "run() frame exceeds FifoDepth" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 0,  NULL, 60,  NULL,  5,  0 },
+	};
+	Tx.run( xv, 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgSpi0Queue::run():  frame exceeds FifoDepth in xv[0]:  65",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "run() frame equal FifoDepth" );
+    try {
+	rgSpi0_Xact	xv[] = {
+	    { 0,  NULL, 60,  NULL,  4,  0 },
+	};
+	CHECK(  1,          Tx.run( xv, 1 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,347 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgSpi0  SPI0 Master class - polled transfer engine.
+//    10-19  Constructor state, config_FillByte()
+//    20-29  Fifo loopback, one byte per pass  transfer()
+//    30-39  Tx done burst path, Tx-only, Rx-only
+//    40-49  Flow control  start_xfer(), service_xfer(), end_xfer()
+//    50-59  Scatter/gather  transferv()
+//
+// Fake memory has a single Fifo word, so reading it returns the last byte
+// written.  Presetting CntlStat status bits selects the service path.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );	// RPi4
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgSpi0			Tx   ( &Bx, 3 );	// test object
+
+uint8_t			txbuf[256];
+uint8_t			rxbuf[256];
+
+for ( int i=0;  i<256;  i++ )
+{
+    txbuf[i] = i ^ 0x5a;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor state, config_FillByte()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor transfer state" );
+    try {
+	rgSpi0		tx  ( &Bx, 0 );
+	CHECK(  1,          tx.is_xfer_done() );
+	CHECK(  0,          tx.get_XferTxCnt() );
+	CHECK(  0,          tx.get_XferRxCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+	CHECKX( 0x00,       tx.config_FillByte() );
+	CHECK(  64,         rgSpi0::FifoDepth );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_FillByte()" );
+    try {
+	Tx.config_FillByte( 0xff );
+	CHECKX( 0xff,       Tx.config_FillByte() );
+	Tx.config_FillByte( 0x00 );
+	CHECKX( 0x00,       Tx.config_FillByte() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Fifo loopback, one byte per pass  transfer()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "transfer() one byte per pass" );
+    try {
+	Tx.CntlStat.write( 0x00060000 );	// TxHasSpace, RxHasData
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0; }
+	CHECK(  5,          Tx.transfer( txbuf, rxbuf, 5 ) );
+	CHECKX( 0x5a,       rxbuf[0] );
+	CHECKX( 0x5b,       rxbuf[1] );
+	CHECKX( 0x58,       rxbuf[2] );
+	CHECKX( 0x59,       rxbuf[3] );
+	CHECKX( 0x5e,       rxbuf[4] );
+	CHECKX( 0x00,       rxbuf[5] );
+	CHECK(  5,          Tx.get_XferTxCnt() );
+	CHECK(  5,          Tx.get_XferRxCnt() );
+	CHECK(  6,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "transfer() releases RunActive_1" );
+    try {
+	Tx.CntlStat.write( 0x00060003 );	// ChipSelectN_2=3
+	CHECK(  3,          Tx.transfer( txbuf, rxbuf, 3 ) );
+	CHECKX( 0x00060003, Tx.CntlStat.read() );
+	CHECK(  1,          Tx.is_xfer_done() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "transfer() 200 bytes loopback" );
+    try {
+	Tx.CntlStat.write( 0x00060000 );
+	CHECK(  200,        Tx.transfer( txbuf, rxbuf, 200 ) );
+	int	bad = 0;
+	for ( int i=0;  i<200;  i++ )  { if ( rxbuf[i] != txbuf[i] ) bad++; }
+	CHECK(  0,          bad );
+	CHECK(  201,        Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Tx done burst path, Tx-only, Rx-only
+//--------------------------------------------------------------------------
+
+  CASE( "30", "transfer() Tx done burst" );
+    try {
+	Tx.CntlStat.write( 0x00050000 );	// TxHasSpace, TxEmpty
+	CHECK(  100,        Tx.transfer( txbuf, rxbuf, 100 ) );
+	CHECK(  3,          Tx.get_PollCnt() );		// 64 + 36 bytes
+	CHECKX( txbuf[63],  rxbuf[0] );		// fake Fifo holds last byte
+	CHECKX( txbuf[63],  rxbuf[63] );
+	CHECKX( txbuf[99],  rxbuf[64] );
+	CHECKX( txbuf[99],  rxbuf[99] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "transfer() Rx full burst" );
+    try {
+	Tx.CntlStat.write( 0x00100000 );	// RxFullStop
+	CHECK(  64,         Tx.transfer( txbuf, rxbuf, 64 ) );
+	CHECK(  2,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "transfer() Tx-only, rx NULL" );
+    try {
+	Tx.CntlStat.write( 0x00060000 );
+	rxbuf[0] = 0x33;
+	CHECK(  10,         Tx.transfer( txbuf, NULL, 10 ) );
+	CHECK(  10,         Tx.get_XferRxCnt() );
+	CHECKX( 0x33,       rxbuf[0] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "transfer() Rx-only, tx NULL" );
+    try {
+	Tx.CntlStat.write( 0x00060000 );
+	Tx.config_FillByte( 0xa5 );
+	CHECK(  4,          Tx.transfer( NULL, rxbuf, 4 ) );
+	CHECKX( 0xa5,       rxbuf[0] );
+	CHECKX( 0xa5,       rxbuf[3] );
+	Tx.config_FillByte( 0x00 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "34", "transfer() zero length" );
+    try {
+	Tx.CntlStat.write( 0x00060000 );
+	CHECK(  0,          Tx.transfer( txbuf, rxbuf, 0 ) );
+	CHECK(  0,          Tx.get_PollCnt() );
+	CHECKX( 0x00060000, Tx.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Flow control  start_xfer(), service_xfer(), end_xfer()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "start_xfer() sets RunActive_1, clears Fifos" );
+    try {
+	Tx.CntlStat.write( 0x00000001 );
+	Tx.start_xfer( txbuf, rxbuf, 10 );
+	CHECKX( 0x000000b1, Tx.CntlStat.read() );
+	CHECK(  0,          Tx.is_xfer_done() );
+	Tx.end_xfer();
+	CHECKX( 0x00000001, Tx.CntlStat.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "service_xfer() Tx Fifo full, no progress" );
+    try {
+	Tx.CntlStat.write( 0x00020000 );	// RxHasData only
+	Tx.start_xfer( txbuf, rxbuf, 10 );
+	for ( int i=0;  i<5;  i++ ) {
+	    CHECK(  0,      Tx.service_xfer() );
+	}
+	CHECK(  0,          Tx.get_XferTxCnt() );
+	CHECK(  0,          Tx.get_XferRxCnt() );
+	CHECK(  5,          Tx.get_PollCnt() );
+	Tx.end_xfer();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "service_xfer() in-flight limit FifoDepth" );
+    try {
+	Tx.CntlStat.write( 0x00040000 );	// TxHasSpace only
+	Tx.start_xfer( txbuf, rxbuf, 200 );
+	for ( int i=0;  i<100;  i++ ) {
+	    Tx.service_xfer();
+	}
+	CHECK(  64,         Tx.get_XferTxCnt() );
+	CHECK(  0,          Tx.get_XferRxCnt() );
+	CHECK(  0,          Tx.is_xfer_done() );
+	Tx.end_xfer();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "service_xfer() after done, no status read" );
+    try {
+	Tx.CntlStat.write( 0x00050000 );
+	Tx.start_xfer( txbuf, rxbuf, 2 );
+	CHECK(  0,          Tx.service_xfer() );
+	CHECK(  1,          Tx.service_xfer() );
+	CHECK(  1,          Tx.service_xfer() );
+	CHECK(  2,          Tx.get_PollCnt() );
+	Tx.end_xfer();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Scatter/gather  transferv()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "transferv() Tx 3 segments, Rx 2 segments" );
+    try {
+	uint8_t		hdr[2]  = { 0x11, 0x22 };
+	uint8_t		crc[1]  = { 0x99 };
+	uint8_t		rhead[3];
+	struct iovec	txv[3]  = { {hdr, 2}, {txbuf, 5}, {crc, 1} };
+	struct iovec	rxv[2]  = { {rhead, 3}, {rxbuf, 5} };
+	Tx.CntlStat.write( 0x00060000 );	// TxHasSpace, RxHasData
+	CHECK(  8,          Tx.transferv( txv, 3, rxv, 2 ) );
+	CHECKX( 0x11,       rhead[0] );
+	CHECKX( 0x22,       rhead[1] );
+	CHECKX( txbuf[0],   rhead[2] );
+	CHECKX( txbuf[1],   rxbuf[0] );
+	CHECKX( txbuf[4],   rxbuf[3] );
+	CHECKX( 0x99,       rxbuf[4] );
+	CHECKX( 0x00000000, Tx.CntlStat.read() & 0x80 );	// RunActive_1
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "transferv() NULL and empty segments" );
+    try {
+	uint8_t		rtail[2];
+	struct iovec	txv[3]  = { {NULL, 2}, {txbuf, 0}, {txbuf, 2} };
+	struct iovec	rxv[2]  = { {NULL, 2}, {rtail, 2} };
+	Tx.CntlStat.write( 0x00060000 );
+	Tx.config_FillByte( 0xa5 );
+	rxbuf[0] = 0x33;
+	CHECK(  4,          Tx.transferv( txv, 3, rxv, 2 ) );
+	CHECKX( txbuf[0],   rtail[0] );
+	CHECKX( txbuf[1],   rtail[1] );
+	CHECKX( 0x33,       rxbuf[0] );
+	Tx.config_FillByte( 0x00 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "transferv() Tx shorter, padded with FillByte" );
+    try {
+	struct iovec	txv[1]  = { {txbuf, 1} };
+	struct iovec	rxv[1]  = { {rxbuf, 3} };
+	Tx.CntlStat.write( 0x00060000 );
+	Tx.config_FillByte( 0xa5 );
+	CHECK(  3,          Tx.transferv( txv, 1, rxv, 1 ) );
+	CHECKX( txbuf[0],   rxbuf[0] );
+	CHECKX( 0xa5,       rxbuf[1] );
+	CHECKX( 0xa5,       rxbuf[2] );
+	Tx.config_FillByte( 0x00 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "53", "transferv() Rx shorter, rest discarded" );
+    try {
+	struct iovec	txv[1]  = { {txbuf, 4} };
+	struct iovec	rxv[1]  = { {rxbuf, 1} };
+	Tx.CntlStat.write( 0x00060000 );
+	rxbuf[1] = 0x33;
+	CHECK(  4,          Tx.transferv( txv, 1, rxv, 1 ) );
+	CHECK(  4,          Tx.get_XferTxCnt() );
+	CHECKX( txbuf[0],   rxbuf[0] );
+	CHECKX( 0x33,       rxbuf[1] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "54", "start_xferv() empty lists" );
+    try {
+	Tx.start_xferv( NULL, 0, NULL, 0 );
+	CHECK(  1,          Tx.is_xfer_done() );
+	Tx.end_xfer();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
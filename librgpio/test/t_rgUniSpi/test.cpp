@@ -495,6 +495,34 @@ rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
 	FAIL( "unexpected exception" );
     }
 
+  CASE( "34a", "write_AuxEn_mask() both SPIs, Mini UART kept" );
+    try {
+	Tx1.AuxEn.write(     0x00000001 );
+	Tx1.write_AuxEn_mask( 0x6, 0x6 );
+	CHECKX(              0x00000007, Tx1.AuxEn.read() );
+	Tx2.write_AuxEn_mask( 0x6, 0x2 );
+	CHECKX(              0x00000003, Tx2.AuxEn.read() );
+	Tx2.write_AuxEn_mask( 0x0, 0x7 );
+	CHECKX(              0x00000003, Tx2.AuxEn.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "34b", "write_AuxEn_mask() mask error" );
+    try {
+	Tx1.write_AuxEn_mask( 0x8, 0x0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpi::write_AuxEn_mask():  mask exceeds 0x7:  0x8",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
 //--------------------------------------------------------------------------
 //## Direct register access  read(), write()
 //--------------------------------------------------------------------------
@@ -0,0 +1,254 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgUniSpiAdc  Continuous ADC acquisition on rgUniSpi.
+//    10-19  rgUniSpiAdc_Ring  constructor, push(), pop(), count()
+//    20-29  Constructor, config_Cmd(), config_Bits()
+//    30-39  run(), stop()
+//
+// Fake memory has a single Fifo word, so every Rx word read is the Cmd
+// word written.  Stat RxLevel_3=4 is preset.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+#include "rgSysTimer.h"
+#include "rgUniSpiAdc.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgUniSpi		Spx  ( &Bx, 1 );
+rgSysTimer		Stx  ( &Bx );
+
+rgUniSpiAdc_Sample	Buf[16];
+rgUniSpiAdc_Ring	Ring ( Buf, 16 );
+
+rgUniSpiAdc		Tx   ( &Spx, &Stx, &Ring );	// test object
+
+rgUniSpiAdc_Sample	ss;
+
+//--------------------------------------------------------------------------
+//## rgUniSpiAdc_Ring  constructor, push(), pop(), count()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "Ring constructor" );
+    try {
+	rgUniSpiAdc_Ring	rx  ( Buf, 4 );
+	CHECK(  4,          rx.get_Size() );
+	CHECK(  0,          rx.count() );
+	CHECK(  0,          rx.pop( ss ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11a", "Ring constructor size not power of 2" );
+    try {
+	rgUniSpiAdc_Ring	rx  ( Buf, 12 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiAdc_Ring:  size requires power of 2:  12", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11b", "Ring constructor size 1" );
+    try {
+	rgUniSpiAdc_Ring	rx  ( Buf, 1 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiAdc_Ring:  size requires power of 2:  1", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "push() until full, pop() in order" );
+    try {
+	rgUniSpiAdc_Ring	rx  ( Buf, 4 );
+	for ( uint32_t i=0;  i<4;  i++ ) {
+	    ss.Time  = 100 + i;
+	    ss.Value = i;
+	    CHECK(  1,      rx.push( ss ) );
+	}
+	CHECK(  4,          rx.count() );
+	CHECK(  0,          rx.push( ss ) );
+	CHECK(  1,          rx.pop( ss ) );
+	CHECK(  100,        ss.Time );
+	CHECK(  0,          ss.Value );
+	CHECK(  1,          rx.pop( ss ) );
+	CHECK(  101,        ss.Time );
+	CHECK(  2,          rx.count() );
+	rx.clear();
+	CHECK(  0,          rx.count() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "push(), pop() across the end of storage" );
+    try {
+	rgUniSpiAdc_Ring	rx  ( Buf, 4 );
+	uint32_t		sum = 0;
+	for ( uint32_t i=0;  i<11;  i++ ) {
+	    ss.Value = i;
+	    rx.push( ss );
+	    rx.pop( ss );
+	    sum += ss.Value;
+	}
+	CHECK(  55,         sum );
+	CHECK(  0,          rx.count() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Constructor, config_Cmd(), config_Bits()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "constructor" );
+    try {
+	rgUniSpiAdc	tx  ( &Spx, &Stx, &Ring );
+	CHECKX( 0x00000000, tx.config_Cmd() );
+	CHECK(  0,          tx.config_Bits() );
+	CHECK(  0,          tx.get_SampleCnt() );
+	CHECK(  0,          tx.get_DropCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "config_Cmd(), config_Bits()" );
+    try {
+	rgUniSpiAdc	tx  ( &Spx, &Stx, &Ring );
+	tx.config_Cmd( 0xc0000018 );
+	CHECKX( 0xc0000018, tx.config_Cmd() );
+	tx.config_Bits( 32 );
+	CHECK(  32,         tx.config_Bits() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "config_Bits() range error" );
+    try {
+	rgUniSpiAdc	tx  ( &Spx, &Stx, &Ring );
+	tx.config_Bits( 33 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiAdc::config_Bits():  requires {0..32}:  33", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run(), stop()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "run() LSB in, timestamp" );
+    try {
+	Spx.Cntl1.write( 0x00000000 );		// InMsbFirst_1=0
+	Spx.Stat.write(  0x00400000 );		// RxLevel_3=4
+	Stx.TimeW1.write( 0x00000001 );
+	Stx.TimeW0.write( 0x00002000 );
+	Ring.clear();
+	Tx.config_Cmd(  0xabc00fff );
+	Tx.config_Bits( 12 );
+	CHECK(  10,         Tx.run( 10 ) );
+	CHECK(  10,         Tx.get_SampleCnt() );
+	CHECK(  0,          Tx.get_DropCnt() );
+	CHECK(  4,          Tx.get_PollCnt() );
+	CHECK(  10,         Ring.count() );
+	CHECK(  1,          Ring.pop( ss ) );
+	CHECKX( 0x00000abc, ss.Value );
+	CHECKX( 0x00002000, (uint32_t) ss.Time );
+	CHECKX( 0x00000001, ss.Time >> 32 );
+	CHECKX( 0xabc00fff, Spx.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "run() MSB in, KeepInput_1 bits dropped" );
+    try {
+	Spx.Cntl1.write( 0x00000003 );		// InMsbFirst_1=1, KeepInput_1=1
+	Ring.clear();
+	Tx.config_Bits( 12 );
+	CHECK(  3,          Tx.run( 3 ) );
+	CHECK(  1,          Ring.pop( ss ) );
+	CHECKX( 0x00000fff, ss.Value );
+	Tx.config_Bits( 0 );
+	CHECK(  1,          Tx.run( 1 ) );
+	CHECK(  3,          Ring.count() );
+	Ring.pop( ss );
+	Ring.pop( ss );
+	Ring.pop( ss );
+	CHECKX( 0xabc00fff, ss.Value );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "run() full ring drops, does not stall" );
+    try {
+	rgUniSpiAdc_Ring	rx  ( Buf, 4 );
+	rgUniSpiAdc		tx  ( &Spx, &Stx, &rx );
+	CHECK(  4,          tx.run( 10 ) );
+	CHECK(  4,          tx.get_SampleCnt() );
+	CHECK(  6,          tx.get_DropCnt() );
+	CHECK(  4,          rx.count() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "stop() before run(), then cleared" );
+    try {
+	Ring.clear();
+	Tx.stop();
+	CHECK(  0,          Tx.run( 0 ) );
+	CHECK(  0,          Tx.get_PollCnt() );
+	CHECK(  2,          Tx.run( 2 ) );
+	CHECK(  2,          Ring.count() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
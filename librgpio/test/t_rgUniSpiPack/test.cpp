@@ -0,0 +1,300 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgUniSpiPack  Variable width Fifo word packer for rgUniSpi.
+//    10-19  Constructor, init_order(), init_from()
+//    20-29  Single word  pack_value(), unpack_value(), seg_bytes()
+//    30-39  Byte stream  pack(), unpack()
+//    40-49  Errors
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+#include "rgUniSpiPack.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgUniSpi		Spx  ( &Bx, 1 );
+rgUniSpiPack		Tx;			// test object
+
+uint8_t			src[]  = { 0x0a, 0xbc,  0x12, 0x34, 0x56,  0xff };
+uint32_t		wv[8];
+uint8_t			dst[16];
+
+rgUniSpi_Seg		sv[] = {
+    // Bits  Cs
+    {  12,   6 },
+    {  24,   5 },
+    {   1,   7 },
+};
+
+//--------------------------------------------------------------------------
+//## Constructor, init_order(), init_from()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor" );
+    try {
+	rgUniSpiPack	tx;
+	CHECK(  1,          tx.get_OutMsb() );
+	CHECK(  1,          tx.get_InMsb() );
+	CHECK(  24,         rgUniSpiPack::MaxBits );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "init_order()" );
+    try {
+	rgUniSpiPack	tx;
+	tx.init_order( 0, 1 );
+	CHECK(  0,          tx.get_OutMsb() );
+	CHECK(  1,          tx.get_InMsb() );
+	tx.init_order( 1, 0 );
+	CHECK(  1,          tx.get_OutMsb() );
+	CHECK(  0,          tx.get_InMsb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "init_from() object registers" );
+    try {
+	rgUniSpiPack	tx;
+	Spx.init_put_reset();
+	Spx.Cntl0.put_OutMsbFirst_1( 0 );
+	Spx.Cntl1.put_InMsbFirst_1(  1 );
+	tx.init_from( &Spx );
+	CHECK(  0,          tx.get_OutMsb() );
+	CHECK(  1,          tx.get_InMsb() );
+	Spx.Cntl0.put_OutMsbFirst_1( 1 );
+	Spx.Cntl1.put_InMsbFirst_1(  0 );
+	tx.init_from( &Spx );
+	CHECK(  1,          tx.get_OutMsb() );
+	CHECK(  0,          tx.get_InMsb() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Single word  pack_value(), unpack_value(), seg_bytes()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "seg_bytes()" );
+    try {
+	CHECK(  1,          rgUniSpiPack::seg_bytes(  1 ) );
+	CHECK(  1,          rgUniSpiPack::seg_bytes(  8 ) );
+	CHECK(  2,          rgUniSpiPack::seg_bytes(  9 ) );
+	CHECK(  2,          rgUniSpiPack::seg_bytes( 16 ) );
+	CHECK(  3,          rgUniSpiPack::seg_bytes( 17 ) );
+	CHECK(  3,          rgUniSpiPack::seg_bytes( 24 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "pack_value() MSB first, left justified at [23]" );
+    try {
+	Tx.init_order( 1, 1 );
+	CHECKX( 0xccabc000, Tx.pack_value( 0x0abc,   12, 6 ) );
+	CHECKX( 0xb8123456, Tx.pack_value( 0x123456, 24, 5 ) );
+	CHECKX( 0xe1800000, Tx.pack_value( 0xff,      1, 7 ) );
+	CHECKX( 0x08a50000, Tx.pack_value( 0xfa5,     8, 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "pack_value() LSB first, right justified at [0]" );
+    try {
+	Tx.init_order( 0, 0 );
+	CHECKX( 0xcc000abc, Tx.pack_value( 0x0abc,   12, 6 ) );
+	CHECKX( 0xb8123456, Tx.pack_value( 0x123456, 24, 5 ) );
+	CHECKX( 0xe1000001, Tx.pack_value( 0xff,      1, 7 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "unpack_value() MSB in, low bits, KeepInput_1 bits dropped" );
+    try {
+	Tx.init_order( 1, 1 );
+	CHECKX( 0x00000abc, Tx.unpack_value( 0xffff0abc, 12 ) );
+	CHECKX( 0x00123456, Tx.unpack_value( 0xff123456, 24 ) );
+	CHECKX( 0x00000001, Tx.unpack_value( 0xffffffff,  1 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "unpack_value() LSB in, high bits" );
+    try {
+	Tx.init_order( 1, 0 );
+	CHECKX( 0x00000abc, Tx.unpack_value( 0xabc00fff, 12 ) );
+	CHECKX( 0x00123456, Tx.unpack_value( 0x123456ff, 24 ) );
+	CHECKX( 0x00000001, Tx.unpack_value( 0x80000000,  1 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Byte stream  pack(), unpack()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "pack() MSB first" );
+    try {
+	Tx.init_order( 1, 1 );
+	wv[3] = 0xdeadbeef;
+	CHECK(  3,          Tx.pack( src, 6, sv, 3, wv ) );
+	CHECKX( 0xccabc000, wv[0] );
+	CHECKX( 0xb8123456, wv[1] );
+	CHECKX( 0xe1800000, wv[2] );
+	CHECKX( 0xdeadbeef, wv[3] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "pack() LSB first" );
+    try {
+	Tx.init_order( 0, 0 );
+	CHECK(  3,          Tx.pack( src, 6, sv, 3, wv ) );
+	CHECKX( 0xcc000abc, wv[0] );
+	CHECKX( 0xb8123456, wv[1] );
+	CHECKX( 0xe1000001, wv[2] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "unpack() MSB in" );
+    try {
+	Tx.init_order( 1, 1 );
+	wv[0] = 0xffff0abc;
+	wv[1] = 0xff123456;
+	wv[2] = 0xfffffffe;
+	dst[6] = 0xee;
+	CHECK(  6,          Tx.unpack( wv, sv, 3, dst ) );
+	CHECKX( 0x0a,       dst[0] );
+	CHECKX( 0xbc,       dst[1] );
+	CHECKX( 0x12,       dst[2] );
+	CHECKX( 0x34,       dst[3] );
+	CHECKX( 0x56,       dst[4] );
+	CHECKX( 0x00,       dst[5] );
+	CHECKX( 0xee,       dst[6] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "unpack() LSB in" );
+    try {
+	Tx.init_order( 0, 0 );
+	wv[0] = 0xabc00fff;
+	wv[1] = 0x123456ff;
+	wv[2] = 0x80000000;
+	CHECK(  6,          Tx.unpack( wv, sv, 3, dst ) );
+	CHECKX( 0x0a,       dst[0] );
+	CHECKX( 0xbc,       dst[1] );
+	CHECKX( 0x12,       dst[2] );
+	CHECKX( 0x56,       dst[4] );
+	CHECKX( 0x01,       dst[5] );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Errors
+//--------------------------------------------------------------------------
+
+  CASE( "40", "pack() Bits zero" );
+    try {
+	rgUniSpi_Seg	xv[] = { { 8, 0 }, { 0, 0 } };
+	Tx.pack( src, 6, xv, 2, wv );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiPack::pack():  Bits requires {1..24} in sv[1]:  0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "unpack() Bits exceeds 24" );
+    try {
+	rgUniSpi_Seg	xv[] = { { 25, 0 } };
+	Tx.unpack( wv, xv, 1, dst );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiPack::unpack():  Bits requires {1..24} in sv[0]:  25",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "pack() Cs exceeds 7" );
+    try {
+	rgUniSpi_Seg	xv[] = { { 8, 8 } };
+	Tx.pack( src, 6, xv, 1, wv );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiPack::pack():  Cs exceeds 7 in sv[0]:  8",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "pack() src too short" );
+    try {
+	Tx.pack( src, 5, sv, 3, wv );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiPack::pack():  src requires 6 bytes:  5",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
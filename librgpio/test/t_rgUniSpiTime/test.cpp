@@ -0,0 +1,262 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgUniSpiTime  Transfer time model for rgUniSpi.
+//    10-19  Constructor, config_CoreHz(), config_WordOverheadNs()
+//    20-29  sclk_ps(), predict_ns()
+//    30-39  max_words()
+//    40-49  calibrate()
+//
+// Fake memory System Timer does not advance, so calibrate() measures zero.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+#include "rgSysTimer.h"
+#include "rgUniSpiTime.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgUniSpi		Spx  ( &Bx, 1 );
+rgSysTimer		Stx  ( &Bx );
+
+rgUniSpiTime		Tx   ( &Spx );		// test object
+
+//--------------------------------------------------------------------------
+//## Constructor, config_CoreHz(), config_WordOverheadNs()
+//--------------------------------------------------------------------------
+
+  CASE( "10a", "constructor RPi3" );
+    try {
+	CHECK(  250000000,  Tx.config_CoreHz() );
+	CHECK(  0,          Tx.config_WordOverheadNs() );
+	CHECK(  0,          Tx.get_MeasureNs() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "10b", "constructor RPi4" );
+    try {
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );
+	rgUniSpiTime	tx  ( &Spx );
+	CHECK(  500000000,  tx.config_CoreHz() );
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_CoreHz(), config_WordOverheadNs()" );
+    try {
+	rgUniSpiTime	tx  ( &Spx );
+	tx.config_CoreHz( 400000000 );
+	CHECK(  400000000,  tx.config_CoreHz() );
+	tx.config_WordOverheadNs( 350 );
+	CHECK(  350,        tx.config_WordOverheadNs() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "config_CoreHz() zero" );
+    try {
+	Tx.config_CoreHz( 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiTime::config_CoreHz():  require nonzero", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## sclk_ps(), predict_ns()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "sclk_ps()" );
+    try {
+	Spx.init_put_reset();
+	CHECK(  8000,       Tx.sclk_ps() );		// 125 MHz
+	Spx.Cntl0.put_Speed_12( 124 );
+	CHECK(  1000000,    Tx.sclk_ps() );		// 1 MHz
+	Spx.Cntl0.put_Speed_12( 4095 );
+	CHECK(  32768000,   Tx.sclk_ps() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "predict_ns() Fifo frame per word" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_Speed_12( 124 );		// 1 us
+	Spx.Cntl0.put_ShiftLength_6( 8 );
+	CHECK(  90000,      Tx.predict_ns( 10, 0 ) );
+	CHECK(  0,          Tx.predict_ns(  0, 0 ) );
+	Spx.Cntl1.put_CsHighTime_3( 3 );
+	CHECK(  120000,     Tx.predict_ns( 10, 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "predict_ns() FifoH frame, overhead" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_Speed_12( 124 );		// 1 us
+	Spx.Cntl0.put_ShiftLength_6( 8 );
+	Spx.Cntl1.put_CsHighTime_3( 3 );
+	CHECK(  84000,      Tx.predict_ns( 10, 1 ) );
+	Tx.config_WordOverheadNs( 500 );
+	CHECK(  89000,      Tx.predict_ns( 10, 1 ) );
+	CHECK(  125000,     Tx.predict_ns( 10, 0 ) );
+	Tx.config_WordOverheadNs( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "predict_ns() rounds up" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_ShiftLength_6( 1 );
+	Tx.config_CoreHz( 300000000 );		// 6666 ps SCLK
+	CHECK(  6666,       Tx.sclk_ps() );
+	CHECK(  14,         Tx.predict_ns( 1, 0 ) );	// 13332 ps
+	Tx.config_CoreHz( 250000000 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "predict_ns() ShiftLength_6 zero" );
+    try {
+	Spx.init_put_reset();
+	Tx.predict_ns( 10, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiTime::predict_ns():  ShiftLength_6 requires {1..32}:  0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## max_words()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "max_words() matches predict_ns()" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_Speed_12( 124 );		// 1 us
+	Spx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.config_WordOverheadNs( 500 );
+	CHECK(  10,         Tx.max_words( 95000, 0 ) );
+	CHECK(  9,          Tx.max_words( 94999, 0 ) );
+	CHECK(  95000,      Tx.predict_ns( 10, 0 ) );
+	CHECK(  11,         Tx.max_words( 95000, 1 ) );	// 1 + 11 * 8.5
+	CHECK(  94500,      Tx.predict_ns( 11, 1 ) );
+	Tx.config_WordOverheadNs( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "max_words() budget too small" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_Speed_12( 124 );		// 1 us
+	Spx.Cntl0.put_ShiftLength_6( 8 );
+	CHECK(  0,          Tx.max_words( 0,    0 ) );
+	CHECK(  0,          Tx.max_words( 8999, 0 ) );
+	CHECK(  1,          Tx.max_words( 9000, 0 ) );
+	CHECK(  0,          Tx.max_words( 8999, 1 ) );
+	CHECK(  1,          Tx.max_words( 9000, 1 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "max_words() ShiftLength_6 exceeds 32" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_ShiftLength_6( 33 );
+	Tx.max_words( 1000, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiTime::max_words():  ShiftLength_6 requires {1..32}:  33",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## calibrate()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "calibrate() fake timer measures zero" );
+    try {
+	Spx.init_put_reset();
+	Spx.Cntl0.put_Speed_12( 124 );
+	Spx.Cntl0.put_ShiftLength_6( 8 );
+	Spx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.config_WordOverheadNs( 777 );
+	CHECK(  0,          Tx.calibrate( &Stx, 100 ) );
+	CHECK(  0,          Tx.config_WordOverheadNs() );
+	CHECK(  0,          Tx.get_MeasureNs() );
+	CHECKX( 0x00000000, Spx.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "calibrate() zero words" );
+    try {
+	Tx.calibrate( &Stx, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpiTime::calibrate():  require nword > 0", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
@@ -0,0 +1,513 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgUniSpi  Universal SPI Master class - streaming transfer engine.
+//    10-19  Constructor state, config_FillByte()
+//    20-29  Word packing  OutMsbFirst_1, InMsbFirst_1, KeepInput_1
+//    30-39  VariableWidth_1, Tx-only, Rx-only
+//    40-49  Errors, flow control  start_xfer(), service_xfer()
+//    50-59  Whole words  xfer_words()
+//    60-69  Two units  service_pair()
+//    70-79  Scatter/gather  transferv()
+//
+// Fake memory has a single Fifo word, so reading it returns the last word
+// written to Fifo (not FifoH), or the preset value.  Presetting Stat
+// RxLevel_3 selects how many words are read per pass.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgUniSpi.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2837 );	// RPi3
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x7e000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgUniSpi		Tx   ( &Bx, 1 );	// test object
+
+uint8_t			txbuf[256];
+uint8_t			rxbuf[256];
+
+for ( int i=0;  i<256;  i++ )
+{
+    txbuf[i] = i ^ 0x5a;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor state, config_FillByte()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor transfer state" );
+    try {
+	rgUniSpi	tx  ( &Bx, 2 );
+	CHECK(  1,          tx.is_xfer_done() );
+	CHECK(  0,          tx.get_XferTxCnt() );
+	CHECK(  0,          tx.get_XferRxCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+	CHECK(  1,          tx.get_WordBytes() );
+	CHECKX( 0x00,       tx.config_FillByte() );
+	CHECK(  4,          rgUniSpi::FifoDepth );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_FillByte()" );
+    try {
+	Tx.config_FillByte( 0xff );
+	CHECKX( 0xff,       Tx.config_FillByte() );
+	Tx.config_FillByte( 0x00 );
+	CHECKX( 0x00,       Tx.config_FillByte() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Word packing  OutMsbFirst_1, InMsbFirst_1, KeepInput_1
+//--------------------------------------------------------------------------
+
+  CASE( "20", "transfer() 16-bit, MSB first" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 16 );
+	Tx.Cntl0.put_OutMsbFirst_1( 1 );
+	Tx.Cntl1.put_InMsbFirst_1(  1 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.Fifo.write( 0x12345678 );		// Rx data
+	for ( int i=0;  i<20;  i++ )  { rxbuf[i] = 0xee; }
+	CHECK(  16,         Tx.transfer( txbuf, rxbuf, 16 ) );
+	CHECK(  2,          Tx.get_WordBytes() );
+	CHECKX( 0x56570000, Tx.FifoH.read() );	// word 6
+	CHECKX( 0x54550000, Tx.Fifo.read() );	// word 7, last
+	CHECKX( 0x56,       rxbuf[0] );
+	CHECKX( 0x78,       rxbuf[1] );
+	CHECKX( 0x56,       rxbuf[6] );
+	CHECKX( 0x78,       rxbuf[7] );
+	CHECKX( 0x00,       rxbuf[8] );
+	CHECKX( 0x00,       rxbuf[15] );
+	CHECKX( 0xee,       rxbuf[16] );
+	CHECK(  16,         Tx.get_XferTxCnt() );
+	CHECK(  16,         Tx.get_XferRxCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "transfer() 8-bit, LSB first" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.Fifo.write( 0xab123456 );		// Rx data in [31:24]
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0xee; }
+	CHECK(  5,          Tx.transfer( txbuf, rxbuf, 5 ) );
+	CHECK(  1,          Tx.get_WordBytes() );
+	CHECKX( 0x00000059, Tx.FifoH.read() );
+	CHECKX( 0x0000005e, Tx.Fifo.read() );
+	CHECKX( 0xab,       rxbuf[0] );
+	CHECKX( 0xab,       rxbuf[3] );
+	CHECKX( 0x00,       rxbuf[4] );
+	CHECKX( 0xee,       rxbuf[5] );
+	CHECK(  3,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "transfer() 24-bit, KeepInput_1 high bits masked" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 24 );
+	Tx.Cntl1.put_InMsbFirst_1(  1 );
+	Tx.Cntl1.put_KeepInput_1(   1 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.Fifo.write( 0xffa1b2c3 );		// old bits in [31:24]
+	for ( int i=0;  i<16;  i++ )  { rxbuf[i] = 0xee; }
+	CHECK(  15,         Tx.transfer( txbuf, rxbuf, 15 ) );
+	CHECK(  3,          Tx.get_WordBytes() );
+	CHECKX( 0x00515053, Tx.FifoH.read() );	// word 3
+	CHECKX( 0x00545756, Tx.Fifo.read() );	// word 4, last
+	CHECKX( 0xa1,       rxbuf[0] );
+	CHECKX( 0xb2,       rxbuf[1] );
+	CHECKX( 0xc3,       rxbuf[2] );
+	CHECKX( 0xc3,       rxbuf[11] );
+	CHECKX( 0x54,       rxbuf[12] );
+	CHECKX( 0x57,       rxbuf[13] );
+	CHECKX( 0x56,       rxbuf[14] );
+	CHECKX( 0xee,       rxbuf[15] );
+	CHECK(  3,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "transfer() 32-bit, MSB out, LSB in" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 32 );
+	Tx.Cntl0.put_OutMsbFirst_1( 1 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0xee; }
+	CHECK(  4,          Tx.transfer( txbuf, rxbuf, 4 ) );
+	CHECKX( 0x5a5b5859, Tx.Fifo.read() );
+	CHECKX( 0x59,       rxbuf[0] );
+	CHECKX( 0x58,       rxbuf[1] );
+	CHECKX( 0x5b,       rxbuf[2] );
+	CHECKX( 0x5a,       rxbuf[3] );
+	CHECKX( 0xee,       rxbuf[4] );
+	CHECK(  2,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## VariableWidth_1, Tx-only, Rx-only
+//--------------------------------------------------------------------------
+
+  CASE( "30", "transfer() VariableWidth_1, VariableCs_1" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_VariableWidth_1( 1 );
+	Tx.Cntl0.put_VariableCs_1(    1 );
+	Tx.Cntl0.put_ChipSelects_3(   5 );
+	Tx.Cntl0.put_OutMsbFirst_1(   1 );
+	Tx.Cntl1.put_InMsbFirst_1(    1 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	for ( int i=0;  i<8;  i++ )  { rxbuf[i] = 0xee; }
+	CHECK(  7,          Tx.transfer( txbuf, rxbuf, 7 ) );
+	CHECK(  3,          Tx.get_WordBytes() );
+	CHECKX( 0xb8595e5f, Tx.FifoH.read() );	// word 1, 24 bits
+	CHECKX( 0xa85c0000, Tx.Fifo.read() );	// word 2,  8 bits
+	CHECKX( 0x5c,       rxbuf[0] );
+	CHECKX( 0x00,       rxbuf[1] );
+	CHECKX( 0x00,       rxbuf[2] );
+	CHECKX( 0x5c,       rxbuf[3] );
+	CHECKX( 0x00,       rxbuf[6] );
+	CHECKX( 0xee,       rxbuf[7] );
+	CHECK(  2,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "transfer() VariableWidth_1, LSB first" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_VariableWidth_1( 1 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	CHECK(  5,          Tx.transfer( txbuf, NULL, 5 ) );
+	CHECKX( 0x18585b5a, Tx.FifoH.read() );	// word 0, 24 bits
+	CHECKX( 0x10005e59, Tx.Fifo.read() );	// word 1, 16 bits
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "transfer() Rx-only sends FillByte" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 16 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.config_FillByte( 0xa5 );
+	CHECK(  4,          Tx.transfer( NULL, rxbuf, 4 ) );
+	CHECKX( 0x0000a5a5, Tx.FifoH.read() );
+	CHECKX( 0x0000a5a5, Tx.Fifo.read() );
+	Tx.config_FillByte( 0x00 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "transfer() RxLevel_3=0 with RxEmpty_1=0, one word per pass" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00000000 );
+	CHECK(  3,          Tx.transfer( txbuf, rxbuf, 3 ) );
+	CHECK(  4,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Errors, flow control  start_xfer(), service_xfer()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "start_xfer() ShiftLength_6 not whole bytes" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 12 );
+	Tx.push_regs();
+	Tx.start_xfer( txbuf, rxbuf, 3 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpi::start_xfer():  ShiftLength_6 requires {8,16,24,32}:  12",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "start_xfer() ShiftLength_6 zero" );
+    try {
+	Tx.init_put_reset();
+	Tx.push_regs();
+	Tx.start_xfer( txbuf, rxbuf, 3 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpi::start_xfer():  ShiftLength_6 requires {8,16,24,32}:  0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "start_xfer() n not multiple of word" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 16 );
+	Tx.push_regs();
+	Tx.start_xfer( txbuf, rxbuf, 5 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpi::start_xfer():  n not a multiple of 2 bytes:  5",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "transfer() zero length" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.push_regs();
+	CHECK(  0,          Tx.transfer( txbuf, rxbuf, 0 ) );
+	CHECK(  1,          Tx.is_xfer_done() );
+	CHECK(  0,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "44", "service_xfer() Tx limited by FifoDepth" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.start_xfer( txbuf, rxbuf, 10 );
+	CHECK(  0,          Tx.is_xfer_done() );
+	CHECK(  0,          Tx.service_xfer() );
+	CHECK(  4,          Tx.get_XferTxCnt() );
+	CHECK(  0,          Tx.get_XferRxCnt() );
+	CHECK(  0,          Tx.service_xfer() );
+	CHECK(  8,          Tx.get_XferTxCnt() );
+	CHECK(  4,          Tx.get_XferRxCnt() );
+	CHECK(  0,          Tx.service_xfer() );
+	CHECK(  10,         Tx.get_XferTxCnt() );
+	CHECK(  8,          Tx.get_XferRxCnt() );
+	CHECK(  1,          Tx.service_xfer() );
+	CHECK(  10,         Tx.get_XferRxCnt() );
+	CHECK(  1,          Tx.service_xfer() );
+	CHECK(  4,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Whole words  xfer_words()
+//--------------------------------------------------------------------------
+
+uint32_t		txw[8] = { 0xb8000001, 0xb8000002, 0xb8000003,
+				   0xb8000004, 0xb8000005, 0xb8000006 };
+uint32_t		rxw[8];
+
+  CASE( "50", "xfer_words() hold, FifoH all but last" );
+    try {
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.Fifo.write(  0x12345678 );		// Rx data
+	Tx.FifoH.write( 0x00000000 );
+	for ( int i=0;  i<8;  i++ )  { rxw[i] = 0; }
+	CHECK(  6,          Tx.xfer_words( txw, rxw, 6, 1 ) );
+	CHECKX( 0xb8000005, Tx.FifoH.read() );
+	CHECKX( 0xb8000006, Tx.Fifo.read() );
+	CHECKX( 0x12345678, rxw[0] );
+	CHECKX( 0x12345678, rxw[3] );
+	CHECKX( 0xb8000006, rxw[4] );
+	CHECKX( 0xb8000006, rxw[5] );
+	CHECKX( 0x00000000, rxw[6] );
+	CHECK(  3,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "xfer_words() no hold, Fifo every word" );
+    try {
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.FifoH.write( 0x00000000 );
+	CHECK(  3,          Tx.xfer_words( txw, NULL, 3, 0 ) );
+	CHECKX( 0x00000000, Tx.FifoH.read() );
+	CHECKX( 0xb8000003, Tx.Fifo.read() );
+	CHECK(  2,          Tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Two units  service_pair()
+//--------------------------------------------------------------------------
+
+rgUniSpi		Tx2  ( &Bx, 2 );
+
+  CASE( "60", "service_pair() Spi1, Spi2" );
+    try {
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx2.init_put_reset();
+	Tx2.Cntl0.put_ShiftLength_6( 16 );
+	Tx2.push_regs();
+	Tx2.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.start_xfer(  txbuf,      rxbuf,       6 );
+	Tx2.start_xfer( txbuf + 16, rxbuf + 16, 12 );
+	rgUniSpi::service_pair( &Tx, &Tx2 );
+	CHECK(  1,          Tx.is_xfer_done() );
+	CHECK(  1,          Tx2.is_xfer_done() );
+	CHECK(  6,          Tx.get_XferRxCnt() );
+	CHECK(  12,         Tx2.get_XferRxCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+	CHECK(  3,          Tx2.get_PollCnt() );
+	CHECKX( 0x0000005f, Tx.Fifo.read() );
+	CHECKX( 0x00004140, Tx2.Fifo.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "61", "service_pair() same unit" );
+    try {
+	rgUniSpi	tx  ( &Bx, 1 );
+	rgUniSpi::service_pair( &Tx, &tx );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpi::service_pair():  require different spi units:  1",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## Scatter/gather  transferv()
+//--------------------------------------------------------------------------
+
+  CASE( "70", "transferv() 16-bit words span segments" );
+    try {
+	uint8_t		hdr[1]  = { 0xab };
+	uint8_t		rhead[1];
+	struct iovec	txv[2]  = { {hdr, 1}, {txbuf, 3} };
+	struct iovec	rxv[2]  = { {rhead, 1}, {rxbuf, 3} };
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 16 );
+	Tx.Cntl0.put_OutMsbFirst_1( 1 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	CHECK(  4,          Tx.transferv( txv, 2, rxv, 2 ) );
+	CHECKX( 0xab5a0000, Tx.FifoH.read() );	// word 0
+	CHECKX( 0x5b580000, Tx.Fifo.read() );	// word 1, last
+	CHECKX( 0x58,       rhead[0] );		// LSB first from Fifo
+	CHECKX( 0x5b,       rxbuf[0] );
+	CHECKX( 0x58,       rxbuf[1] );
+	CHECKX( 0x5b,       rxbuf[2] );
+	CHECK(  4,          Tx.get_XferTxCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "71", "transferv() Rx-only, NULL Tx list" );
+    try {
+	struct iovec	rxv[1]  = { {rxbuf, 2} };
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 8 );
+	Tx.push_regs();
+	Tx.Stat.write( 0x00400000 );		// RxLevel_3=4
+	Tx.config_FillByte( 0xc3 );
+	CHECK(  2,          Tx.transferv( NULL, 0, rxv, 1 ) );
+	CHECKX( 0x000000c3, Tx.Fifo.read() );
+	Tx.config_FillByte( 0x00 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "72", "start_xferv() length not multiple of word" );
+    try {
+	struct iovec	txv[2]  = { {txbuf, 2}, {txbuf, 1} };
+	Tx.init_put_reset();
+	Tx.Cntl0.put_ShiftLength_6( 16 );
+	Tx.push_regs();
+	Tx.start_xferv( txv, 2, NULL, 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgUniSpi::start_xferv():  n not a multiple of 2 bytes:  3",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
@@ -6,7 +6,7 @@
 //    30-39  Hardware read(), write():  _peek _flip _set _clr
 //    40-49  Object grab(), push():  _peek _flip _set _clr
 //    41     Object get(), put()
-//    50-59  .
+//    50-59  Shadow cache:  refresh(), read_cntl(), write_cntl(), modify_cntl()
 //    60-78  IoCntl(3) Field Accessors  get_(), put_()
 //    80-98  IoStat(3) Field Accessors  get_(), put_()
 // Test only Bank0, as the others are undocumented.
@@ -458,6 +458,117 @@ rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
 	FAIL( "unexpected exception" );
     }
 
+//--------------------------------------------------------------------------
+//## Shadow cache:  refresh(), read_cntl(), write_cntl(), modify_cntl()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "shadow mode default off" );
+    try {
+	rgsIoCon	tx  ( &Bx );
+	CHECK(                0, tx.config_ShadowMode() );
+	CHECK(                0, tx.get_StaleCount() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51a", "read_cntl() hardware mode" );
+    try {
+	Tx.IoCntl(3).write(     0x00000085 );
+	CHECKX(                 0x00000085, Tx.read_cntl(3) );
+	Tx.IoCntl(3).write(     0x00000005 );
+	CHECKX(                 0x00000005, Tx.read_cntl(3) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51b", "read_cntl() shadow mode ignores hardware change" );
+    try {
+	Tx.config_ShadowMode( 1 );
+	CHECK(                  1, Tx.config_ShadowMode() );
+	CHECKX(                 0x00000005, Tx.read_cntl(3) );
+	Tx.IoCntl(3).write(     0x00000001 );
+	CHECKX(                 0x00000005, Tx.read_cntl(3) );
+	CHECK(                  0, Tx.get_StaleCount() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "refresh() counts stale registers" );
+    try {
+	Tx.IoCntl(27).write(    0x00000002 );
+	CHECK(                  2, Tx.refresh() );
+	CHECK(                  2, Tx.get_StaleCount() );
+	CHECKX(                 0x00000001, Tx.read_cntl(3) );
+	CHECKX(                 0x00000002, Tx.read_cntl(27) );
+	CHECK(                  0, Tx.refresh() );
+	Tx.clear_StaleCount();
+	CHECK(                  0, Tx.get_StaleCount() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "53", "refresh() ignores Stat registers" );
+    try {
+	Tx.IoStat(3).write(     0x12345678 );
+	CHECK(                  0, Tx.refresh() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "54", "write_cntl() writes through" );
+    try {
+	Tx.write_cntl(    3,    0x00000085 );
+	CHECKX(                 0x00000085, Tx.IoCntl(3).read() );
+	CHECKX(                 0x00000085, Tx.read_cntl(3) );
+	CHECK(                  0, Tx.refresh() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "55", "modify_cntl() atomic set/clr, no read" );
+    try {
+	Tx.IoCntl(3).write_set( 0xffffffff );
+	Tx.IoCntl(3).write_clr( 0xffffffff );
+	Tx.modify_cntl(   3,    0x0000001f, 0x00000007 );
+	CHECKX(                 0x00000007, Tx.IoCntl(3).read_set() );
+	CHECKX(                 0x00000018, Tx.IoCntl(3).read_clr() );
+	CHECKX(                 0x00000087, Tx.read_cntl(3) );
+	CHECKX(                 0x00000085, Tx.IoCntl(3).read() );
+	// Fake memory does not apply set/clr to the normal address.
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "56", "read_cntl() bad index" );
+    try {
+	Tx.read_cntl( 28 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIo_Cntl::IoCntl():  bit index out-of-range:  28",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "57", "disable shadow mode" );
+    try {
+	Tx.config_ShadowMode( 0 );
+	CHECKX(                 0x00000085, Tx.read_cntl(3) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
 //--------------------------------------------------------------------------
 //## IoCntl(3) Field Accessors  get_(), put_()
 //--------------------------------------------------------------------------
@@ -0,0 +1,276 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgsIoCon  Input filter/debounce helper for RPi5
+//    10-19  config_FilterClk()
+//    20-29  calc_FilterM_7(), calc_filter_ns()
+//    30-39  calc_filter_pass() model
+//    40-49  apply_filter(), predict_filter_pass()
+// Test only Bank0, as the others are undocumented.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgsIoCon.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x40000000, Bx.config_DocBase() );
+	CHECKX( 0x00004000, Bx.config_BlockSize() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgsIoCon		Tx   ( &Bx );		// test object, Bank0
+
+//--------------------------------------------------------------------------
+//## config_FilterClk()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "config_FilterClk() default clk_sys" );
+    try {
+	CHECK(   200000000, Tx.config_FilterClk() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "config_FilterClk() set" );
+    try {
+	rgsIoCon	tx  ( &Bx );
+	tx.config_FilterClk( 50000000 );
+	CHECK(    50000000, tx.config_FilterClk() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "config_FilterClk() zero" );
+    try {
+	rgsIoCon	tx  ( &Bx );
+	tx.config_FilterClk( 0 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::config_FilterClk():  require hz > 0",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## calc_FilterM_7(), calc_filter_ns()
+//--------------------------------------------------------------------------
+// Default 200 MHz is 5 ns per tick.
+
+  CASE( "20", "calc_FilterM_7() exact ticks" );
+    try {
+	CHECK(           0, Tx.calc_FilterM_7(   0 ) );
+	CHECK(           4, Tx.calc_FilterM_7(  20 ) );
+	CHECK(         127, Tx.calc_FilterM_7( 635 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "calc_FilterM_7() rounds up" );
+    try {
+	CHECK(           1, Tx.calc_FilterM_7(   1 ) );
+	CHECK(           5, Tx.calc_FilterM_7(  21 ) );
+	CHECK(         127, Tx.calc_FilterM_7( 631 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "calc_FilterM_7() too long" );
+    try {
+	Tx.calc_FilterM_7( 636 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::calc_FilterM_7():  debounce exceeds 635 ns:  636",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "calc_FilterM_7() no overflow" );
+    try {
+	Tx.calc_FilterM_7( 0xffffffff );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::calc_FilterM_7():  debounce exceeds 635 ns:  4294967295",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "calc_filter_ns()" );
+    try {
+	CHECK(           0, Tx.calc_filter_ns(   0 ) );
+	CHECK(          20, Tx.calc_filter_ns(   4 ) );
+	CHECK(         635, Tx.calc_filter_ns( 127 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "slow filter clock" );
+    try {
+	rgsIoCon	tx  ( &Bx );
+	tx.config_FilterClk( 1000000 );		// 1 us tick
+	CHECK(          10, tx.calc_FilterM_7( 10000 ) );
+	CHECK(      127000, tx.calc_filter_ns(   127 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## calc_filter_pass() model
+//--------------------------------------------------------------------------
+
+  CASE( "30", "M=0 passes everything" );
+    try {
+	CHECK(           1, Tx.calc_filter_pass(   0,   0 ) );
+	CHECK(           1, Tx.calc_filter_pass(   0,   1 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "M=4 boundary" );
+    try {
+	CHECK(           0, Tx.calc_filter_pass(   4,  19 ) );
+	CHECK(           1, Tx.calc_filter_pass(   4,  20 ) );
+	CHECK(           1, Tx.calc_filter_pass(   4, 100 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "calc_FilterM_7() result rejects shorter pulse" );
+    try {
+	uint32_t	mm = Tx.calc_FilterM_7( 500 );
+	CHECK(         100, mm );
+	CHECK(           0, Tx.calc_filter_pass( mm, 499 ) );
+	CHECK(           1, Tx.calc_filter_pass( mm, 500 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## apply_filter(), predict_filter_pass()
+//--------------------------------------------------------------------------
+// Fake memory does not apply set/clr to the normal address, so use
+// shadow mode to see the modified value.
+
+  CASE( "40", "condition memory" );
+    try {
+	for ( int ii=0;  ii<=27;  ii++ ) {
+	    Tx.IoCntl(ii).write(     0x00000085 );	// M=4, FuncSel=5
+	}
+	Tx.IoCntl(3).write_set(      0x00000000 );
+	Tx.IoCntl(3).write_clr(      0x00000000 );
+	Tx.config_ShadowMode( 1 );
+	CHECKX(                      0x00000085, Tx.read_cntl(3) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "apply_filter() one pin" );
+    try {
+	CHECK(                       100, Tx.apply_filter( 0x00000008, 500 ) );
+	CHECKX(                      0x00000c80, Tx.IoCntl(3).read_set() );
+	CHECKX(                      0x00000360, Tx.IoCntl(3).read_clr() );
+	CHECKX(                      0x00000c85, Tx.read_cntl(3) );
+	CHECKX(                      0x00000085, Tx.read_cntl(2) );
+	CHECKX(                      0x00000085, Tx.read_cntl(4) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "predict_filter_pass()" );
+    try {
+	CHECK(                       0, Tx.predict_filter_pass( 3, 499 ) );
+	CHECK(                       1, Tx.predict_filter_pass( 3, 500 ) );
+	CHECK(                       0, Tx.predict_filter_pass( 2,  19 ) );
+	CHECK(                       1, Tx.predict_filter_pass( 2,  20 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "apply_filter() many pins" );
+    try {
+	CHECK(                       0, Tx.apply_filter( 0x08000001, 0 ) );
+	CHECKX(                      0x00000005, Tx.read_cntl(0)  );
+	CHECKX(                      0x00000005, Tx.read_cntl(27) );
+	CHECKX(                      0x00000c85, Tx.read_cntl(3)  );
+	CHECK(                       1, Tx.predict_filter_pass( 0, 0 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "44", "apply_filter() bad mask" );
+    try {
+	Tx.apply_filter( 0x10000000, 20 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::apply_filter():  mask exceeds MaxBit:  0x10000000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "45", "apply_filter() too long, no change" );
+    try {
+	Tx.apply_filter( 0x00000001, 1000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECKX(                      0x00000005, Tx.read_cntl(0)  );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
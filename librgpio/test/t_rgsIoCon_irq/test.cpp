@@ -0,0 +1,271 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgsIoCon  Interrupt mask and pending scan for RPi5
+//    10-19  apply_imask() hardware mode
+//    20-29  apply_imask() shadow mode, get_ArmedMask()
+//    30-39  read_irq_pending()
+//    40-49  ack_edge()
+//    50-59  mask range errors
+// Test only Bank0, as the others are undocumented.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgsIoCon.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x40000000, Bx.config_DocBase() );
+	CHECKX( 0x00004000, Bx.config_BlockSize() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgsIoCon		Tx   ( &Bx );		// test object, Bank0
+
+//--------------------------------------------------------------------------
+//## apply_imask() hardware mode
+//--------------------------------------------------------------------------
+// Fake memory does not apply set/clr to the normal address, so a sentinel
+// left in the aliases shows apply_imask() did not use them.
+
+  CASE( "10", "condition memory" );
+    try {
+	for ( int ii=0;  ii<=27;  ii++ ) {
+	    Tx.IoCntl(ii).write(     0x00000085 );
+	    Tx.IoStat(ii).write(     0x00000000 );
+	}
+	Tx.IoCntl(5).write(          0x00200085 );	// ImaskRise_1
+	CHECK(                       0, Tx.get_ArmedMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "apply_imask() writes only changed pins" );
+    try {
+	CHECK(                       2, Tx.apply_imask( 0x00000070, 0x02 ) );
+	CHECKX(                      0x00200085, Tx.IoCntl(4).read() );
+	CHECKX(                      0x00200085, Tx.IoCntl(5).read() );
+	CHECKX(                      0x00200085, Tx.IoCntl(6).read() );
+	CHECKX(                      0x00000070, Tx.get_ArmedMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "apply_imask() disarm" );
+    try {
+	CHECK(                       1, Tx.apply_imask( 0x00000020, 0x00 ) );
+	CHECKX(                      0x00000085, Tx.IoCntl(5).read() );
+	CHECKX(                      0x00000050, Tx.get_ArmedMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "apply_imask() Fall to Rise, one write, no set/clr" );
+    try {
+	Tx.IoCntl(7).write(          0x00100085 );	// ImaskFall_1
+	Tx.IoCntl(7).write_set(      0xdeadbeef );
+	Tx.IoCntl(7).write_clr(      0xdeadbeef );
+	CHECK(                       1, Tx.apply_imask( 0x00000080, 0x02 ) );
+	CHECKX(                      0x00200085, Tx.IoCntl(7).read() );
+	CHECKX(                      0xdeadbeef, Tx.IoCntl(7).read_set() );
+	CHECKX(                      0xdeadbeef, Tx.IoCntl(7).read_clr() );
+	CHECK(                       1, Tx.apply_imask( 0x00000080, 0x00 ) );
+	CHECKX(                      0x00000085, Tx.IoCntl(7).read() );
+	CHECKX(                      0x00000050, Tx.get_ArmedMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## apply_imask() shadow mode, get_ArmedMask()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "shadow load sets ArmedMask" );
+    try {
+	Tx.config_ShadowMode( 1 );
+	CHECKX(                      0x00000050, Tx.get_ArmedMask() );
+	CHECKX(                      0x00000085, Tx.read_cntl(5) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "apply_imask() shadow mode" );
+    try {
+	CHECK(                       4, Tx.apply_imask( 0x08000031, 0x82 ) );
+	CHECKX(                      0x08200085, Tx.read_cntl(0)  );
+	CHECKX(                      0x08200085, Tx.read_cntl(4)  );
+	CHECKX(                      0x08200085, Tx.read_cntl(5)  );
+	CHECKX(                      0x00200085, Tx.read_cntl(6)  );
+	CHECKX(                      0x08200085, Tx.read_cntl(27) );
+	CHECKX(                      0x08200085, Tx.IoCntl(27).read() );
+	CHECKX(                      0x08000071, Tx.get_ArmedMask() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "apply_imask() no change, no writes" );
+    try {
+	CHECK(                       0, Tx.apply_imask( 0x08000031, 0x82 ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "refresh() recomputes ArmedMask" );
+    try {
+	Tx.IoCntl(1).write(          0x00100085 );
+	CHECK(                       1, Tx.refresh() );
+	CHECKX(                      0x08000073, Tx.get_ArmedMask() );
+	Tx.config_ShadowMode( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## read_irq_pending()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "no pending" );
+    try {
+	CHECKX(                      0x00000000, Tx.read_irq_pending( 0x0fffffff ) );
+	CHECKX(                      0x00000000, Tx.read_irq_pending() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "pending IrqToProc_1 only" );
+    try {
+	Tx.IoStat(1).write(          0x20000000 );
+	Tx.IoStat(3).write(          0x20000000 );
+	Tx.IoStat(27).write(         0x20000000 );
+	Tx.IoStat(4).write(          0xdfffffff );
+	CHECKX(                      0x0800000a, Tx.read_irq_pending( 0x0fffffff ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "pending limited to mask" );
+    try {
+	CHECKX(                      0x00000008, Tx.read_irq_pending( 0x0000000c ) );
+	CHECKX(                      0x08000002, Tx.read_irq_pending() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## ack_edge()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "ack_edge() pulses EdgeReset_1" );
+    try {
+	Tx.IoCntl(3).write_set(      0x00000000 );
+	Tx.IoCntl(3).write_clr(      0x00000000 );
+	Tx.IoCntl(2).write_set(      0x00000000 );
+	Tx.IoCntl(2).write_clr(      0x00000000 );
+	Tx.ack_edge(                 0x0000000a );
+	CHECKX(                      0x10000000, Tx.IoCntl(3).read_set() );
+	CHECKX(                      0x10000000, Tx.IoCntl(3).read_clr() );
+	CHECKX(                      0x00000000, Tx.IoCntl(2).read_set() );
+	CHECKX(                      0x00000000, Tx.IoCntl(2).read_clr() );
+	CHECKX(                      0x00000085, Tx.IoCntl(3).read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## mask range errors
+//--------------------------------------------------------------------------
+
+  CASE( "50", "apply_imask() bad mask" );
+    try {
+	Tx.apply_imask( 0x10000000, 0x01 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::apply_imask():  mask exceeds MaxBit:  0x10000000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51", "apply_imask() bad imask" );
+    try {
+	Tx.apply_imask( 0x00000001, 0x100 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::apply_imask():  imask exceeds 0xff:  0x100",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "read_irq_pending() bad mask" );
+    try {
+	Tx.read_irq_pending( 0x80000000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::read_irq_pending():  mask exceeds MaxBit:  0x80000000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "53", "ack_edge() bad mask" );
+    try {
+	Tx.ack_edge( 0xf0000000 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoCon::ack_edge():  mask exceeds MaxBit:  0xf0000000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
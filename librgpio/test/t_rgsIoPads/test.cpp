@@ -6,7 +6,7 @@
 //    30-39  Hardware read(), write():  _peek _flip _set _clr
 //    40-49  Object grab(), push():  _peek _flip _set _clr
 //    41     Object get(), put()
-//    50-59  .
+//    50-59  Shadow cache:  refresh(), read_pad(), write_pad(), modify_pad()
 //    60-98  IoPad() Field Accessors:  get_(), put_()
 //--------------------------------------------------------------------------
 
@@ -456,6 +456,115 @@ rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
 	FAIL( "unexpected exception" );
     }
 
+//--------------------------------------------------------------------------
+//## Shadow cache:  refresh(), read_pad(), write_pad(), modify_pad()
+//--------------------------------------------------------------------------
+
+  CASE( "50", "shadow mode default off" );
+    try {
+	rgsIoPads	tx  ( &Bx );
+	CHECK(                0, tx.config_ShadowMode() );
+	CHECK(                0, tx.get_StaleCount() );
+	CHECKX( 0x00000000, tx.get_doc_offset( tx.IoVoltage.addr() ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51a", "read_pad() hardware mode" );
+    try {
+	Tx.IoPad(3).write(      0x00000056 );
+	CHECKX(                 0x00000056, Tx.read_pad(3) );
+	Tx.IoPad(3).write(      0x00000011 );
+	CHECKX(                 0x00000011, Tx.read_pad(3) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "51b", "read_pad() shadow mode ignores hardware change" );
+    try {
+	Tx.config_ShadowMode( 1 );
+	CHECK(                  1, Tx.config_ShadowMode() );
+	CHECKX(                 0x00000011, Tx.read_pad(3) );
+	Tx.IoPad(3).write(      0x00000022 );
+	CHECKX(                 0x00000011, Tx.read_pad(3) );
+	CHECK(                  0, Tx.get_StaleCount() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "52", "refresh() counts stale registers" );
+    try {
+	Tx.IoPad(4).write(      0x00000033 );
+	Tx.IoVoltage.write(     0x00000001 );
+	CHECK(                  3, Tx.refresh() );
+	CHECK(                  3, Tx.get_StaleCount() );
+	CHECKX(                 0x00000022, Tx.read_pad(3) );
+	CHECKX(                 0x00000033, Tx.read_pad(4) );
+	CHECKX(                 0x00000001, Tx.read_volt() );
+	CHECK(                  0, Tx.refresh() );
+	CHECK(                  3, Tx.get_StaleCount() );
+	Tx.clear_StaleCount();
+	CHECK(                  0, Tx.get_StaleCount() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "53", "write_pad() writes through" );
+    try {
+	Tx.write_pad(     3,    0x0000005a );
+	CHECKX(                 0x0000005a, Tx.IoPad(3).read() );
+	CHECKX(                 0x0000005a, Tx.read_pad(3) );
+	Tx.write_volt(          0x00000000 );
+	CHECKX(                 0x00000000, Tx.IoVoltage.read() );
+	CHECKX(                 0x00000000, Tx.read_volt() );
+	CHECK(                  0, Tx.refresh() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "54", "modify_pad() atomic set/clr, no read" );
+    try {
+	Tx.IoPad(3).write_set(  0xffffffff );
+	Tx.IoPad(3).write_clr(  0xffffffff );
+	Tx.modify_pad(    3,    0x00000030, 0x000000a0 );
+	CHECKX(                 0x00000020, Tx.IoPad(3).read_set() );
+	CHECKX(                 0x00000010, Tx.IoPad(3).read_clr() );
+	CHECKX(                 0x0000006a, Tx.read_pad(3) );
+	CHECKX(                 0x0000005a, Tx.IoPad(3).read() );
+	// Fake memory does not apply set/clr to the normal address.
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "55", "read_pad() bad index" );
+    try {
+	Tx.read_pad( 28 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIo_Pad::IoPad():  bit index out-of-range:  28",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "56", "disable shadow mode" );
+    try {
+	Tx.config_ShadowMode( 0 );
+	CHECKX(                 0x0000005a, Tx.read_pad(3) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
 //--------------------------------------------------------------------------
 //## IoPad() Field Accessors:  get_(), put_()
 //--------------------------------------------------------------------------
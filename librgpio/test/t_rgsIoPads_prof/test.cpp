@@ -0,0 +1,276 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgsIoPads  Pad profile batch for RPi5
+//    10-19  rgsPad_enum2cstr(), find_rgsPad_enum()
+//    20-29  apply_profile() hardware mode
+//    30-39  apply_profile() shadow mode
+//    40-49  apply_volt()
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgsIoPads.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x40000000, Bx.config_DocBase() );
+	CHECKX( 0x00004000, Bx.config_BlockSize() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgsIoPads		Tx   ( &Bx );		// test object
+
+//--------------------------------------------------------------------------
+//## rgsPad_enum2cstr(), find_rgsPad_enum()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "rgsPad_enum2cstr()" );
+    try {
+	CHECK( "Reset",   rgsIoPads::rgsPad_enum2cstr( rgsIoPads::pad_Reset   ) );
+	CHECK( "FastSpi", rgsIoPads::rgsPad_enum2cstr( rgsIoPads::pad_FastSpi ) );
+	CHECK( "SlowIic", rgsIoPads::rgsPad_enum2cstr( rgsIoPads::pad_SlowIic ) );
+	CHECK( "InHyst",  rgsIoPads::rgsPad_enum2cstr( rgsIoPads::pad_InHyst  ) );
+	CHECK( "Off",     rgsIoPads::rgsPad_enum2cstr( rgsIoPads::pad_Off     ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "rgsPad_enum2cstr() bad enum" );
+    try {
+	rgsIoPads::rgsPad_enum2cstr( (rgsIoPads::rgsPad_enum) 0x33 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoPads::rgsPad_enum2cstr():  bad enum= 0x33",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "find_rgsPad_enum()" );
+    try {
+	CHECKX( 0x71, rgsIoPads::find_rgsPad_enum( "FastSpi" ) );
+	CHECKX( 0x5a, rgsIoPads::find_rgsPad_enum( "SlowIic" ) );
+	CHECKX( 0xc2, rgsIoPads::find_rgsPad_enum( "InHyst"  ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "find_rgsPad_enum() not found" );
+    try {
+	rgsIoPads::find_rgsPad_enum( "Fast" );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoPads::find_rgsPad_enum() no enum for string:  Fast",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "14", "find_rgsPad_enum() NULL" );
+    try {
+	rgsIoPads::find_rgsPad_enum( NULL );
+	FAIL( "no throw" );
+    }
+    catch ( logic_error& e ) {
+	CHECK( "rgsIoPads::find_rgsPad_enum():  NULL string pointer",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## apply_profile() hardware mode
+//--------------------------------------------------------------------------
+// Fake memory does not apply set/clr to the normal address.
+
+  CASE( "20", "apply_profile() one pin" );
+    try {
+	Tx.IoPad(3).write_set(  0x00000000 );
+	Tx.IoPad(3).write_clr(  0x00000000 );
+	CHECK(                  2, Tx.apply_profile( 0x00000008,
+						    rgsIoPads::pad_FastSpi ) );
+	CHECKX(                 0x00000071, Tx.IoPad(3).read_set() );
+	CHECKX(                 0x0000008e, Tx.IoPad(3).read_clr() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "apply_profile() many pins" );
+    try {
+	CHECK(                  6, Tx.apply_profile( 0x08000011, 0x56 ) );
+	CHECKX(                 0x00000056, Tx.IoPad(27).read_set() );
+	CHECKX(                 0x000000a9, Tx.IoPad(27).read_clr() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "apply_profile() all ones needs only set" );
+    try {
+	CHECK(                 28, Tx.apply_profile( 0x0fffffff, 0xff ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "apply_profile() bad mask" );
+    try {
+	Tx.apply_profile( 0x10000000, 0x56 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoPads::apply_profile():  mask exceeds MaxBit:  0x10000000",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "apply_profile() bad pad_word" );
+    try {
+	Tx.apply_profile( 0x00000001, 0x156 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoPads::apply_profile():  pad_word exceeds 0xff:  0x156",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## apply_profile() shadow mode
+//--------------------------------------------------------------------------
+
+  CASE( "30", "condition memory, shadow load" );
+    try {
+	for ( int ii=0;  ii<=27;  ii++ ) {
+	    Tx.IoPad(ii).write(      0x00000056 );
+	}
+	Tx.config_ShadowMode( 1 );
+	CHECKX(                      0x00000056, Tx.read_pad(5) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "apply_profile() unchanged pins cost nothing" );
+    try {
+	CHECK(                  0, Tx.apply_profile( 0x0fffffff,
+						    rgsIoPads::pad_Reset ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "apply_profile() only changed bits" );
+    try {
+	Tx.IoPad(5).write_set(  0x00000000 );
+	Tx.IoPad(5).write_clr(  0x00000000 );
+	CHECK(                  2, Tx.apply_profile( 0x00000020,
+						    rgsIoPads::pad_SlowIic ) );
+	CHECKX(                 0x00000008, Tx.IoPad(5).read_set() );
+	CHECKX(                 0x00000004, Tx.IoPad(5).read_clr() );
+	CHECKX(                 0x0000005a, Tx.read_pad(5) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "apply_profile() only set needed" );
+    try {
+	Tx.IoPad(6).write_clr(  0x00000000 );
+	CHECK(                  1, Tx.apply_profile( 0x00000040, 0xd6 ) );
+	CHECKX(                 0x00000080, Tx.IoPad(6).read_set() );
+	CHECKX(                 0x00000000, Tx.IoPad(6).read_clr() );
+	Tx.config_ShadowMode( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## apply_volt()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "apply_volt() hardware mode" );
+    try {
+	Tx.IoVoltage.write_set( 0x00000000 );
+	Tx.IoVoltage.write_clr( 0x00000000 );
+	CHECK(                  1, Tx.apply_volt( 1 ) );
+	CHECKX(                 0x00000001, Tx.IoVoltage.read_set() );
+	CHECK(                  1, Tx.apply_volt( 0 ) );
+	CHECKX(                 0x00000001, Tx.IoVoltage.read_clr() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "apply_volt() shadow mode unchanged" );
+    try {
+	Tx.IoVoltage.write(     0x00000000 );
+	Tx.config_ShadowMode( 1 );
+	CHECK(                  0, Tx.apply_volt( 0 ) );
+	CHECK(                  1, Tx.apply_volt( 1 ) );
+	CHECK(                  0, Tx.apply_volt( 1 ) );
+	CHECKX(                 0x00000001, Tx.read_volt() );
+	Tx.config_ShadowMode( 0 );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "apply_volt() bad value" );
+    try {
+	Tx.apply_volt( 2 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsIoPads::apply_volt():  require {0,1}:  2",
+	    e.what()
+	);
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
@@ -0,0 +1,322 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgsPwm - Pulse Width Modulator class for RPi5 (RP1)
+//    10-19  Constructor, get_bcm_address(), register address
+//    20-29  set_duty(), set_duty2(), set_range(), latch_update()
+//    30-39  enable_chan(), disable_chan()
+//    40-49  fifo_level(), fifo_flush(), push_regs()
+//
+// Fake memory has separate words for each atomic alias, so write_set()
+// is seen by read_set() and write_clr() by read_clr().
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgsPwm.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x40000000, Bx.config_DocBase() );
+	CHECKX( 0x00004000, Bx.config_BlockSize() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgsPwm			Tx   ( &Bx );		// test object, PWM0
+
+//--------------------------------------------------------------------------
+//## Constructor, get_bcm_address(), register address
+//--------------------------------------------------------------------------
+
+  CASE( "10a", "rgsPwm constructor, default PWM0" );
+    try {
+	rgsPwm		tx  ( &Bx );
+	CHECK(           0, tx.get_unit_num() );
+	CHECKX( 0x40098000, tx.get_bcm_address() );
+	CHECKX( 0x40098000, tx.get_doc_address() );
+	CHECK(           3, rgsPwm::MaxChan );
+	CHECK(          16, rgsPwm::FifoDepth );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "10b", "rgsPwm constructor PWM1" );
+    try {
+	rgsPwm		tx  ( &Bx, 1 );
+	CHECK(           1, tx.get_unit_num() );
+	CHECKX( 0x40098000, tx.get_bcm_address() );
+	CHECKX( 0x4009c000, tx.get_doc_address() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "10c", "rgsPwm constructor unit 2 exception" );
+    try {
+	rgsPwm		tx  ( &Bx, 2 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwm::  require unit in {0,1}", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "rgsPwm constructor, not RPi5" );
+    try {
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2711 );	// RPi4
+	rgsPwm		tx  ( &Bx );
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );
+	FAIL( "no throw" );
+    }
+    catch ( std::domain_error& e ) {
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );
+	CHECK( "rgsPwm::  require RPi5 (soc_BCM2712)", e.what() );
+    }
+    catch (...) {
+	rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "register doc offsets" );
+    try {
+	CHECKX( 0x00, Tx.get_doc_offset( Tx.GlobalCtrl.addr() ) );
+	CHECKX( 0x04, Tx.get_doc_offset( Tx.FifoCtrl.addr() ) );
+	CHECKX( 0x08, Tx.get_doc_offset( Tx.CommonRange.addr() ) );
+	CHECKX( 0x0c, Tx.get_doc_offset( Tx.CommonDuty.addr() ) );
+	CHECKX( 0x10, Tx.get_doc_offset( Tx.DutyFifo.addr() ) );
+	CHECKX( 0x14, Tx.get_doc_offset( Tx.ChanCtrl[0].addr() ) );
+	CHECKX( 0x18, Tx.get_doc_offset( Tx.ChanRange[0].addr() ) );
+	CHECKX( 0x1c, Tx.get_doc_offset( Tx.ChanPhase[0].addr() ) );
+	CHECKX( 0x20, Tx.get_doc_offset( Tx.ChanDuty[0].addr() ) );
+	CHECKX( 0x30, Tx.get_doc_offset( Tx.ChanDuty[1].addr() ) );
+	CHECKX( 0x44, Tx.get_doc_offset( Tx.ChanCtrl[3].addr() ) );
+	CHECKX( 0x50, Tx.get_doc_offset( Tx.ChanDuty[3].addr() ) );
+	CHECKX( 0x54, Tx.get_doc_offset( Tx.Intr.addr() ) );
+	CHECKX( 0x58, Tx.get_doc_offset( Tx.Inte.addr() ) );
+	CHECKX( 0x5c, Tx.get_doc_offset( Tx.Intf.addr() ) );
+	CHECKX( 0x60, Tx.get_doc_offset( Tx.Ints.addr() ) );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "ChanCtrl field accessors" );
+    try {
+	Tx.ChanCtrl[2].put( 0x00000000 );
+	Tx.ChanCtrl[2].put_FifoPopMask_1( 1 );
+	Tx.ChanCtrl[2].put_UseFifo_1( 1 );
+	Tx.ChanCtrl[2].put_Invert_1( 1 );
+	Tx.ChanCtrl[2].put_Mode_3( rgsPwm::md_SerLsb );
+	CHECKX( 0x0000018f, Tx.ChanCtrl[2].get() );
+	CHECK(  1,          Tx.ChanCtrl[2].get_UseFifo_1() );
+	CHECK(  0,          Tx.ChanCtrl[2].get_Bind_1() );
+	CHECK(  7,          Tx.ChanCtrl[2].get_Mode_3() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## set_duty(), set_duty2(), set_range(), latch_update()
+//--------------------------------------------------------------------------
+
+  CASE( "20", "set_duty()" );
+    try {
+	Tx.GlobalCtrl.write_set( 0x00000000 );
+	Tx.set_duty( 1, 333 );
+	CHECK(  333,        Tx.ChanDuty[1].read() );
+	CHECKX( 0x80000000, Tx.GlobalCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "set_duty() ch exception" );
+    try {
+	Tx.set_duty( 4, 333 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwm::set_duty():  ch requires {0..3}:  4", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "set_duty2()" );
+    try {
+	Tx.GlobalCtrl.write_set( 0x00000000 );
+	Tx.set_duty2( 0, 111, 3, 999 );
+	CHECK(  111,        Tx.ChanDuty[0].read() );
+	CHECK(  999,        Tx.ChanDuty[3].read() );
+	CHECKX( 0x80000000, Tx.GlobalCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "23", "set_duty2() chb exception" );
+    try {
+	Tx.set_duty2( 0, 111, 5, 999 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwm::set_duty2():  ch requires {0..3}:  5", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "24", "set_range()" );
+    try {
+	Tx.GlobalCtrl.write_set( 0x00000000 );
+	Tx.set_range( 2, 5000 );
+	CHECK(  5000,       Tx.ChanRange[2].read() );
+	CHECKX( 0x80000000, Tx.GlobalCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "25", "latch_update()" );
+    try {
+	Tx.GlobalCtrl.write_set( 0x00000000 );
+	Tx.latch_update();
+	CHECKX( 0x80000000, Tx.GlobalCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## enable_chan(), disable_chan()
+//--------------------------------------------------------------------------
+
+  CASE( "30", "enable_chan()" );
+    try {
+	Tx.GlobalCtrl.write_set( 0x00000000 );
+	Tx.enable_chan( 0x5 );
+	CHECKX( 0x80000005, Tx.GlobalCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "enable_chan() mask exception" );
+    try {
+	Tx.enable_chan( 0x10 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwm::enable_chan():  mask exceeds 0xf:  0x10", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "disable_chan()" );
+    try {
+	Tx.GlobalCtrl.write_set( 0x00000000 );
+	Tx.GlobalCtrl.write_clr( 0x00000000 );
+	Tx.disable_chan( 0xa );
+	CHECKX( 0x0000000a, Tx.GlobalCtrl.read_clr() );
+	CHECKX( 0x80000000, Tx.GlobalCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "33", "disable_chan() mask exception" );
+    try {
+	Tx.disable_chan( 0x1f );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwm::disable_chan():  mask exceeds 0xf:  0x1f", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## fifo_level(), fifo_flush(), push_regs()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "fifo_level()" );
+    try {
+	Tx.FifoCtrl.write( 0x000103ab );
+	CHECK(  11,         Tx.fifo_level() );
+	Tx.FifoCtrl.grab();
+	CHECK(  1,          Tx.FifoCtrl.get_FlushDone_1() );
+	CHECK(  29,         Tx.FifoCtrl.get_Threshold_5() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "41", "fifo_flush()" );
+    try {
+	Tx.FifoCtrl.write_set( 0x00000000 );
+	Tx.fifo_flush();
+	CHECKX( 0x00008000, Tx.FifoCtrl.read_set() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "42", "push_regs() latches GlobalCtrl last" );
+    try {
+	Tx.GlobalCtrl.write( 0x00000000 );
+	Tx.ChanRange[1].put( 4000 );
+	Tx.ChanDuty[1].put(  1000 );
+	Tx.GlobalCtrl.put( 0x00000002 );
+	Tx.push_regs();
+	CHECK(  4000,       Tx.ChanRange[1].read() );
+	CHECK(  1000,       Tx.ChanDuty[1].read() );
+	CHECKX( 0x80000002, Tx.GlobalCtrl.read() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "43", "grab_regs()" );
+    try {
+	Tx.ChanPhase[3].write( 0x123 );
+	Tx.ChanPhase[3].put( 0 );
+	Tx.grab_regs();
+	CHECKX( 0x123,      Tx.ChanPhase[3].get() );
+	CHECK(  4000,       Tx.ChanRange[1].get() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,228 @@
+// 2026-10-19  William A. Hudson
+//
+// Testing:  rgsPwmStream  PWM Fifo sample streaming on rgsPwm (RPi5).
+//    10-19  Constructor, start()
+//    20-29  service() by FifoCtrl level
+//    30-39  service() FifoUnderflow
+//    40-49  run()
+// Sample sources and conversion (rgPwmStream_Feed) are in t_rgPwmStream.
+//
+// Fake memory has a single DutyFifo word, so reading it returns the last
+// word written.  Presetting FifoCtrl selects the Fifo level;  writing Intr
+// to clear FifoUnderflow leaves fake Intr unchanged.
+//--------------------------------------------------------------------------
+
+#include <iostream>	// std::cerr
+#include <stdexcept>	// std::stdexcept
+
+#include "utLib1.h"		// unit test library
+
+#include "rgRpiRev.h"
+#include "rgAddrMap.h"
+#include "rgsPwm.h"
+#include "rgPwmStream.h"
+#include "rgsPwmStream.h"
+
+using namespace std;
+
+//--------------------------------------------------------------------------
+
+int main()
+{
+
+//--------------------------------------------------------------------------
+//## Shared object
+//--------------------------------------------------------------------------
+
+rgRpiRev::simulate_SocEnum( rgRpiRev::soc_BCM2712 );    // RPi5
+
+rgAddrMap		Bx;
+
+  CASE( "00", "Address map object" );
+    try {
+	Bx.open_fake_mem();
+	CHECKX( 0x40000000, Bx.config_DocBase() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+rgsPwm			Px   ( &Bx );
+
+int16_t			rbuf[16];
+rgPwmStream_Ring	Ring ( rbuf, 16 );
+
+rgsPwmStream		Tx   ( &Px, 2 );	// test object, channel 2
+
+int16_t			samp[32];
+
+for ( int i=0;  i<32;  i++ )
+{
+    samp[i] = i * 1000;
+}
+
+//--------------------------------------------------------------------------
+//## Constructor, start()
+//--------------------------------------------------------------------------
+
+  CASE( "10", "constructor defaults" );
+    try {
+	rgsPwmStream	tx  ( &Px );
+	CHECK(  0,          tx.get_Chan() );
+	CHECK(  0,          tx.get_Range() );
+	CHECK(  0,          tx.get_WordCnt() );
+	CHECK(  0,          tx.get_GapCnt() );
+	CHECK(  0,          tx.get_StarveCnt() );
+	CHECK(  0,          tx.get_PollCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "11", "constructor ch exception" );
+    try {
+	rgsPwmStream	tx  ( &Px, 4 );
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwmStream::  ch requires {0..3}:  4", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "12", "start() no sample source" );
+    try {
+	rgsPwmStream	tx  ( &Px );
+	tx.start();
+	FAIL( "no throw" );
+    }
+    catch ( range_error& e ) {
+	CHECK( "rgsPwmStream::start():  no sample source", e.what() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "13", "start() reads ChanRange of channel" );
+    try {
+	Px.ChanRange[0].write( 5 );
+	Px.ChanRange[2].write( 1000 );
+	Tx.config_Ring( &Ring );
+	Tx.start();
+	CHECK(  2,          Tx.get_Chan() );
+	CHECK(  1000,       Tx.get_Range() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## service() by FifoCtrl level
+//--------------------------------------------------------------------------
+
+  CASE( "20", "service() fills room, ring runs dry" );
+    try {
+	Px.Intr.write( 0x00000000 );
+	Ring.push_block( samp, 10 );
+	Px.FifoCtrl.write( 0x00000003 );	// Level 3, room 13
+	CHECK(  10,         Tx.service() );
+	CHECK(  10,         Tx.get_WordCnt() );
+	CHECK(  1,          Tx.get_PollCnt() );
+	CHECK(  1,          Tx.get_StarveCnt() );
+	CHECK(  637,        Px.DutyFifo.read() );	// sample 9000
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "21", "service() room limits words" );
+    try {
+	Ring.push_block( samp, 10 );
+	Px.FifoCtrl.write( 0x00000060 | 13 );	// Threshold 3, Level 13
+	CHECK(  3,          Tx.service() );
+	CHECK(  13,         Tx.get_WordCnt() );
+	CHECK(  1,          Tx.get_StarveCnt() );
+	CHECK(  530,        Px.DutyFifo.read() );	// sample 2000
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "22", "service() Fifo full, no room" );
+    try {
+	Px.FifoCtrl.write( 16 );
+	CHECK(  0,          Tx.service() );
+	CHECK(  1,          Tx.get_StarveCnt() );
+	CHECK(  3,          Tx.get_PollCnt() );
+	Ring.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## service() FifoUnderflow
+//--------------------------------------------------------------------------
+
+  CASE( "30", "service() empty with FifoUnderflow counted" );
+    try {
+	Px.FifoCtrl.write( 0 );
+	Px.Intr.write( 0x00000001 );		// FifoUnderflow
+	Tx.service();
+	CHECK(  1,          Tx.get_GapCnt() );
+	Tx.service();
+	CHECK(  2,          Tx.get_GapCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "31", "service() FifoUnderflow ignored when not empty" );
+    try {
+	Px.FifoCtrl.write( 4 );
+	Tx.service();
+	CHECK(  2,          Tx.get_GapCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+  CASE( "32", "service() empty, no FifoUnderflow" );
+    try {
+	Px.FifoCtrl.write( 0 );
+	Px.Intr.write( 0x00000000 );
+	Tx.service();
+	CHECK(  2,          Tx.get_GapCnt() );
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------------------------------------------
+//## run()
+//--------------------------------------------------------------------------
+
+  CASE( "40", "run() writes DutyFifo to nword" );
+    try {
+	Px.ChanRange[2].write( 0x10000 );	// word = sample + 32768
+	Tx.start();
+	CHECK(  16,         Ring.push_block( samp, 16 ) );
+	Px.FifoCtrl.write( 8 );			// Level 8, room 8
+	CHECK(  16,         Tx.run( 12 ) );
+	CHECK(  2,          Tx.get_PollCnt() );
+	CHECK(  0x8000 + 15000, Px.DutyFifo.read() );	// sample 15000
+	CHECK(  0,          Tx.get_StarveCnt() );
+	CHECK(  0,          Tx.get_GapCnt() );
+	Tx.stop();
+	CHECK(  16,         Tx.run( 0 ) );
+	Ring.clear();
+    }
+    catch (...) {
+	FAIL( "unexpected exception" );
+    }
+
+//--------------------------------------
+  CASE( "99", "Done" );
+}
+
@@ -0,0 +1,364 @@
+// 2026-10-19  William A. Hudson
+//
+// SPI0 small transaction rate with rgSpi0Queue.
+//     No hardware connection needed.
+// Provide external configuration:
+//   rgpio fsel --mode=Alt0  7 8 9 10 11			# spi0
+//   rgpio spi0 -0 --ClockDiv_16=16
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <stdlib.h>
+#include <stdexcept>	// std::stdexcept
+
+using namespace std;
+
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+#include "rgSpi0Queue.h"
+
+#include "Error.h"
+#include "yOption.h"
+//#include "yMan.h"
+
+#define CLKID	CLOCK_MONOTONIC_RAW
+
+
+//--------------------------------------------------------------------------
+// Option Handling
+//--------------------------------------------------------------------------
+
+class yOptLong : public yOption {
+
+//  public:	// inherited
+//    char*		ProgName;
+//    int		get_argc();
+//    char*		next_arg();
+//    bool		next();
+//    bool		is( const char* opt );
+//    char*		val();
+//    char*		current_option();
+
+  public:	// option values
+
+    const char*		spi;
+    const char*		nxact;
+    const char*		txlen;
+    const char*		rxlen;
+    const char*		ncs;
+    const char*		repeat;
+    bool		merge;
+    bool		reorder;
+
+    bool		verbose;
+    bool		debug;
+    bool		man;
+    bool		TESTOP;
+
+  public:	// data values
+
+    uint32_t		spi_n;			// SPI unit number
+    int			nxact_n;		// transactions per run
+    int			txlen_n;		// Tx bytes per transaction
+    int			rxlen_n;		// Rx bytes per transaction
+    int			ncs_n;			// number of chip selects used
+    int			repeat_n;		// repeat loop
+
+  public:
+    yOptLong( int argc,  char* argv[] );	// constructor
+
+    void		parse_options();
+    void		print_option_flags();
+    void		print_usage();
+
+};
+
+
+/*
+* Constructor.  Init options with default values.
+*    Pass in the main() argc and argv parameters.
+* call:
+*    yOptLong	Opx  ( argc, argv );
+*    yOptLong	Opx = yOptLong::yOptLong( argc, argv );
+*/
+yOptLong::yOptLong( int argc,  char* argv[] )
+    : yOption( argc, argv )
+{
+    spi         = "";
+    nxact       = "";
+    txlen       = "";
+    rxlen       = "";
+    ncs         = "";
+    repeat      = "";
+    merge       = 0;
+    reorder     = 0;
+
+    verbose     = 0;
+    debug       = 0;
+    man         = 0;
+    TESTOP      = 0;
+
+    spi_n       = 0;
+    nxact_n     = 1000;
+    txlen_n     = 2;
+    rxlen_n     = 2;
+    ncs_n       = 2;
+    repeat_n    = 1;
+}
+
+
+/*
+* Parse options.
+*/
+void
+yOptLong::parse_options()
+{
+    while ( this->next() )
+    {
+	if      ( is( "--spi="       )) { spi        = this->val(); }
+	else if ( is( "--nxact="     )) { nxact      = this->val(); }
+	else if ( is( "--txlen="     )) { txlen      = this->val(); }
+	else if ( is( "--rxlen="     )) { rxlen      = this->val(); }
+	else if ( is( "--ncs="       )) { ncs        = this->val(); }
+	else if ( is( "--repeat="    )) { repeat     = this->val(); }
+	else if ( is( "--merge"      )) { merge      = 1; }
+	else if ( is( "--reorder"    )) { reorder    = 1; }
+
+	else if ( is( "--verbose"    )) { verbose    = 1; }
+	else if ( is( "-v"           )) { verbose    = 1; }
+	else if ( is( "--debug"      )) { debug      = 1; }
+	else if ( is( "--man"        )) { man        = 1; }
+	else if ( is( "--TESTOP"     )) { TESTOP     = 1; }
+	else if ( is( "--help"       )) { this->print_usage();  exit( 0 ); }
+	else if ( is( "-"            )) {                break; }
+	else if ( is( "--"           )) { this->next();  break; }
+	else {
+	    Error::msg( "unknown option:  " ) << this->current_option() <<endl;
+	}
+    }
+
+    string	spi_s     ( spi );
+    string	nxact_s   ( nxact );
+    string	txlen_s   ( txlen );
+    string	rxlen_s   ( rxlen );
+    string	ncs_s     ( ncs );
+    string	repeat_s  ( repeat );
+
+    if ( spi_s.length() ) {
+	spi_n = stoi( spi_s );
+    }
+
+    if ( nxact_s.length() ) {
+	nxact_n = stoi( nxact_s );
+    }
+
+    if ( txlen_s.length() ) {
+	txlen_n = stoi( txlen_s );
+    }
+
+    if ( rxlen_s.length() ) {
+	rxlen_n = stoi( rxlen_s );
+    }
+
+    if ( ncs_s.length() ) {
+	ncs_n = stoi( ncs_s );
+    }
+
+    if ( repeat_s.length() ) {
+	repeat_n = stoi( repeat_s );
+    }
+
+    if ( (ncs_n < 1) || (ncs_n > 3) ) {
+	Error::msg( "require --ncs={1,2,3}:  " ) << ncs_n <<endl;
+    }
+
+    if ( (txlen_n < 0) || (rxlen_n < 0) || (txlen_n + rxlen_n > 64) ) {
+	Error::msg( "require --txlen + --rxlen <= 64" ) <<endl;
+    }
+
+    if ( nxact_n < 0 ) {
+	Error::msg( "require --nxact >= 0:  " ) << nxact_n <<endl;
+    }
+
+    if ( get_argc() > 0 ) {
+	Error::msg( "extra arguments:  " ) << next_arg() <<endl;
+    }
+}
+
+
+/*
+* Show option flags.
+*/
+void
+yOptLong::print_option_flags()
+{
+    cout << "--spi         = " << spi          << endl;
+    cout << "--nxact       = " << nxact        << endl;
+    cout << "--txlen       = " << txlen        << endl;
+    cout << "--rxlen       = " << rxlen        << endl;
+    cout << "--ncs         = " << ncs          << endl;
+    cout << "--repeat      = " << repeat       << endl;
+    cout << "--merge       = " << merge        << endl;
+    cout << "--reorder     = " << reorder      << endl;
+    cout << "--verbose     = " << verbose      << endl;
+    cout << "--debug       = " << debug        << endl;
+
+    cout << "spi_n         = " << spi_n        << endl;
+    cout << "nxact_n       = " << nxact_n      << endl;
+    cout << "txlen_n       = " << txlen_n      << endl;
+    cout << "rxlen_n       = " << rxlen_n      << endl;
+    cout << "ncs_n         = " << ncs_n        << endl;
+    cout << "repeat_n      = " << repeat_n     << endl;
+}
+
+
+/*
+* Show usage.
+*/
+void
+yOptLong::print_usage()
+{
+    cout <<
+    "    SPI0 small transaction rate, chip select round-robin\n"
+    "usage:  " << ProgName << " [options]\n"
+    "  options:\n"
+    "    --spi=N             spi unit number {0,3,4,5,6}, default 0\n"
+    "    --nxact=N           transactions per run, default 1000\n"
+    "    --txlen=N           Tx bytes per transaction, default 2\n"
+    "    --rxlen=N           Rx bytes per transaction, default 2\n"
+    "    --ncs=N             chip selects used {1,2,3}, default 2\n"
+    "    --merge             allow merge of same chip select\n"
+    "    --reorder           group transactions by chip select\n"
+    "    --repeat=N          repeat run N times\n"
+    "    --help              show this usage\n"
+//  "  # --man               show manpage and exit\n"
+//  "  # -v, --verbose       verbose output\n"
+    "    --debug             debug output\n"
+    "  (options with GNU= only)\n"
+    ;
+
+// Hidden options:
+//       --TESTOP       test mode show all options
+}
+
+
+//--------------------------------------------------------------------------
+// Main program
+//--------------------------------------------------------------------------
+
+int
+main( int	argc,
+      char	*argv[]
+) {
+    int			rv;
+    struct timespec	tpA;
+    struct timespec	tpB;
+
+    try {
+	yOptLong		Opx  ( argc, argv );	// constructor
+
+	Opx.parse_options();
+
+	if ( Opx.TESTOP ) {
+	    Opx.print_option_flags();
+	    return ( Error::has_err() ? 1 : 0 );
+	}
+
+	if ( Opx.man ) {
+	    Error::msg( "--man not implemented\n" );
+	    return ( 0 );
+	}
+
+	if ( Error::has_err() )  return 1;
+
+	rgAddrMap		Amx;			// constructor
+
+	Amx.open_dev_mem();
+
+	rgSpi0			Spx  ( &Amx, Opx.spi_n );	// constructor
+	rgSpi0Queue		Qx   ( &Spx );
+
+	if ( Amx.is_fake_mem() ) {
+	    cout << "Using Fake memory, simulate Tx done" <<endl;
+	    Spx.CntlStat.write( 0x00050000 );	// TxHasSpace, TxEmpty
+	}
+
+	Qx.config_Reorder( Opx.reorder );
+
+	int		n_xact = Opx.nxact_n;
+	rgSpi0_Xact	*xv    = new rgSpi0_Xact [n_xact+1];
+	uint8_t		txDat[64];
+	uint8_t		*rxDat = new uint8_t [(n_xact * Opx.rxlen_n) + 1];
+
+	for ( int i=0;  i < 64;  i++ )
+	{
+	    txDat[i] = i;
+	}
+
+	for ( int i=0;  i < n_xact;  i++ )
+	{
+	    xv[i].Cs    = i % Opx.ncs_n;
+	    xv[i].Tx    = txDat;
+	    xv[i].TxLen = Opx.txlen_n;
+	    xv[i].Rx    = rxDat + (i * Opx.rxlen_n);
+	    xv[i].RxLen = Opx.rxlen_n;
+	    xv[i].Merge = Opx.merge;
+	}
+
+	Spx.ClkDiv.grab();
+	cerr << "    n_xact= " << n_xact
+	     << "  frame= " << (Opx.txlen_n + Opx.rxlen_n) << " bytes"
+	     << "  ClockDiv_16= " << Spx.ClkDiv.get_ClockDiv_16() << endl;
+
+	// Main Loop
+
+	for ( int jj=1;  jj<=Opx.repeat_n;  jj++ )	// repeat loop
+	{
+	    rv = clock_gettime( CLKID, &tpA );
+
+	    uint32_t	cnt = Qx.run( xv, n_xact );
+
+	    rv = clock_gettime( CLKID, &tpB );
+
+	    if ( rv ) { cerr << "Error:  clock_gettime() failed" << endl; }
+
+	    int64_t	delta_ns =
+		((tpB.tv_sec  - tpA.tv_sec) * ((int64_t) 1000000000)) +
+		 (tpB.tv_nsec - tpA.tv_nsec);
+		// Note 4 seconds overflows a 32-bit int.
+		// Use careful promotion to 64-bit integer to avoid overflow.
+
+	    int		ns_xact   = -1;
+	    int64_t	xact_sec  = -1;
+	    if ( cnt ) {
+		ns_xact   =          ( delta_ns / cnt );
+	    }
+	    if ( delta_ns ) {
+		xact_sec  = ( cnt * ((int64_t) 1000000000) ) / delta_ns;
+	    }
+
+	    cerr << "Rep[" << jj << "]" <<endl;
+	    cerr << "    xact_cnt=     " << cnt               <<endl;
+	    cerr << "    frame_cnt=    " << Qx.get_FrameCnt() <<endl;
+	    cerr << "    poll_cnt=     " << Qx.get_PollCnt()  <<endl;
+	    cerr << "    delta_ns "
+		 <<setw(10) << delta_ns  << " ns,  "
+		 <<setw(4)  << ns_xact   << " ns/xact,  "
+		 <<setw(8)  << xact_sec  << " xact/s"
+		 <<endl;
+	}
+
+	delete [] xv;
+	delete [] rxDat;
+    }
+    catch ( std::exception& e ) {
+	Error::msg() << e.what() <<endl;
+    }
+    catch (...) {
+	Error::msg( "unexpected exception\n" );
+    }
+
+    return ( Error::has_err() ? 1 : 0 );
+}
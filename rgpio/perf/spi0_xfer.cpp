@@ -0,0 +1,313 @@
+// 2026-10-19  William A. Hudson
+//
+// SPI0 polled transfer throughput with rgSpi0::transfer().
+//     No hardware connection needed;  jumper MISO to MOSI to check data.
+// Provide external configuration:
+//   rgpio fsel --mode=Alt0  8 9 10 11				# spi0
+//   rgpio spi0 -0 --ClockDiv_16=16 --ChipSelectN_2=0
+//--------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <stdlib.h>
+#include <stdexcept>	// std::stdexcept
+
+using namespace std;
+
+#include "rgAddrMap.h"
+#include "rgSpi0.h"
+
+#include "Error.h"
+#include "yOption.h"
+//#include "yMan.h"
+
+#define CLKID	CLOCK_MONOTONIC_RAW
+
+
+//--------------------------------------------------------------------------
+// Option Handling
+//--------------------------------------------------------------------------
+
+class yOptLong : public yOption {
+
+//  public:	// inherited
+//    char*		ProgName;
+//    int		get_argc();
+//    char*		next_arg();
+//    bool		next();
+//    bool		is( const char* opt );
+//    char*		val();
+//    char*		current_option();
+
+  public:	// option values
+
+    const char*		spi;
+    const char*		nbyte;
+    const char*		repeat;
+    bool		tx_only;
+    bool		rx_only;
+
+    bool		verbose;
+    bool		debug;
+    bool		man;
+    bool		TESTOP;
+
+  public:	// data values
+
+    uint32_t		spi_n;			// SPI unit number
+    int			nbyte_n;		// bytes per transfer
+    int			repeat_n;		// repeat loop
+
+  public:
+    yOptLong( int argc,  char* argv[] );	// constructor
+
+    void		parse_options();
+    void		print_option_flags();
+    void		print_usage();
+
+};
+
+
+/*
+* Constructor.  Init options with default values.
+*    Pass in the main() argc and argv parameters.
+* call:
+*    yOptLong	Opx  ( argc, argv );
+*    yOptLong	Opx = yOptLong::yOptLong( argc, argv );
+*/
+yOptLong::yOptLong( int argc,  char* argv[] )
+    : yOption( argc, argv )
+{
+    spi         = "";
+    nbyte       = "";
+    repeat      = "";
+    tx_only     = 0;
+    rx_only     = 0;
+
+    verbose     = 0;
+    debug       = 0;
+    man         = 0;
+    TESTOP      = 0;
+
+    spi_n       = 0;
+    nbyte_n     = 4096;
+    repeat_n    = 1;
+}
+
+
+/*
+* Parse options.
+*/
+void
+yOptLong::parse_options()
+{
+    while ( this->next() )
+    {
+	if      ( is( "--spi="       )) { spi        = this->val(); }
+	else if ( is( "--nbyte="     )) { nbyte      = this->val(); }
+	else if ( is( "--repeat="    )) { repeat     = this->val(); }
+	else if ( is( "--tx-only"    )) { tx_only    = 1; }
+	else if ( is( "--rx-only"    )) { rx_only    = 1; }
+
+	else if ( is( "--verbose"    )) { verbose    = 1; }
+	else if ( is( "-v"           )) { verbose    = 1; }
+	else if ( is( "--debug"      )) { debug      = 1; }
+	else if ( is( "--man"        )) { man        = 1; }
+	else if ( is( "--TESTOP"     )) { TESTOP     = 1; }
+	else if ( is( "--help"       )) { this->print_usage();  exit( 0 ); }
+	else if ( is( "-"            )) {                break; }
+	else if ( is( "--"           )) { this->next();  break; }
+	else {
+	    Error::msg( "unknown option:  " ) << this->current_option() <<endl;
+	}
+    }
+
+    string	spi_s     ( spi );
+    string	nbyte_s   ( nbyte );
+    string	repeat_s  ( repeat );
+
+    if ( spi_s.length() ) {
+	spi_n = stoi( spi_s );
+    }
+
+    if ( nbyte_s.length() ) {
+	nbyte_n = stoi( nbyte_s );
+    }
+
+    if ( repeat_s.length() ) {
+	repeat_n = stoi( repeat_s );
+    }
+
+    if ( tx_only && rx_only ) {
+	Error::msg( "require only one of:  --tx-only --rx-only" ) <<endl;
+    }
+
+    if ( get_argc() > 0 ) {
+	Error::msg( "extra arguments:  " ) << next_arg() <<endl;
+    }
+}
+
+
+/*
+* Show option flags.
+*/
+void
+yOptLong::print_option_flags()
+{
+    cout << "--spi         = " << spi          << endl;
+    cout << "--nbyte       = " << nbyte        << endl;
+    cout << "--repeat      = " << repeat       << endl;
+    cout << "--tx-only     = " << tx_only      << endl;
+    cout << "--rx-only     = " << rx_only      << endl;
+    cout << "--verbose     = " << verbose      << endl;
+    cout << "--debug       = " << debug        << endl;
+
+    cout << "spi_n         = " << spi_n        << endl;
+    cout << "nbyte_n       = " << nbyte_n      << endl;
+    cout << "repeat_n      = " << repeat_n     << endl;
+}
+
+
+/*
+* Show usage.
+*/
+void
+yOptLong::print_usage()
+{
+    cout <<
+    "    SPI0 polled transfer throughput\n"
+    "usage:  " << ProgName << " [options]\n"
+    "  options:\n"
+    "    --spi=N             spi unit number {0,3,4,5,6}, default 0\n"
+    "    --nbyte=N           bytes per transfer, default 4096\n"
+    "    --repeat=N          repeat transfer N times\n"
+    "    --tx-only           discard Rx data\n"
+    "    --rx-only           send fill bytes\n"
+    "    --help              show this usage\n"
+//  "  # --man               show manpage and exit\n"
+    "    -v, --verbose       verbose output, check loopback data\n"
+    "    --debug             debug output\n"
+    "  (options with GNU= only)\n"
+    ;
+
+// Hidden options:
+//       --TESTOP       test mode show all options
+}
+
+
+//--------------------------------------------------------------------------
+// Main program
+//--------------------------------------------------------------------------
+
+int
+main( int	argc,
+      char	*argv[]
+) {
+    int			rv;
+    struct timespec	tpA;
+    struct timespec	tpB;
+
+    try {
+	yOptLong		Opx  ( argc, argv );	// constructor
+
+	Opx.parse_options();
+
+	if ( Opx.TESTOP ) {
+	    Opx.print_option_flags();
+	    return ( Error::has_err() ? 1 : 0 );
+	}
+
+	if ( Opx.man ) {
+	    Error::msg( "--man not implemented\n" );
+	    return ( 0 );
+	}
+
+	if ( Error::has_err() )  return 1;
+
+	rgAddrMap		Amx;			// constructor
+
+	Amx.open_dev_mem();
+
+	rgSpi0			Spx  ( &Amx, Opx.spi_n );	// constructor
+
+	if ( Amx.is_fake_mem() ) {
+	    cout << "Using Fake memory, simulate Tx done" <<endl;
+	    Spx.CntlStat.write( 0x00050000 );	// TxHasSpace, TxEmpty
+	}
+
+	int		n_byte = Opx.nbyte_n;
+	uint8_t		*txDat = new uint8_t [n_byte+1];
+	uint8_t		*rxDat = new uint8_t [n_byte+1];
+
+	for ( int i=0;  i < n_byte;  i++ )
+	{
+	    txDat[i] = i;
+	}
+
+	const uint8_t	*tx = Opx.rx_only ? NULL : txDat;
+	uint8_t		*rx = Opx.tx_only ? NULL : rxDat;
+
+	Spx.ClkDiv.grab();
+	cerr << "    n_byte= " << n_byte
+	     << "  ClockDiv_16= " << Spx.ClkDiv.get_ClockDiv_16() << endl;
+
+	// Main Loop
+
+	for ( int jj=1;  jj<=Opx.repeat_n;  jj++ )	// repeat loop
+	{
+	    rv = clock_gettime( CLKID, &tpA );
+
+	    size_t	cnt = Spx.transfer( tx, rx, n_byte );
+
+	    rv = clock_gettime( CLKID, &tpB );
+
+	    if ( rv ) { cerr << "Error:  clock_gettime() failed" << endl; }
+
+	    int64_t	delta_ns =
+		((tpB.tv_sec  - tpA.tv_sec) * ((int64_t) 1000000000)) +
+		 (tpB.tv_nsec - tpA.tv_nsec);
+		// Note 4 seconds overflows a 32-bit int.
+		// Use careful promotion to 64-bit integer to avoid overflow.
+
+	    uint32_t	poll_cnt  = Spx.get_PollCnt();
+	    int		ns_byte   = -1;
+	    int		kB_sec    = -1;
+	    if ( cnt ) {
+		ns_byte   =          ( delta_ns / cnt );
+	    }
+	    if ( delta_ns ) {
+		kB_sec    = ( cnt * ((int64_t) 1000000) ) / delta_ns;
+	    }
+
+	    cerr << "Rep[" << jj << "]" <<endl;
+	    cerr << "    byte_cnt=     " << cnt <<endl;
+	    cerr << "    poll_cnt=     " << poll_cnt <<endl;
+	    cerr << "    delta_ns "
+		 <<setw(10) << delta_ns  << " ns,  "
+		 <<setw(4)  << ns_byte   << " ns/byte,  "
+		 <<setw(6)  << kB_sec    << " kB/s"
+		 <<endl;
+
+	    if ( Opx.verbose && rx && tx ) {
+		int	bad = 0;
+		for ( size_t i=0;  i < cnt;  i++ )
+		{
+		    if ( rxDat[i] != txDat[i] )  bad++;
+		}
+		cerr << "    loopback mismatch= " << bad <<endl;
+	    }
+	}
+
+	delete [] txDat;
+	delete [] rxDat;
+    }
+    catch ( std::exception& e ) {
+	Error::msg() << e.what() <<endl;
+    }
+    catch (...) {
+	Error::msg( "unexpected exception\n" );
+    }
+
+    return ( Error::has_err() ? 1 : 0 );
+}
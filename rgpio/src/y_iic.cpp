@@ -20,6 +20,7 @@ using namespace std;
 #include "rgRpiRev.h"
 #include "rgAddrMap.h"
 #include "rgIic.h"
+#include "rgIicScan.h"
 
 #include "y_iic.h"
 
@@ -56,6 +57,9 @@ class iic_yOptLong : public yOption {
     yOpVal		rx;		// Receive N entries
     bool		tx;		// Transmit arguments
 
+    bool		scan;		// Scan slave addresses
+    rgIicScan::Mode_enum	scan_mode;
+
 					// Cntl fields
     yOpVal		IicEnable_1;
     yOpVal		IrqRxHalf_1;
@@ -103,6 +107,9 @@ iic_yOptLong::iic_yOptLong( yOption  *opx )
 {
     tx          = 0;
 
+    scan        = 0;
+    scan_mode   = rgIicScan::sm_Auto;
+
     reset       = 0;
     verbose     = 0;
     debug       = 0;
@@ -129,6 +136,16 @@ iic_yOptLong::parse_options()
 
 	else if ( is( "--rx="        )) { rx.set(       this->val() ); }
 	else if ( is( "--tx"         )) { tx         = 1; }
+	else if ( is( "--scan"       )) { scan       = 1; }
+	else if ( is( "--scan="      )) {
+	    scan = 1;
+	    if      ( ! strcmp( val(), "auto"  ) ) { scan_mode = rgIicScan::sm_Auto;  }
+	    else if ( ! strcmp( val(), "quick" ) ) { scan_mode = rgIicScan::sm_Quick; }
+	    else if ( ! strcmp( val(), "read"  ) ) { scan_mode = rgIicScan::sm_Read;  }
+	    else {
+		Error::msg( "unknown --scan=" ) << val() <<endl;
+	    }
+	}
 	else if ( is( "-0"           )) { iic_ch[0]  = 1; }
 	else if ( is( "-1"           )) { iic_ch[1]  = 1; }
 	else if ( is( "-2"           )) { iic_ch[2]  = 1; }
@@ -235,6 +252,10 @@ iic_yOptLong::parse_options()
     if ( (tx) && (get_argc() == 0) ) {
 	Error::msg( "--tx requires arg values" ) << endl;
     }
+
+    if ( scan && (tx || rx.Given) ) {
+	Error::msg( "--scan not valid with --tx or --rx" ) << endl;
+    }
 }
 
 
@@ -300,6 +321,8 @@ iic_yOptLong::print_usage()
     "  data transfer:\n"
     "    --rx=N              read N entries from 16-entry Fifo\n"
     "    --tx                write arg values to Fifo\n"
+    "    --scan[=auto]       scan slave addresses 0x08..0x77, all units at once\n"
+    "                          {auto, quick, read} probe, as i2cdetect\n"
     "  Cntl:\n"
     "    --IicEnable_1=0     Enable the interface\n"
     "    --IrqRxHalf_1=0     1= interrupt while RxHalf_1=1\n"
@@ -417,7 +440,9 @@ y_iic::doit()
 
 	// Heading
 
-	    cout << "Iic" << icx->get_iic_num() << ":" <<endl;
+	    if ( ! Opx.scan ) {
+		cout << "Iic" << icx->get_iic_num() << ":" <<endl;
+	    }
 
 	// Reset
 
@@ -484,6 +509,10 @@ y_iic::doit()
 		icx->Stat.put( Sx.get() );	// restore original grab
 	    }
 
+	    if ( Opx.scan ) {			// after all units modified
+		continue;
+	    }
+
 	// Tx FIFO
 
 	    if ( Opx.tx ) {
@@ -582,8 +611,88 @@ y_iic::doit()
 
 	}
 
+    // Scan all units concurrently
+
+	if ( Opx.scan ) {
+	    rgIicScan		Scn;
+	    uint32_t		nfound;
+
+	    Scn.config_Mode( Opx.scan_mode );
+
+	    for ( int ii=0;  ii<=IicMax;  ii++ )
+	    {
+		if ( Icx[ii] ) {
+		    Scn.add_unit( Icx[ii] );
+		}
+	    }
+
+	    Opx.trace_msg( "Scan slave addresses" );
+	    nfound = Scn.run();
+
+	    if ( Opx.verbose ) {
+		cout << "+ found " << nfound << " devices, "
+		     << Scn.get_PollCnt() << " status reads" <<endl;
+	    }
+
+	    uint32_t		uu = 0;		// index in Scn
+
+	    for ( int ii=0;  ii<=IicMax;  ii++ )
+	    {
+		if ( Icx[ii] ) {
+		    show_scan( &Scn, uu++, ii );
+		}
+	    }
+	}
+
     }
 
     return ( Error::has_err() ? 1 : 0 );
 }
 
+
+/*
+* Show scan result of one unit, as i2cdetect.
+*    Found address in hex, "--" no ack, "TO" clock stretch timeout,
+*    "??" abandoned.
+*/
+void
+y_iic::show_scan(
+    rgIicScan		*scn,
+    uint32_t		uu,		// unit index in scn
+    uint32_t		num		// IIC number
+)
+{
+    cout << "Iic" << num << " scan:" <<endl;
+    cout << "     0  1  2  3  4  5  6  7  8  9  a  b  c  d  e  f" <<endl;
+
+    cout.fill('0');
+    cout <<hex;
+
+    for ( uint32_t row=0;  row < 0x80;  row += 0x10 )
+    {
+	string		line;
+
+	for ( uint32_t aa=row;  aa < row + 0x10;  aa++ )
+	{
+	    switch ( scn->get_result( uu, aa ) ) {
+	    case rgIicScan::sr_Found: {
+		std::ostringstream	css;
+		css << " " << hex << setw(2) << setfill('0') << aa;
+		line += css.str();
+		break;
+	    }
+	    case rgIicScan::sr_Absent:      line += " --";  break;
+	    case rgIicScan::sr_ClkTimeout:  line += " TO";  break;
+	    case rgIicScan::sr_PollLimit:   line += " ??";  break;
+	    default:                        line += "   ";  break;
+	    }
+	}
+
+	line.erase( line.find_last_not_of( ' ' ) + 1 );
+	cout << setw(2) << row << ":" << line <<endl;
+    }
+
+    cout.fill(' ');
+    cout <<dec;
+}
+
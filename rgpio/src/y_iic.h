@@ -9,6 +9,8 @@
 #include "rgAddrMap.h"
 #include "yOption.h"
 
+class rgIicScan;
+
 //--------------------------------------------------------------------------
 // y_iic class
 //--------------------------------------------------------------------------
@@ -25,6 +27,13 @@ class y_iic {
     );
 
     int			doit();
+
+  private:
+    void		show_scan(
+			    rgIicScan	*scn,
+			    uint32_t	uu,
+			    uint32_t	num
+			);
 };
 
 #endif
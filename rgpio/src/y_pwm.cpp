@@ -17,7 +17,9 @@ using namespace std;
 #include "yOpVal.h"
 
 #include "rgAddrMap.h"
+#include "rgClk.h"
 #include "rgPwm.h"
+#include "rgPwmSolve.h"
 
 #include "y_pwm.h"
 
@@ -48,6 +50,9 @@ class pwm_yOptLong : public yOption {
     yOpVal		Ch2Data;
 
     bool		tx;
+					// clock solver
+    yOpVal		freq;
+    yOpVal		res;
 					// Cntl fields
     yOpVal		Ch2_MsEnable_1;
     yOpVal		Ch2_UseFifo_1;
@@ -134,6 +139,9 @@ pwm_yOptLong::parse_options()
 
 	else if ( is( "--tx"         )) { tx         = 1; }
 
+	else if ( is( "--freq="      )) { freq.set(     this->val() ); }
+	else if ( is( "--res="       )) { res.set(      this->val() ); }
+
 	else if ( is( "--Ch2_MsEnable_1="  )) { Ch2_MsEnable_1.set(  val() ); }
 	else if ( is( "--Ch2_UseFifo_1="   )) { Ch2_UseFifo_1.set(   val() ); }
 	else if ( is( "--Ch2_Invert_1="    )) { Ch2_Invert_1.set(    val() ); }
@@ -218,6 +226,14 @@ pwm_yOptLong::parse_options()
 			       DmaReqLev_8.Val   <<endl;
     }
 
+    if ( freq.Given && (freq.Val == 0) ) {
+	Error::msg( "require --freq=HZ nonzero" ) <<endl;
+    }
+
+    if ( res.Given && (! freq.Given) ) {
+	Error::msg( "--res requires --freq" ) <<endl;
+    }
+
     if ( (! tx) && (get_argc() > 0) ) {
 	Error::msg( "extra arguments:  " ) << next_arg() << endl;
     }
@@ -259,6 +275,10 @@ pwm_yOptLong::print_option_flags()
 
     cout << "--tx          = " << tx           << endl;
 
+    cout <<dec;
+    cout << "--freq        = " << freq.Val     << endl;
+    cout << "--res         = " << res.Val      << endl;
+
     cout <<dec;
     cout << "--Ch2_MsEnable_1  = " << Ch2_MsEnable_1.Val  << endl;
     cout << "--Ch2_UseFifo_1   = " << Ch2_UseFifo_1.Val   << endl;
@@ -302,6 +322,9 @@ pwm_yOptLong::print_usage()
     "    --Ch1Data=V         ...\n"
     "  send pattern:\n"
     "    --tx                write arg values to Fifo\n"
+    "  solve clock and Range:  (applied before other options)\n"
+    "    --freq=HZ           target PWM frequency, sets clock, Ch1/Ch2 Range\n"
+    "    --res=N             minimum Range, duty resolution steps\n"
     "  modify Cntl bit fields:\n"
     "    --ClearFifo_1=0     1= clears fifo, single shot (WO)\n"
     "    --Ch2_MsEnable_1=0  1= mark/space mode, 0= pwm mode\n"
@@ -415,6 +438,34 @@ y_pwm::doit()
 	    cout <<dec <<endl;
 	}
 
+	if ( Opx.freq.Given ) {
+	    rgPwmSolve		slv;
+	    rgClk		Cx  ( AddrMap, rgClk::cm_ClkPwm );
+
+	    Opx.trace_msg( "Solve clock" );
+
+	    if ( ! slv.solve( Opx.freq.Val, Opx.res.Val ) ) {
+		Error::msg( "no clock solution for --freq=" ) << Opx.freq.Val
+		    << " --res=" << Opx.res.Val <<endl;
+		return  1;
+	    }
+
+	    cout << "   solve:  Source_4=" << slv.get_Source()
+		 << "  DivI_12="   << slv.get_DivI()
+		 << "  DivF_12="   << slv.get_DivF()
+		 << "  Mash_2="    << slv.get_Mash()
+		 << "  Range="     << slv.get_Range() <<endl
+		 << "   freq:   "  << slv.get_Freq() << " Hz"
+		 << "  error= "    << slv.get_ErrPpb() << " ppb" <<endl;
+
+	    Opx.trace_msg( "Apply clock" );
+
+	    if ( slv.apply( &Cx, &Pwx ) ) {
+		Error::msg( "clock busy timeout, clock is disabled" ) <<endl;
+		return  1;
+	    }
+	}
+
 	{
 	    bool		md = 0;		// modify flag
 
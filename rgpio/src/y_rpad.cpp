@@ -61,6 +61,9 @@ class rpad_yOptLong : public yOption {
     yOpVal		HystEn_1;
     yOpVal		SlewFast_1;
 
+					// IoPad profile
+    rgsIoPads::rgsPad_enum	profile  = rgsIoPads::pad_Reset;
+
 					// word write value
     yOpVal		norm;
     yOpVal		flip;
@@ -74,6 +77,7 @@ class rpad_yOptLong : public yOption {
 
     bool		Md       = 0;	// modify field flag
     bool		Mr       = 0;	// modify register flag
+    bool		Mp       = 0;	// modify profile flag
 
     bool		verbose  = 0;
     bool		debug    = 0;
@@ -133,6 +137,16 @@ rpad_yOptLong::parse_options()
 	else if ( is( "--set"        )) { o_set      = 1; }
 	else if ( is( "--clr"        )) { o_clr      = 1; }
 
+	else if ( is( "--profile="   )) {
+	    try {
+		profile = rgsIoPads::find_rgsPad_enum( val() );
+	    }
+	    catch ( std::range_error& e ) {
+		Error::msg( "unknown --profile=" ) << val() <<endl;
+	    }
+	    Mp = 1;
+	}
+
 	else if ( is( "--list"       )) { list       = 1; }
 	else if ( is( "--all"        )) { all        = 1; }
 
@@ -217,13 +231,17 @@ rpad_yOptLong::parse_options()
 	Error::msg( "--gpio= not valid with Gpio bit numbers" ) <<endl;
     }
 
-    if ( (Md || Mr) && (get_argc() == 0) && (! gpio.Given) ) {
+    if ( (Md || Mr || Mp) && (get_argc() == 0) && (! gpio.Given) ) {
 	Error::msg( "modify requires Gpio bit numbers" ) <<endl;
     }
 
     if ( Md && (atomic_cnt > 0) ) {
 	Error::msg( "field modification not valid with write atomic" ) <<endl;
     }
+
+    if ( Mp && (atomic_cnt > 0) ) {
+	Error::msg( "--profile not valid with write atomic" ) <<endl;
+    }
 }
 
 
@@ -281,6 +299,8 @@ rpad_yOptLong::print_usage()
     "    gpio                bit numbers {27..0}\n"
     "    --gpio=0x0fffffff   mask to select Gpio[27:0] bits\n"
     "    -0, -1, -2          bank number, default -0\n"
+    "  IoPad(gpio) profile:  (applied before field modification)\n"
+    "    --profile=NAME      {Reset, FastSpi, SlowIic, InHyst, Off}\n"
     "  IoPad(gpio) field modification:\n"
     "    --OutDisable_1=0    output disable\n"
     "    --InEnable_1=0      input enable\n"
@@ -538,6 +558,25 @@ y_rpad::doit()
 	    }
 	}
 
+	if ( Opx.Mp ) {
+	    uint32_t	mask = 0;
+	    uint32_t	nacc;
+
+	    Opx.trace_msg( "Apply pad profile" );
+
+	    for ( int ii=0;  ii<bitcnt;  ii++ )	// each bit
+	    {
+		mask |= (1u << bitarg[ii]);
+	    }
+
+	    nacc = Px.apply_profile( mask, Opx.profile );
+
+	    if ( Opx.verbose ) {
+		cout << "+ " << rgsIoPads::rgsPad_enum2cstr( Opx.profile )
+		     << " register writes:  " << nacc <<endl;
+	    }
+	}
+
 	if ( Opx.Md ) {
 	    Opx.trace_msg( "Modify registers field" );
 
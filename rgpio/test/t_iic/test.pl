@@ -5,7 +5,7 @@
 #    10-19  iic basic options --help
 #    20-29  Modify errors
 #    30-39  Tx, Rx
-#    40-49  .
+#    40-49  Scan
 #    50-59  .
 
 # usage:  ./test.pl
@@ -193,6 +193,56 @@ run_test( "33", "error --tx is non-numeric",
     ),
 );
 
+#---------------------------------------------------------------------------
+## Scan
+#---------------------------------------------------------------------------
+
+run_test( "40", "error --scan with --rx",
+    "rgpio --dev=f --rpi4  iic -1 --scan --rx=2",
+    1,
+    Stderr => q(
+	Error:  --scan not valid with --tx or --rx
+    ),
+    Stdout => q(),
+);
+
+run_test( "41", "error unknown --scan= mode",
+    "rgpio --dev=f --rpi4  iic -1 --scan=fast",
+    1,
+    Stderr => q(
+	Error:  unknown --scan=fast
+    ),
+    Stdout => q(),
+);
+
+run_test( "42", "scan, fake Stat all AckErr_1",
+    "rgpio --dev=f --rpi4  iic -v -1 --Stat=0x100 --scan=quick",
+    0,
+    Stderr => q(),
+    Stdout => q(
+	+ Grab regs
+	+ Modify regs
+	+ Scan slave addresses
+	+ found 0 devices, 112 status reads
+	Iic1 scan:
+	     0  1  2  3  4  5  6  7  8  9  a  b  c  d  e  f
+	00:                         -- -- -- -- -- -- -- --
+	10: -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+	20: -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+	30: -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+	40: -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+	50: -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+	60: -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+	70: -- -- -- -- -- -- -- --
+    ),
+);
+
+run_test( "43", "scan two units, fake Stat all TransDone_1",
+    "rgpio --dev=f --rpi4  iic -1 -2 --Stat=0x2 --scan",
+    0,
+    Stderr => q(),
+);
+
 #---------------------------------------------------------------------------
 # Check that all tests ran.
 #---------------------------------------------------------------------------
@@ -6,7 +6,7 @@
 #    20-29  Set registers
 #    30-39  Modify field options
 #    40-49  .
-#    50-59  .
+#    50-59  Clock solver --freq
 
 # usage:  ./test.pl
 # files:
@@ -183,6 +183,43 @@ run_test( "41", "error --tx is non-numeric",
     ),
 );
 
+#---------------------------------------------------------------------------
+## Clock solver --freq
+#---------------------------------------------------------------------------
+
+run_test( "50", "solve 25 kHz",
+    "rgpio --dev=f --rpi4  pwm -v --freq=25000 --res=1000",
+    0,
+    Stderr => q(),
+);
+
+run_test( "51", "no solution",
+    "rgpio --dev=f --rpi4  pwm --freq=10000000 --res=1000",
+    1,
+    Stderr => q(
+	Error:  no clock solution for --freq=10000000 --res=1000
+    ),
+    Stdout => q(),
+);
+
+run_test( "52", "error --freq zero",
+    "rgpio --dev=f --rpi4  pwm --freq=0",
+    1,
+    Stderr => q(
+	Error:  require --freq=HZ nonzero
+    ),
+    Stdout => q(),
+);
+
+run_test( "53", "error --res without --freq",
+    "rgpio --dev=f --rpi4  pwm --res=10",
+    1,
+    Stderr => q(
+	Error:  --res requires --freq
+    ),
+    Stdout => q(),
+);
+
 #---------------------------------------------------------------------------
 # Check that all tests ran.
 #---------------------------------------------------------------------------
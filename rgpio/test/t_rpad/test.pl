@@ -163,6 +163,22 @@ run_test( "26", "error non-numeric Gpio bit number",
     Stdout => q(),
 );
 
+run_test( "27", "error unknown --profile=",
+    "rgpio --dev=f --rpi5  rpad --profile=Fast  2 3",
+    1,
+    Stderr => q(
+	Error:  unknown --profile=Fast
+    ),
+    Stdout => q(),
+);
+run_test( "28", "error --profile= and register modification",
+    "rgpio --dev=f --rpi5  rpad --profile=FastSpi --set=0x77  2 3",
+    1,
+    Stderr => q(
+	Error:  --profile not valid with write atomic
+    ),
+    Stdout => q(),
+);
 run_test( "29", "error bad Gpio bit number",
     "rgpio --dev=f --rpi5  rpad  28",
     1,
@@ -352,6 +368,31 @@ run_test( "45", "modify field, show atomic with --norm",
     ),
 );
 
+run_test( "46", "apply profile, show atomic set/clr",
+    "rgpio --dev=f --rpi5  rpad -v --list --profile=FastSpi --set --clr  2 3",
+    0,
+    Stderr => q(),
+    Stdout => q(
+	+ Apply pad profile
+	+ FastSpi register writes:  4
+	+ Read registers
+	 Read Atomic register bit:          28   24   20   16   12    8    4    0
+	   0x00000071  set   0.IoPad( 2)  0000 0000 0000 0000 0000 0000 0111 0001
+	   0x0000008e  clr   0.IoPad( 2)  0000 0000 0000 0000 0000 0000 1000 1110
+	   0x00000071  set   0.IoPad( 3)  0000 0000 0000 0000 0000 0000 0111 0001
+	   0x0000008e  clr   0.IoPad( 3)  0000 0000 0000 0000 0000 0000 1000 1110
+    ),
+);
+
+run_test( "47", "apply profile requires Gpio bits",
+    "rgpio --dev=f --rpi5  rpad --profile=Off",
+    1,
+    Stderr => q(
+	Error:  modify requires Gpio bit numbers
+    ),
+    Stdout => q(),
+);
+
 #---------------------------------------------------------------------------
 ## Modify Atomic registers
 #---------------------------------------------------------------------------